@@ -42,6 +42,18 @@ LOCAL_SRC_FILES := \
 	$(LOCAL_PATH)/../source/support/main.cpp \
 	$(LOCAL_PATH)/../source/support/renderer.cpp \
 	$(LOCAL_PATH)/../source/support/tick_count.cpp \
+	$(LOCAL_PATH)/../source/support/frame_pacer.cpp \
+	$(LOCAL_PATH)/../source/support/allocation_counter.cpp \
+	$(LOCAL_PATH)/../source/support/vertex_packing.cpp \
+	$(LOCAL_PATH)/../source/support/load_arena.cpp \
+	$(LOCAL_PATH)/../source/support/texture_cooker.cpp \
+	$(LOCAL_PATH)/../source/support/scene_cooker.cpp \
+	$(LOCAL_PATH)/../source/support/staging_upload_allocator.cpp \
+	$(LOCAL_PATH)/../source/support/worker_pool.cpp \
+	$(LOCAL_PATH)/../source/support/scene_cache.cpp \
+	$(LOCAL_PATH)/../source/support/mapped_file_input_stream_factory.cpp \
+	$(LOCAL_PATH)/../source/support/mesh_locality_optimizer.cpp \
+	$(LOCAL_PATH)/../source/support/bindless_descriptor_allocator.cpp \
 	$(LOCAL_PATH)/../source/demo.cpp \
 	$(LOCAL_PATH)/../thirdparty/DXUT/Optional/DXUTcamera.cpp
 
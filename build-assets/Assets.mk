@@ -96,6 +96,9 @@ ASSETS_DIR := $(LOCAL_PATH)/../assets
 HEADERS_DIR := $(LOCAL_PATH)/../assets/bin2h
 PYTHON_PATH := python
 BIN2H_PATH := $(ASSETS_DIR)/bin2h.py
+COOKER_PATH := $(LOCAL_PATH)/../build-linux/bin/release/Path-Tracing-Cooker-Linux
+SCENE_CACHE_DIR := $(LOCAL_PATH)/../scene-cache
+COOKED_TEXTURE_DIR := $(LOCAL_PATH)/../cooked-textures
 
 all : \
 	$(HEADERS_DIR)/_internal_the-white-room.gltf.inl \
@@ -154,6 +157,12 @@ $(HEADERS_DIR)/_internal_keqing-lolita.dds.inl : $(ASSETS_DIR)/keqing-lolita/keq
 	$(HIDE) $(call host-mkdir,$(HEADERS_DIR))
 	$(HIDE) "$(PYTHON_PATH)" "$(BIN2H_PATH)" "$(ASSETS_DIR)/keqing-lolita/keqing-lolita.dds" "$(HEADERS_DIR)/_internal_keqing-lolita.dds.inl"  
 
+# write the scene cache and the cooked textures offline (the skinned scenes are skipped by the cooker, and nothing is written into the assets)
+cook :
+	$(HIDE) $(call host-mkdir,$(SCENE_CACHE_DIR))
+	$(HIDE) $(call host-mkdir,$(COOKED_TEXTURE_DIR))
+	$(HIDE) "$(COOKER_PATH)" "$(ASSETS_DIR)" "$(SCENE_CACHE_DIR)" "$(COOKED_TEXTURE_DIR)" "the-white-room/the-white-room.gltf" "keqing-lolita/keqing-lolita-love-you.gltf"
+
 clean:
 	$(HIDE) $(call host-rm,$(HEADERS_DIR)/_internal_the-white-room.gltf.inl)
 	$(HIDE) $(call host-rm,$(HEADERS_DIR)/_internal_the-white-room.bin.inl)
@@ -169,4 +178,5 @@ clean:
 
 .PHONY : \
 	all \
+	cook \
 	clean
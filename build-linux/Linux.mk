@@ -58,7 +58,13 @@ ifneq (true, $(APP_DEBUG))
 endif
 
 all :  \
-	$(BIN_DIR)/Path-Tracing-Linux
+	$(BIN_DIR)/Path-Tracing-Linux \
+	$(BIN_DIR)/Path-Tracing-Cooker-Linux \
+	$(BIN_DIR)/Path-Tracing-Test-Linux
+
+# the batch kernels are compared with the scalar reference
+test : $(BIN_DIR)/Path-Tracing-Test-Linux
+	$(HIDE) $(BIN_DIR)/Path-Tracing-Test-Linux
 
 # Link
 ifeq (true, $(APP_DEBUG))
@@ -79,6 +85,18 @@ $(BIN_DIR)/Path-Tracing-Linux: \
 	$(OBJ_DIR)/Demo-support-main.o \
 	$(OBJ_DIR)/Demo-support-renderer.o \
 	$(OBJ_DIR)/Demo-support-tick_count.o \
+	$(OBJ_DIR)/Demo-support-frame_pacer.o \
+	$(OBJ_DIR)/Demo-support-allocation_counter.o \
+	$(OBJ_DIR)/Demo-support-vertex_packing.o \
+	$(OBJ_DIR)/Demo-support-load_arena.o \
+	$(OBJ_DIR)/Demo-support-texture_cooker.o \
+	$(OBJ_DIR)/Demo-support-scene_cooker.o \
+	$(OBJ_DIR)/Demo-support-staging_upload_allocator.o \
+	$(OBJ_DIR)/Demo-support-worker_pool.o \
+	$(OBJ_DIR)/Demo-support-scene_cache.o \
+	$(OBJ_DIR)/Demo-support-mapped_file_input_stream_factory.o \
+	$(OBJ_DIR)/Demo-support-mesh_locality_optimizer.o \
+	$(OBJ_DIR)/Demo-support-bindless_descriptor_allocator.o \
 	$(OBJ_DIR)/Demo-demo.o \
 	$(OBJ_DIR)/Demo-thirdparty-DXUT-Optional-DXUTcamera.o \
 	$(OBJ_DIR)/libImportAsset.a \
@@ -104,6 +122,18 @@ $(BIN_DIR)/Path-Tracing-Linux: \
 	$(OBJ_DIR)/Demo-support-main.o \
 	$(OBJ_DIR)/Demo-support-renderer.o \
 	$(OBJ_DIR)/Demo-support-tick_count.o \
+	$(OBJ_DIR)/Demo-support-frame_pacer.o \
+	$(OBJ_DIR)/Demo-support-allocation_counter.o \
+	$(OBJ_DIR)/Demo-support-vertex_packing.o \
+	$(OBJ_DIR)/Demo-support-load_arena.o \
+	$(OBJ_DIR)/Demo-support-texture_cooker.o \
+	$(OBJ_DIR)/Demo-support-scene_cooker.o \
+	$(OBJ_DIR)/Demo-support-staging_upload_allocator.o \
+	$(OBJ_DIR)/Demo-support-worker_pool.o \
+	$(OBJ_DIR)/Demo-support-scene_cache.o \
+	$(OBJ_DIR)/Demo-support-mapped_file_input_stream_factory.o \
+	$(OBJ_DIR)/Demo-support-mesh_locality_optimizer.o \
+	$(OBJ_DIR)/Demo-support-bindless_descriptor_allocator.o \
 	$(OBJ_DIR)/Demo-demo.o \
 	$(OBJ_DIR)/Demo-thirdparty-DXUT-Optional-DXUTcamera.o \
 	$(OBJ_DIR)/libImportAsset.a \
@@ -129,6 +159,18 @@ endif
 		$(OBJ_DIR)/Demo-support-main.o \
 		$(OBJ_DIR)/Demo-support-renderer.o \
 		$(OBJ_DIR)/Demo-support-tick_count.o \
+		$(OBJ_DIR)/Demo-support-frame_pacer.o \
+		$(OBJ_DIR)/Demo-support-allocation_counter.o \
+		$(OBJ_DIR)/Demo-support-vertex_packing.o \
+		$(OBJ_DIR)/Demo-support-load_arena.o \
+		$(OBJ_DIR)/Demo-support-texture_cooker.o \
+		$(OBJ_DIR)/Demo-support-scene_cooker.o \
+		$(OBJ_DIR)/Demo-support-staging_upload_allocator.o \
+		$(OBJ_DIR)/Demo-support-worker_pool.o \
+		$(OBJ_DIR)/Demo-support-scene_cache.o \
+		$(OBJ_DIR)/Demo-support-mapped_file_input_stream_factory.o \
+		$(OBJ_DIR)/Demo-support-mesh_locality_optimizer.o \
+		$(OBJ_DIR)/Demo-support-bindless_descriptor_allocator.o \
 		$(OBJ_DIR)/Demo-demo.o \
 		$(OBJ_DIR)/Demo-thirdparty-DXUT-Optional-DXUTcamera.o \
 		$(OBJ_DIR)/libImportAsset.a \
@@ -136,7 +178,49 @@ endif
 		-lxcb \
 		-o $(BIN_DIR)/Path-Tracing-Linux
 
+# the offline scene cooker does NOT depend on the device
+$(BIN_DIR)/Path-Tracing-Cooker-Linux: \
+	$(OBJ_DIR)/Cooker-cooker-main.o \
+	$(OBJ_DIR)/Demo-support-scene_cooker.o \
+	$(OBJ_DIR)/Demo-support-texture_cooker.o \
+	$(OBJ_DIR)/Demo-support-scene_cache.o \
+	$(OBJ_DIR)/Demo-support-mapped_file_input_stream_factory.o \
+	$(OBJ_DIR)/Demo-support-mesh_locality_optimizer.o \
+	$(OBJ_DIR)/Demo-support-vertex_packing.o \
+	$(OBJ_DIR)/Demo-support-worker_pool.o \
+	$(OBJ_DIR)/libImportAsset.a
+	$(HIDE) mkdir -p $(BIN_DIR)
+	$(HIDE) $(CC) -pie $(LD_FLAGS) \
+		$(OBJ_DIR)/Cooker-cooker-main.o \
+		$(OBJ_DIR)/Demo-support-scene_cooker.o \
+		$(OBJ_DIR)/Demo-support-texture_cooker.o \
+		$(OBJ_DIR)/Demo-support-scene_cache.o \
+		$(OBJ_DIR)/Demo-support-mapped_file_input_stream_factory.o \
+		$(OBJ_DIR)/Demo-support-mesh_locality_optimizer.o \
+		$(OBJ_DIR)/Demo-support-vertex_packing.o \
+		$(OBJ_DIR)/Demo-support-worker_pool.o \
+		$(OBJ_DIR)/libImportAsset.a \
+		-o $(BIN_DIR)/Path-Tracing-Cooker-Linux
+
+# the test does NOT depend on the device or the importer
+$(BIN_DIR)/Path-Tracing-Test-Linux: \
+	$(OBJ_DIR)/Test-test-main.o \
+	$(OBJ_DIR)/Demo-support-vertex_packing.o
+	$(HIDE) mkdir -p $(BIN_DIR)
+	$(HIDE) $(CC) -pie $(LD_FLAGS) \
+		$(OBJ_DIR)/Test-test-main.o \
+		$(OBJ_DIR)/Demo-support-vertex_packing.o \
+		-o $(BIN_DIR)/Path-Tracing-Test-Linux
+
 # Compile
+$(OBJ_DIR)/Cooker-cooker-main.o: $(SOURCE_DIR)/cooker/main.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/cooker/main.cpp -MD -MF $(OBJ_DIR)/Cooker-cooker-main.d -o $(OBJ_DIR)/Cooker-cooker-main.o
+
+$(OBJ_DIR)/Test-test-main.o: $(SOURCE_DIR)/test/main.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/test/main.cpp -MD -MF $(OBJ_DIR)/Test-test-main.d -o $(OBJ_DIR)/Test-test-main.o
+
 $(OBJ_DIR)/Demo-assets-assets.o: $(SOURCE_DIR)/../assets/assets.cpp
 	$(HIDE) mkdir -p $(OBJ_DIR)
 	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/../assets/assets.cpp -MD -MF $(OBJ_DIR)/Demo-assets-assets.d -o $(OBJ_DIR)/Demo-assets-assets.o
@@ -201,6 +285,54 @@ $(OBJ_DIR)/Demo-support-tick_count.o: $(SOURCE_DIR)/support/tick_count.cpp
 	$(HIDE) mkdir -p $(OBJ_DIR)
 	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/tick_count.cpp -MD -MF $(OBJ_DIR)/Demo-support-tick_count.d -o $(OBJ_DIR)/Demo-support-tick_count.o
 
+$(OBJ_DIR)/Demo-support-frame_pacer.o: $(SOURCE_DIR)/support/frame_pacer.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/frame_pacer.cpp -MD -MF $(OBJ_DIR)/Demo-support-frame_pacer.d -o $(OBJ_DIR)/Demo-support-frame_pacer.o
+
+$(OBJ_DIR)/Demo-support-allocation_counter.o: $(SOURCE_DIR)/support/allocation_counter.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/allocation_counter.cpp -MD -MF $(OBJ_DIR)/Demo-support-allocation_counter.d -o $(OBJ_DIR)/Demo-support-allocation_counter.o
+
+$(OBJ_DIR)/Demo-support-vertex_packing.o: $(SOURCE_DIR)/support/vertex_packing.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/vertex_packing.cpp -MD -MF $(OBJ_DIR)/Demo-support-vertex_packing.d -o $(OBJ_DIR)/Demo-support-vertex_packing.o
+
+$(OBJ_DIR)/Demo-support-load_arena.o: $(SOURCE_DIR)/support/load_arena.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/load_arena.cpp -MD -MF $(OBJ_DIR)/Demo-support-load_arena.d -o $(OBJ_DIR)/Demo-support-load_arena.o
+
+$(OBJ_DIR)/Demo-support-texture_cooker.o: $(SOURCE_DIR)/support/texture_cooker.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/texture_cooker.cpp -MD -MF $(OBJ_DIR)/Demo-support-texture_cooker.d -o $(OBJ_DIR)/Demo-support-texture_cooker.o
+
+$(OBJ_DIR)/Demo-support-scene_cooker.o: $(SOURCE_DIR)/support/scene_cooker.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/scene_cooker.cpp -MD -MF $(OBJ_DIR)/Demo-support-scene_cooker.d -o $(OBJ_DIR)/Demo-support-scene_cooker.o
+
+$(OBJ_DIR)/Demo-support-staging_upload_allocator.o: $(SOURCE_DIR)/support/staging_upload_allocator.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/staging_upload_allocator.cpp -MD -MF $(OBJ_DIR)/Demo-support-staging_upload_allocator.d -o $(OBJ_DIR)/Demo-support-staging_upload_allocator.o
+
+$(OBJ_DIR)/Demo-support-worker_pool.o: $(SOURCE_DIR)/support/worker_pool.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/worker_pool.cpp -MD -MF $(OBJ_DIR)/Demo-support-worker_pool.d -o $(OBJ_DIR)/Demo-support-worker_pool.o
+
+$(OBJ_DIR)/Demo-support-scene_cache.o: $(SOURCE_DIR)/support/scene_cache.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/scene_cache.cpp -MD -MF $(OBJ_DIR)/Demo-support-scene_cache.d -o $(OBJ_DIR)/Demo-support-scene_cache.o
+
+$(OBJ_DIR)/Demo-support-mapped_file_input_stream_factory.o: $(SOURCE_DIR)/support/mapped_file_input_stream_factory.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/mapped_file_input_stream_factory.cpp -MD -MF $(OBJ_DIR)/Demo-support-mapped_file_input_stream_factory.d -o $(OBJ_DIR)/Demo-support-mapped_file_input_stream_factory.o
+
+$(OBJ_DIR)/Demo-support-mesh_locality_optimizer.o: $(SOURCE_DIR)/support/mesh_locality_optimizer.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/mesh_locality_optimizer.cpp -MD -MF $(OBJ_DIR)/Demo-support-mesh_locality_optimizer.d -o $(OBJ_DIR)/Demo-support-mesh_locality_optimizer.o
+
+$(OBJ_DIR)/Demo-support-bindless_descriptor_allocator.o: $(SOURCE_DIR)/support/bindless_descriptor_allocator.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/support/bindless_descriptor_allocator.cpp -MD -MF $(OBJ_DIR)/Demo-support-bindless_descriptor_allocator.d -o $(OBJ_DIR)/Demo-support-bindless_descriptor_allocator.o
+
 $(OBJ_DIR)/Demo-demo.o: $(SOURCE_DIR)/demo.cpp
 	$(HIDE) mkdir -p $(OBJ_DIR)
 	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/demo.cpp -MD -MF $(OBJ_DIR)/Demo-demo.d -o $(OBJ_DIR)/Demo-demo.o
@@ -248,11 +380,31 @@ $(BIN_DIR)/VkLayer_khronos_validation.json: $(THIRD_PARTY_DIR)/Brioche/thirdpart
 	$(OBJ_DIR)/Demo-support-main.d \
 	$(OBJ_DIR)/Demo-support-renderer.d \
 	$(OBJ_DIR)/Demo-support-tick_count.d \
+	$(OBJ_DIR)/Demo-support-frame_pacer.d \
+	$(OBJ_DIR)/Demo-support-allocation_counter.d \
+	$(OBJ_DIR)/Demo-support-vertex_packing.d \
+	$(OBJ_DIR)/Demo-support-load_arena.d \
+	$(OBJ_DIR)/Demo-support-texture_cooker.d \
+	$(OBJ_DIR)/Demo-support-scene_cooker.d \
+	$(OBJ_DIR)/Demo-support-staging_upload_allocator.d \
+	$(OBJ_DIR)/Demo-support-worker_pool.d \
+	$(OBJ_DIR)/Demo-support-scene_cache.d \
+	$(OBJ_DIR)/Demo-support-mapped_file_input_stream_factory.d \
+	$(OBJ_DIR)/Demo-support-mesh_locality_optimizer.d \
+	$(OBJ_DIR)/Demo-support-bindless_descriptor_allocator.d \
 	$(OBJ_DIR)/Demo-demo.d \
-	$(OBJ_DIR)/Demo-thirdparty-DXUT-Optional-DXUTcamera.d
+	$(OBJ_DIR)/Demo-thirdparty-DXUT-Optional-DXUTcamera.d \
+	$(OBJ_DIR)/Cooker-cooker-main.d \
+	$(OBJ_DIR)/Test-test-main.d
 
 clean:
 	$(HIDE) rm -f $(BIN_DIR)/Path-Tracing-Linux
+	$(HIDE) rm -f $(BIN_DIR)/Path-Tracing-Cooker-Linux
+	$(HIDE) rm -f $(OBJ_DIR)/Cooker-cooker-main.o
+	$(HIDE) rm -f $(OBJ_DIR)/Cooker-cooker-main.d
+	$(HIDE) rm -f $(BIN_DIR)/Path-Tracing-Test-Linux
+	$(HIDE) rm -f $(OBJ_DIR)/Test-test-main.o
+	$(HIDE) rm -f $(OBJ_DIR)/Test-test-main.d
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-assets-assets.o
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-assets-the_white_room_gltf.o
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-assets-the_white_room_bin.o
@@ -269,6 +421,18 @@ clean:
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-main.o
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-renderer.o
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-tick_count.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-frame_pacer.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-allocation_counter.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-vertex_packing.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-load_arena.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-texture_cooker.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-scene_cooker.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-staging_upload_allocator.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-worker_pool.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-scene_cache.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-mapped_file_input_stream_factory.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-mesh_locality_optimizer.o
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-bindless_descriptor_allocator.o
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-demo.o
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-thirdparty-DXUT-Optional-DXUTcamera.o
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-assets-assets.d
@@ -305,6 +469,18 @@ clean:
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-main.d
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-renderer.d
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-tick_count.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-frame_pacer.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-allocation_counter.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-vertex_packing.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-load_arena.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-texture_cooker.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-scene_cooker.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-staging_upload_allocator.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-worker_pool.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-scene_cache.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-mapped_file_input_stream_factory.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-mesh_locality_optimizer.d
+	$(HIDE) rm -f $(OBJ_DIR)/Demo-support-bindless_descriptor_allocator.d
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-demo.d
 	$(HIDE) rm -f $(OBJ_DIR)/Demo-thirdparty-DXUT-Optional-DXUTcamera.d
 	$(HIDE) rm -f $(OBJ_DIR)/libImportAsset.a
@@ -316,4 +492,5 @@ endif
 
 .PHONY : \
 	all \
+	test \
 	clean
\ No newline at end of file
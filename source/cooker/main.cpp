@@ -0,0 +1,307 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <algorithm>
+#include "../support/mapped_file_input_stream_factory.h"
+#include "../support/scene_cache.h"
+#include "../support/scene_cooker.h"
+#include "../support/texture_cooker.h"
+#include "../support/worker_pool.h"
+#include "../../thirdparty/Import-Asset/include/import_scene_asset.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_vector.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_string.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_unordered_map.h"
+
+#if defined(__GNUC__)
+#include <sys/types.h>
+#include <sys/stat.h>
+#elif defined(_MSC_VER)
+#include <direct.h>
+#else
+#error Unknown Compiler
+#endif
+
+// the same as the demo (the frame rate only affects the animation of the skinned meshes which are NOT cooked)
+static constexpr float const animation_frame_rate = 60.0F;
+
+static bool cook_scene(worker_pool *cook_worker_pool, mapped_file_input_stream_factory *mapped_file_input_stream_factory, char const *scene_cache_directory, char const *cooked_texture_directory, mcrt_string const &file_name, mcrt_unordered_map<mcrt_string, bool> &inout_cooked_textures);
+
+static bool cook_scene_textures(worker_pool *cook_worker_pool, mapped_file_input_stream_factory *mapped_file_input_stream_factory, char const *cooked_texture_directory, mcrt_string const &file_name, mcrt_vector<scene_mesh_data> const &mesh_data, mcrt_unordered_map<mcrt_string, bool> &inout_cooked_textures);
+
+static bool cook_texture(worker_pool *cook_worker_pool, mapped_file_input_stream_factory *mapped_file_input_stream_factory, char const *cooked_texture_directory, mcrt_string const &file_name, mcrt_string const &image_uri, TEXTURE_COOK_USAGE usage, mcrt_unordered_map<mcrt_string, bool> &inout_cooked_textures);
+
+// "false" when the directory can NOT be created, or the directory is the content root (or inside the content root)
+static bool create_cooked_texture_directory(char const *content_root, char const *cooked_texture_directory);
+
+// Usage: Path-Tracing-Cooker <content root> <scene cache directory> <cooked texture directory> <glTF file relative to the content root>...
+// The scene cache is written in the same way as the demo writes it at the first launch, so that the demo maps the cooked scenes without importing the glTF at all.
+// The PNG textures referenced by the scenes are cooked into the DDS (BC7 / BC5) and the PVR (ASTC) in the cooked texture directory, which are preferred by the demo.
+// Nothing is written into the content root, since the assets are tracked by the asset repositories.
+int main(int argc, char **argv)
+{
+    if (argc < 5)
+    {
+        printf("Usage: %s <content root> <scene cache directory> <cooked texture directory> <glTF file relative to the content root>...\n", argv[0]);
+        return 1;
+    }
+
+    char const *const content_root = argv[1];
+    char const *const scene_cache_directory = argv[2];
+    char const *const cooked_texture_directory = argv[3];
+
+    mapped_file_input_stream_factory mapped_file_input_stream_factory;
+    if (!mapped_file_input_stream_factory.init(content_root))
+    {
+        printf("Scene Cooker: the content root \"%s\" is NOT a directory\n", content_root);
+        return 1;
+    }
+
+    if (!create_cooked_texture_directory(content_root, cooked_texture_directory))
+    {
+        printf("Texture Cooker: the cooked texture directory \"%s\" can NOT be created or is inside the content root \"%s\"\n", cooked_texture_directory, content_root);
+        mapped_file_input_stream_factory.destroy();
+        return 1;
+    }
+
+    // "hardware_concurrency" may return zero when it is not computable, and the main thread is also used as a worker thread
+    uint32_t const hardware_concurrency = std::max(1U, static_cast<uint32_t>(std::thread::hardware_concurrency()));
+
+    // the worker threads are shared by all scenes and all textures
+    worker_pool cook_worker_pool;
+    cook_worker_pool.init(hardware_concurrency - 1U);
+
+    int exit_code = 0;
+
+    // the same texture may be referenced by several scenes
+    mcrt_unordered_map<mcrt_string, bool> cooked_textures;
+
+    for (int argument_index = 4; argument_index < argc; ++argument_index)
+    {
+        if (!cook_scene(&cook_worker_pool, &mapped_file_input_stream_factory, scene_cache_directory, cooked_texture_directory, mcrt_string(argv[argument_index]), cooked_textures))
+        {
+            exit_code = 1;
+        }
+    }
+
+    cook_worker_pool.destroy();
+
+    mapped_file_input_stream_factory.destroy();
+
+    return exit_code;
+}
+
+static bool cook_scene(worker_pool *cook_worker_pool, mapped_file_input_stream_factory *mapped_file_input_stream_factory, char const *scene_cache_directory, char const *cooked_texture_directory, mcrt_string const &file_name, mcrt_unordered_map<mcrt_string, bool> &inout_cooked_textures)
+{
+    mcrt_vector<scene_mesh_data> mesh_data;
+    if (!import_gltf_scene_asset(mesh_data, animation_frame_rate, mapped_file_input_stream_factory->get_input_stream_factory(), file_name.c_str()))
+    {
+        printf("Scene Cooker: fail to import \"%s\"\n", file_name.c_str());
+        return false;
+    }
+
+    // the textures of the skinned meshes are cooked as well
+    bool const res_cook_scene_textures = cook_scene_textures(cook_worker_pool, mapped_file_input_stream_factory, cooked_texture_directory, file_name, mesh_data, inout_cooked_textures);
+
+    // the animation skeleton can not be serialized, and the scene is imported by the demo at load time
+    for (size_t mesh_index = 0U; mesh_index < mesh_data.size(); ++mesh_index)
+    {
+        if (mesh_data[mesh_index].m_skinned)
+        {
+            printf("Scene Cooker: skip \"%s\" which contains the skinned meshes\n", file_name.c_str());
+            return res_cook_scene_textures;
+        }
+    }
+
+    mcrt_vector<scene_cache_mesh> cooked_mesh_data(mesh_data.size());
+
+    mcrt_vector<scene_cook_mesh_subset_task> mesh_subset_cook_tasks;
+
+    for (size_t mesh_index = 0U; mesh_index < mesh_data.size(); ++mesh_index)
+    {
+        scene_mesh_data &in_mesh_data = mesh_data[mesh_index];
+
+        scene_cache_mesh &out_cooked_mesh_data = cooked_mesh_data[mesh_index];
+
+        out_cooked_mesh_data.m_skinned = in_mesh_data.m_skinned;
+
+        out_cooked_mesh_data.m_subsets.resize(in_mesh_data.m_subsets.size());
+
+        out_cooked_mesh_data.m_instance_model_transforms.resize(in_mesh_data.m_instances.size());
+
+        for (size_t instance_index = 0U; instance_index < in_mesh_data.m_instances.size(); ++instance_index)
+        {
+            out_cooked_mesh_data.m_instance_model_transforms[instance_index] = in_mesh_data.m_instances[instance_index].m_model_transform;
+        }
+
+        for (size_t subset_index = 0U; subset_index < in_mesh_data.m_subsets.size(); ++subset_index)
+        {
+            mesh_subset_cook_tasks.push_back(scene_cook_mesh_subset_task{in_mesh_data.m_skinned, &in_mesh_data.m_subsets[subset_index], &out_cooked_mesh_data.m_subsets[subset_index], 0.0, 0.0, 0U});
+        }
+    }
+
+    cook_worker_pool->parallel_for(static_cast<uint32_t>(mesh_subset_cook_tasks.size()), scene_cook_mesh_subset_task_main, mesh_subset_cook_tasks.data());
+
+    double total_cache_lines_before_locality_optimization = 0.0;
+    double total_cache_lines_after_locality_optimization = 0.0;
+    uint64_t total_triangle_count = 0U;
+    for (size_t mesh_subset_cook_task_index = 0U; mesh_subset_cook_task_index < mesh_subset_cook_tasks.size(); ++mesh_subset_cook_task_index)
+    {
+        total_cache_lines_before_locality_optimization += mesh_subset_cook_tasks[mesh_subset_cook_task_index].m_cache_lines_before_locality_optimization;
+        total_cache_lines_after_locality_optimization += mesh_subset_cook_tasks[mesh_subset_cook_task_index].m_cache_lines_after_locality_optimization;
+        total_triangle_count += mesh_subset_cook_tasks[mesh_subset_cook_task_index].m_triangle_count;
+    }
+
+    uint64_t const source_hash = scene_cook_compute_source_hash(mapped_file_input_stream_factory, file_name);
+
+    if (!scene_cache_write(scene_cache_directory, file_name.c_str(), source_hash, cooked_mesh_data))
+    {
+        printf("Scene Cooker: fail to write the scene cache of \"%s\" into \"%s\"\n", file_name.c_str(), scene_cache_directory);
+        return false;
+    }
+
+    if (SCENE_COOK_ENABLE_MESH_LOCALITY_OPTIMIZATION && (total_triangle_count > 0U))
+    {
+        printf("Scene Cooker: \"%s\" %u mesh subsets %llu triangles, average cache lines per triangle %f -> %f\n", file_name.c_str(), static_cast<uint32_t>(mesh_subset_cook_tasks.size()), static_cast<unsigned long long>(total_triangle_count), total_cache_lines_before_locality_optimization / static_cast<double>(total_triangle_count), total_cache_lines_after_locality_optimization / static_cast<double>(total_triangle_count));
+    }
+    else
+    {
+        printf("Scene Cooker: \"%s\" %u mesh subsets\n", file_name.c_str(), static_cast<uint32_t>(mesh_subset_cook_tasks.size()));
+    }
+
+    return res_cook_scene_textures;
+}
+
+static bool cook_scene_textures(worker_pool *cook_worker_pool, mapped_file_input_stream_factory *mapped_file_input_stream_factory, char const *cooked_texture_directory, mcrt_string const &file_name, mcrt_vector<scene_mesh_data> const &mesh_data, mcrt_unordered_map<mcrt_string, bool> &inout_cooked_textures)
+{
+    bool res_cook_scene_textures = true;
+
+    for (size_t mesh_index = 0U; mesh_index < mesh_data.size(); ++mesh_index)
+    {
+        for (size_t subset_index = 0U; subset_index < mesh_data[mesh_index].m_subsets.size(); ++subset_index)
+        {
+            scene_mesh_subset_data const &in_subset_data = mesh_data[mesh_index].m_subsets[subset_index];
+
+            // the same order as the "m_texture_image_uris" of the scene cache
+            mcrt_string const *const image_uris[SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT] = {&in_subset_data.m_normal_texture_image_uri, &in_subset_data.m_emissive_texture_image_uri, &in_subset_data.m_base_color_texture_image_uri, &in_subset_data.m_metallic_roughness_texture_image_uri};
+
+            for (uint32_t texture_index = 0U; texture_index < SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT; ++texture_index)
+            {
+                if ((!image_uris[texture_index]->empty()) && (!cook_texture(cook_worker_pool, mapped_file_input_stream_factory, cooked_texture_directory, file_name, (*image_uris[texture_index]), texture_cook_get_usage(texture_index), inout_cooked_textures)))
+                {
+                    res_cook_scene_textures = false;
+                }
+            }
+        }
+    }
+
+    return res_cook_scene_textures;
+}
+
+static bool cook_texture(worker_pool *cook_worker_pool, mapped_file_input_stream_factory *mapped_file_input_stream_factory, char const *cooked_texture_directory, mcrt_string const &file_name, mcrt_string const &image_uri, TEXTURE_COOK_USAGE usage, mcrt_unordered_map<mcrt_string, bool> &inout_cooked_textures)
+{
+    mcrt_string image_asset_file_name_source;
+    mcrt_string image_asset_file_name_dds;
+    mcrt_string image_asset_file_name_pvr;
+    texture_cook_get_image_asset_file_names(file_name, image_uri, &image_asset_file_name_source, &image_asset_file_name_dds, &image_asset_file_name_pvr);
+
+    mcrt_unordered_map<mcrt_string, bool>::const_iterator const found = inout_cooked_textures.find(image_asset_file_name_source);
+    if (inout_cooked_textures.end() != found)
+    {
+        return found->second;
+    }
+
+    bool res_cook_texture;
+
+    if (!texture_cook_is_source_image_supported(image_asset_file_name_source))
+    {
+        printf("Texture Cooker: skip \"%s\" which is NOT PNG\n", image_asset_file_name_source.c_str());
+        res_cook_texture = true;
+    }
+    else
+    {
+        void const *source_memory_range_base;
+        size_t source_memory_range_size;
+        if (!mapped_file_input_stream_factory->get_file(image_asset_file_name_source.c_str(), &source_memory_range_base, &source_memory_range_size))
+        {
+            printf("Texture Cooker: \"%s\" does not exist\n", image_asset_file_name_source.c_str());
+            res_cook_texture = false;
+        }
+        else
+        {
+            mcrt_string const cooked_image_asset_file_name_dds = texture_cook_get_cooked_image_asset_file_name(image_asset_file_name_dds);
+            mcrt_string const cooked_image_asset_file_name_pvr = texture_cook_get_cooked_image_asset_file_name(image_asset_file_name_pvr);
+
+            mcrt_string const dds_path = mcrt_string(cooked_texture_directory) + '/' + cooked_image_asset_file_name_dds;
+            mcrt_string const pvr_path = mcrt_string(cooked_texture_directory) + '/' + cooked_image_asset_file_name_pvr;
+
+            res_cook_texture = texture_cook_image(cook_worker_pool, source_memory_range_base, source_memory_range_size, usage, dds_path.c_str(), pvr_path.c_str());
+
+            if (res_cook_texture)
+            {
+                printf("Texture Cooker: \"%s\" -> \"%s\" \"%s\"\n", image_asset_file_name_source.c_str(), dds_path.c_str(), pvr_path.c_str());
+            }
+            else
+            {
+                printf("Texture Cooker: fail to cook \"%s\"\n", image_asset_file_name_source.c_str());
+            }
+        }
+    }
+
+    inout_cooked_textures.emplace(image_asset_file_name_source, res_cook_texture);
+
+    return res_cook_texture;
+}
+
+static bool create_cooked_texture_directory(char const *content_root, char const *cooked_texture_directory)
+{
+#if defined(__GNUC__)
+    mkdir(cooked_texture_directory, 0777);
+    char *const content_root_full_path = realpath(content_root, NULL);
+    char *const cooked_texture_directory_full_path = realpath(cooked_texture_directory, NULL);
+#elif defined(_MSC_VER)
+    _mkdir(cooked_texture_directory);
+    char *const content_root_full_path = _fullpath(NULL, content_root, 0U);
+    char *const cooked_texture_directory_full_path = _fullpath(NULL, cooked_texture_directory, 0U);
+#else
+#error Unknown Compiler
+#endif
+
+    bool res_create_cooked_texture_directory;
+    if ((NULL != content_root_full_path) && (NULL != cooked_texture_directory_full_path))
+    {
+        // the cooked images should NEVER overwrite the files tracked by the asset repositories
+        // the cooked texture directory is at least as long as the content root when the prefix matches
+        size_t const content_root_full_path_length = strlen(content_root_full_path);
+        bool const inside_content_root = (0 == strncmp(cooked_texture_directory_full_path, content_root_full_path, content_root_full_path_length)) && (('\0' == cooked_texture_directory_full_path[content_root_full_path_length]) || ('/' == cooked_texture_directory_full_path[content_root_full_path_length]) || ('\\' == cooked_texture_directory_full_path[content_root_full_path_length]));
+        res_create_cooked_texture_directory = (!inside_content_root);
+    }
+    else
+    {
+        res_create_cooked_texture_directory = false;
+    }
+
+    free(content_root_full_path);
+    free(cooked_texture_directory_full_path);
+
+    return res_create_cooked_texture_directory;
+}
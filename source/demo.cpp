@@ -24,10 +24,23 @@
 #if defined(__GNUC__)
 #pragma GCC diagnostic pop
 #endif
+#include <algorithm>
 #include <cmath>
+#include <random>
+#include <cstddef>
 #include <cstring>
 #include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "support/allocation_counter.h"
 #include "support/camera_controller.h"
+#include "support/load_arena.h"
+#include "support/mapped_file_input_stream_factory.h"
+#include "support/scene_cache.h"
+#include "support/scene_cooker.h"
+#include "support/texture_cooker.h"
+#include "support/tick_count.h"
+#include "support/worker_pool.h"
 #include "../thirdparty/DLB/DLB.h"
 #include "../thirdparty/Import-Asset/include/import_image_asset.h"
 #include "../thirdparty/Import-Asset/include/import_asset_input_stream.h"
@@ -42,10 +55,126 @@
 
 static inline uint32_t tbb_align_up(uint32_t value, uint32_t alignment);
 
+static inline uint32_t pack_r16g16_uint(uint32_t x, uint32_t y);
+
+static inline brx_sampled_asset_image *find_scene_texture(mcrt_unordered_map<mcrt_string, brx_sampled_asset_image *> const &mapped_textures, mcrt_string const &scene_asset_file_name, mcrt_string const &image_uri);
+
+static inline void find_scene_mesh_textures(mcrt_unordered_map<mcrt_string, brx_sampled_asset_image *> const &mapped_textures, mcrt_string const &scene_asset_file_name, scene_cache_mesh const &mesh, mcrt_vector<brx_sampled_asset_image *> &out_textures);
+
+static inline uint64_t compute_scene_mesh_content_hash(scene_cache_mesh const &mesh, mcrt_vector<brx_sampled_asset_image *> const &textures);
+
+static inline bool is_scene_mesh_content_equal(scene_cache_mesh const &mesh_a, mcrt_vector<brx_sampled_asset_image *> const &textures_a, scene_cache_mesh const &mesh_b, mcrt_vector<brx_sampled_asset_image *> const &textures_b);
+
+struct scene_asset_import_result
+{
+    uint64_t m_scene_cache_source_hash;
+    bool m_scene_cache_hit;
+    bool m_scene_loaded;
+    mapped_file m_scene_cache_file;
+    mcrt_vector<scene_mesh_data> m_mesh_data;
+    mcrt_vector<scene_cache_mesh> m_cooked_mesh_data;
+};
+
+struct scene_asset_import_task_data
+{
+    mcrt_vector<mcrt_string> const *m_file_names;
+    // NULL when the assets embedded in the executable are used (and the scene cache is not available)
+    mapped_file_input_stream_factory *m_mapped_file_input_stream_factory;
+    char const *m_scene_cache_directory;
+    scene_asset_import_result *m_results;
+};
+
+static void scene_asset_import_task_main(uint32_t file_name_index, void *user_data);
+
+static void import_uncached_scene_asset(mcrt_string const &file_name, import_asset_input_stream_factory *input_stream_factory, scene_asset_import_result *inout_result);
+
+static void scene_cache_write_task_main(uint32_t file_name_index, void *user_data);
+
+static void image_asset_import_task_main(uint32_t image_asset_import_task_index, void *user_data);
+
+static void texture_streaming_thread_main(Demo_Texture_Streaming_Thread_Context *context);
+
+static inline void free_streaming_texture_staging_upload_memory(brx_device *device, staging_upload_ring *staging_upload_ring, Demo_Streaming_Texture *streaming_texture);
+
+static inline uint64_t apply_texture_memory_budget(uint64_t texture_memory_budget, mcrt_vector<Demo_Streaming_Texture> &inout_streaming_textures);
+
+static inline void drop_skipped_streaming_texture_mips(uint32_t staging_upload_buffer_offset_alignment, uint32_t staging_upload_buffer_row_pitch_alignment, Demo_Streaming_Texture *inout_streaming_texture);
+
+struct draw_skin_task_data
+{
+    Demo_Mesh_Instance *const *m_skinned_mesh_instances;
+    uint32_t m_skinned_mesh_instance_count;
+    size_t m_animation_frame_index;
+    void *m_skin_pipeline_per_mesh_instance_update_uniform_buffer_host_memory_range_base;
+};
+
+static void draw_skin_task_main(uint32_t chunk_index, void *user_data);
+
+struct draw_top_level_acceleration_structure_task_data
+{
+    Demo_Scene_Instance const *m_scene_instances;
+    uint32_t m_scene_instance_count;
+    brx_top_level_acceleration_structure_instance_upload_buffer *m_top_level_acceleration_structure_instance_upload_buffer;
+};
+
+static void draw_top_level_acceleration_structure_task_main(uint32_t chunk_index, void *user_data);
+
 // 60 FPS
 static constexpr float const animation_frame_rate = 60.0F;
 
-Demo::Demo()
+// the assets are read from the files under this directory (which can be overridden by the environment variable), and the assets embedded in the executable are used if there is no file
+static char const *const default_asset_content_root = "assets";
+static char const *const asset_content_root_environment_variable_name = "DEMO_ASSET_CONTENT_ROOT";
+
+// the GPU-ready buffers of the static scenes are cached under this directory (which can be overridden by the environment variable) to skip the import at the next launch
+static char const *const default_scene_cache_directory = "scene-cache";
+static char const *const scene_cache_directory_environment_variable_name = "DEMO_SCENE_CACHE_DIRECTORY";
+
+// the textures cooked by the cooker are read from this directory (which can be overridden by the environment variable), and are preferred over the cooked images shipped with the assets
+static char const *const default_cooked_texture_directory = "cooked-textures";
+static char const *const cooked_texture_directory_environment_variable_name = "DEMO_COOKED_TEXTURE_DIRECTORY";
+
+// the textures are decoded by the streaming thread in batches of this size, and at most this number of textures are uploaded per batch on the upload queue
+static constexpr uint32_t const texture_streaming_batch_texture_count = 8U;
+
+// the alignment of the sub-allocations of the geometry pool buffer
+static constexpr uint32_t const geometry_pool_alignment = 16U;
+
+// the indices of the cooked mesh subset buffers which are sub-allocated from the geometry pool buffer
+static constexpr uint32_t const GEOMETRY_POOL_VERTEX_VARYING_BUFFER_INDEX = 2U;
+static constexpr uint32_t const GEOMETRY_POOL_INFORMATION_BUFFER_INDEX = 5U;
+
+// the temporary memory of the loading (the vectors of the scene meshes, the build inputs and so on) is bump allocated from the chunks of this size
+static constexpr size_t const load_arena_chunk_size = 4U * 1024U * 1024U;
+
+// the staging memory of the uploads at load time is suballocated from the staging upload buffers of this size
+static constexpr uint32_t const staging_upload_arena_chunk_size = 32U * 1024U * 1024U;
+
+// the staging memory of the texture streaming is bounded by this size (except for the texture which is larger than this size)
+static constexpr uint32_t const texture_streaming_staging_upload_ring_size = 64U * 1024U * 1024U;
+
+// the memory of the scene textures (in MiB) is bounded by the environment variable, and zero (the default) means no budget
+static char const *const texture_memory_budget_environment_variable_name = "DEMO_TEXTURE_MEMORY_BUDGET";
+
+// the number of the copies of the loaded scenes (the stress mode is disabled when not set)
+static char const *const stress_replication_count_environment_variable_name = "DEMO_STRESS_REPLICATION_COUNT";
+
+// the distance between the copies on the grid (in meters)
+static constexpr float const stress_replication_grid_spacing = 8.0F;
+
+// the animation of each copy starts at a random frame within this range
+static constexpr uint32_t const stress_replication_max_animation_frame_offset = 256U;
+
+// the skinned instances and the scene instances are distributed to the draw worker pool in chunks of this size
+static constexpr uint32_t const draw_task_chunk_instance_count = 64U;
+
+// the cost of each pass is averaged over this number of frames
+static constexpr uint32_t const stress_report_frame_count = 256U;
+
+static constexpr uint32_t const STRESS_REPORT_PASS_COUNT = DEMO_STRESS_REPORT_PASS_COUNT;
+static char const *const stress_report_pass_names[STRESS_REPORT_PASS_COUNT] = {"Update Uniform Buffer", "Skin", "Update BLAS", "Update TLAS", "GBuffer", "Ambient Occlusion"};
+
+Demo::Demo() : m_input_stream_factory(NULL), m_texture_streaming_fence(NULL)
 {
 }
 
@@ -73,7 +202,7 @@ void Demo::init(brx_device *device)
         BRX_DESCRIPTOR_SET_LAYOUT_BINDING const gbuffer_pipeline_none_update_descriptor_set_layout_bindings[] = {
             {0U, BRX_DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER, 1U},
             {1U, BRX_DESCRIPTOR_TYPE_TOP_LEVEL_ACCELERATION_STRUCTURE, 1U},
-            {2U, BRX_DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER, 1U},
+            {2U, BRX_DESCRIPTOR_TYPE_READ_ONLY_STORAGE_BUFFER, SCENE_INFORMATION_BUFFER_COUNT},
             {3U, BRX_DESCRIPTOR_TYPE_SAMPLER, 1U},
             {4U, BRX_DESCRIPTOR_TYPE_STORAGE_IMAGE, 2U}};
         this->m_gbuffer_pipeline_none_update_descriptor_set_layout = device->create_descriptor_set_layout(sizeof(gbuffer_pipeline_none_update_descriptor_set_layout_bindings) / sizeof(gbuffer_pipeline_none_update_descriptor_set_layout_bindings[0]), gbuffer_pipeline_none_update_descriptor_set_layout_bindings);
@@ -137,6 +266,10 @@ void Demo::init(brx_device *device)
 
         brx_fence *const fence = device->create_fence(true);
 
+        // the temporary vectors of the steps are allocated from the arena, which is destroyed after all of them have gone out of scope
+        load_arena load_arena;
+        load_arena.init(load_arena_chunk_size);
+
         // step 1
         // upload buffers
         // upload textures
@@ -144,9 +277,11 @@ void Demo::init(brx_device *device)
         mcrt_vector<brx_non_compacted_bottom_level_acceleration_structure *> scene_non_compacted_bottom_level_acceleration_structures;
         brx_compacted_bottom_level_acceleration_structure_size_query_pool *compacted_bottom_level_acceleration_structure_size_query_pool = NULL;
         {
-            mcrt_vector<brx_staging_upload_buffer *> staging_upload_buffers;
+            // the staging memory is suballocated from a few large staging upload buffers, which are destroyed after the fence
+            staging_upload_arena staging_upload_arena;
+            staging_upload_arena.init(device, staging_upload_arena_chunk_size);
 
-            mcrt_vector<brx_scratch_buffer *> scratch_buffers;
+            load_arena_vector<brx_scratch_buffer *> scratch_buffers(&load_arena);
 
             device->reset_upload_command_buffer(upload_command_buffer);
 
@@ -164,235 +299,222 @@ void Demo::init(brx_device *device)
             {
                 mcrt_vector<mcrt_string> const file_names = {"the-white-room/the-white-room.gltf", "keqing-lolita/keqing-lolita-love-you.gltf"};
 
-                mcrt_vector<DirectX::XMFLOAT4X4> root_transforms(static_cast<size_t>(file_names.size()));
+                load_arena_vector<DirectX::XMFLOAT4X4> root_transforms(static_cast<size_t>(file_names.size()), &load_arena);
                 DirectX::XMStoreFloat4x4(&root_transforms[0], DirectX::XMMatrixIdentity());
                 DirectX::XMStoreFloat4x4(&root_transforms[1], DirectX::XMMatrixTranslation(0.0, 0.0, 2.0));
 
-                import_asset_input_stream_factory *input_stream_factory = import_asset_init_memory_input_stream_factory();
-
-                mcrt_unordered_map<mcrt_string, brx_sampled_asset_image *> mapped_textures;
+                char const *asset_content_root = getenv(asset_content_root_environment_variable_name);
+                if (NULL == asset_content_root)
+                {
+                    asset_content_root = default_asset_content_root;
+                }
 
-                for (size_t file_name_index = 0U; file_name_index < file_names.size(); ++file_name_index)
+                char const *scene_cache_directory = getenv(scene_cache_directory_environment_variable_name);
+                if (NULL == scene_cache_directory)
                 {
-                    mcrt_string const &file_name = file_names[file_name_index];
-                    DirectX::XMFLOAT4X4 const &root_transform = root_transforms[file_name_index];
+                    scene_cache_directory = default_scene_cache_directory;
+                }
 
-                    mcrt_vector<scene_mesh_data> total_mesh_data;
-                    if (import_gltf_scene_asset(total_mesh_data, animation_frame_rate, input_stream_factory, file_name.c_str()))
-                    {
-                        size_t mesh_index_offset = this->m_scene_meshes.size();
+                char const *cooked_texture_directory = getenv(cooked_texture_directory_environment_variable_name);
+                if (NULL == cooked_texture_directory)
+                {
+                    cooked_texture_directory = default_cooked_texture_directory;
+                }
 
-                        this->m_scene_meshes.resize(mesh_index_offset + total_mesh_data.size());
+                this->m_use_mapped_file_input_stream_factory = this->m_mapped_file_input_stream_factory.init(asset_content_root);
 
-                        for (size_t mesh_index = 0U; mesh_index < total_mesh_data.size(); ++mesh_index)
-                        {
-                            scene_mesh_data const &in_mesh_data = total_mesh_data[mesh_index];
+                // the same as the scene cache, the cooked textures are only used when the assets are read from the files
+                this->m_use_cooked_texture_input_stream_factory = this->m_use_mapped_file_input_stream_factory && this->m_cooked_texture_input_stream_factory.init(cooked_texture_directory);
 
-                            Demo_Mesh &out_mesh = this->m_scene_meshes[mesh_index_offset + mesh_index];
+                this->m_input_stream_factory = this->m_use_mapped_file_input_stream_factory ? this->m_mapped_file_input_stream_factory.get_input_stream_factory() : import_asset_init_memory_input_stream_factory();
 
-                            out_mesh.m_skinned = in_mesh_data.m_skinned;
+                import_asset_input_stream_factory *const input_stream_factory = this->m_input_stream_factory;
 
-                            out_mesh.m_subsets.resize(in_mesh_data.m_subsets.size());
+                mcrt_unordered_map<mcrt_string, brx_sampled_asset_image *> mapped_textures;
 
-                            for (size_t subset_index = 0U; subset_index < in_mesh_data.m_subsets.size(); ++subset_index)
-                            {
-                                scene_mesh_subset_data const &in_subset_data = in_mesh_data.m_subsets[subset_index];
+#ifndef NDEBUG
+                // the average cache lines (of the vertex position buffer and the vertex varying buffer) per triangle, weighted by the triangle count
+                // only reported by the debug build
+                double total_cache_lines_before_locality_optimization = 0.0;
+                double total_cache_lines_after_locality_optimization = 0.0;
+                uint64_t total_triangle_count = 0U;
+#endif
 
-                                Demo_Mesh_Subset &out_subset = out_mesh.m_subsets[subset_index];
+                // import the scenes (or read them from the scene cache) on the worker threads
+                mcrt_vector<scene_asset_import_result> scene_asset_import_results(file_names.size());
 
-                                // Buffer
-                                {
-                                    static constexpr uint32_t const DEMO_MESH_SUBSET_ASSET_BUFFER_COUNT = 5U;
+                scene_asset_import_task_data scene_asset_import_task_user_data;
+                scene_asset_import_task_user_data.m_file_names = &file_names;
+                scene_asset_import_task_user_data.m_mapped_file_input_stream_factory = this->m_use_mapped_file_input_stream_factory ? (&this->m_mapped_file_input_stream_factory) : NULL;
+                scene_asset_import_task_user_data.m_scene_cache_directory = scene_cache_directory;
+                scene_asset_import_task_user_data.m_results = scene_asset_import_results.data();
 
-                                    out_subset.m_vertex_count = static_cast<uint32_t>(in_subset_data.m_vertex_position_binding.size());
+                worker_pool_parallel_for(static_cast<uint32_t>(file_names.size()), scene_asset_import_task_main, &scene_asset_import_task_user_data);
 
-                                    out_subset.m_index_count = static_cast<uint32_t>(in_subset_data.m_indices.size());
+                // cook the mesh subsets of the imported scenes on the worker threads
+                {
+                    load_arena_vector<scene_cook_mesh_subset_task> mesh_subset_cook_tasks(&load_arena);
+                    for (size_t file_name_index = 0U; file_name_index < file_names.size(); ++file_name_index)
+                    {
+                        scene_asset_import_result &import_result = scene_asset_import_results[file_name_index];
 
-                                    out_subset.m_index_type = (in_subset_data.m_max_index <= static_cast<uint32_t>(UINT16_MAX)) ? BRX_GRAPHICS_PIPELINE_INDEX_TYPE_UINT16 : BRX_GRAPHICS_PIPELINE_INDEX_TYPE_UINT32;
+                        if (import_result.m_scene_loaded && (!import_result.m_scene_cache_hit))
+                        {
+                            assert(import_result.m_mesh_data.size() == import_result.m_cooked_mesh_data.size());
 
-                                    assert(out_subset.m_vertex_count == in_subset_data.m_vertex_varying_binding.size());
+                            for (size_t mesh_index = 0U; mesh_index < import_result.m_mesh_data.size(); ++mesh_index)
+                            {
+                                scene_mesh_data &in_mesh_data = import_result.m_mesh_data[mesh_index];
 
-                                    assert((!in_mesh_data.m_skinned) || (out_subset.m_vertex_count == in_subset_data.m_vertex_joint_binding.size()));
+                                scene_cache_mesh &out_cooked_mesh_data = import_result.m_cooked_mesh_data[mesh_index];
 
-                                    mcrt_vector<uint16_t> uint16_indices;
-                                    if (BRX_GRAPHICS_PIPELINE_INDEX_TYPE_UINT16 == out_subset.m_index_type)
-                                    {
-                                        uint16_indices.resize(out_subset.m_index_count);
+                                assert(in_mesh_data.m_subsets.size() == out_cooked_mesh_data.m_subsets.size());
 
-                                        for (uint32_t index_index = 0U; index_index < out_subset.m_index_count; ++index_index)
-                                        {
-                                            uint16_indices[index_index] = static_cast<uint32_t>(in_subset_data.m_indices[index_index]);
-                                        }
-                                    }
+                                for (size_t subset_index = 0U; subset_index < in_mesh_data.m_subsets.size(); ++subset_index)
+                                {
+                                    mesh_subset_cook_tasks.push_back(scene_cook_mesh_subset_task{in_mesh_data.m_skinned, &in_mesh_data.m_subsets[subset_index], &out_cooked_mesh_data.m_subsets[subset_index], 0.0, 0.0, 0U});
+                                }
+                            }
+                        }
+                    }
 
-                                    mesh_subset_information_storage_buffer_T mesh_subset_information_storage_buffer_T_source;
-                                    {
-                                        mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags = 0U;
-                                        if (BRX_GRAPHICS_PIPELINE_INDEX_TYPE_UINT16 == out_subset.m_index_type)
-                                        {
-                                            mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags |= Buffer_Flag_Index_Type_UInt16;
-                                        }
-                                        if (!in_subset_data.m_normal_texture_image_uri.empty())
-                                        {
-                                            mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags |= Texture_Flag_Enable_Normal_Texture;
-                                        }
-                                        if (!in_subset_data.m_emissive_texture_image_uri.empty())
-                                        {
-                                            mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags |= Texture_Flag_Enable_Emissive_Texture;
-                                        }
-                                        if (!in_subset_data.m_base_color_texture_image_uri.empty())
-                                        {
-                                            mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags |= Texture_Flag_Enable_Base_Colorl_Texture;
-                                        }
-                                        if (!in_subset_data.m_metallic_roughness_texture_image_uri.empty())
-                                        {
-                                            mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags |= Texture_Flag_Enable_Metallic_Roughness_Texture;
-                                        }
-                                        mesh_subset_information_storage_buffer_T_source.m_normal_texture_scale = in_subset_data.m_normal_texture_scale;
-                                        mesh_subset_information_storage_buffer_T_source.m_emissive_factor_x = in_subset_data.m_emissive_factor.x;
-                                        mesh_subset_information_storage_buffer_T_source.m_emissive_factor_y = in_subset_data.m_emissive_factor.y;
-                                        mesh_subset_information_storage_buffer_T_source.m_emissive_factor_z = in_subset_data.m_emissive_factor.z;
-                                        mesh_subset_information_storage_buffer_T_source.m_base_color_factor_x = in_subset_data.m_base_color_factor.x;
-                                        mesh_subset_information_storage_buffer_T_source.m_base_color_factor_y = in_subset_data.m_base_color_factor.y;
-                                        mesh_subset_information_storage_buffer_T_source.m_base_color_factor_z = in_subset_data.m_base_color_factor.z;
-                                        mesh_subset_information_storage_buffer_T_source.m_metallic_factor = in_subset_data.m_metallic_factor;
-                                        mesh_subset_information_storage_buffer_T_source.m_roughness_factor = in_subset_data.m_roughness_factor;
-                                    }
+                    worker_pool_parallel_for(static_cast<uint32_t>(mesh_subset_cook_tasks.size()), scene_cook_mesh_subset_task_main, mesh_subset_cook_tasks.data());
 
-                                    size_t const source_asset_buffer_sizes[DEMO_MESH_SUBSET_ASSET_BUFFER_COUNT] = {
-                                        sizeof(scene_mesh_vertex_position_binding) * out_subset.m_vertex_count,
-                                        sizeof(scene_mesh_vertex_varying_binding) * out_subset.m_vertex_count,
-                                        (!in_mesh_data.m_skinned) ? 0U : sizeof(scene_mesh_vertex_joint_binding) * out_subset.m_vertex_count,
-                                        (BRX_GRAPHICS_PIPELINE_INDEX_TYPE_UINT16 == out_subset.m_index_type) ? (sizeof(uint16_t) * out_subset.m_index_count) : (sizeof(uint32_t) * out_subset.m_index_count),
-                                        sizeof(mesh_subset_information_storage_buffer_T)};
-
-                                    void const *const source_asset_buffers[DEMO_MESH_SUBSET_ASSET_BUFFER_COUNT] = {
-                                        in_subset_data.m_vertex_position_binding.data(),
-                                        in_subset_data.m_vertex_varying_binding.data(),
-                                        (!in_mesh_data.m_skinned) ? NULL : in_subset_data.m_vertex_joint_binding.data(),
-                                        (BRX_GRAPHICS_PIPELINE_INDEX_TYPE_UINT16 == out_subset.m_index_type) ? static_cast<void const *>(uint16_indices.data()) : static_cast<void const *>(in_subset_data.m_indices.data()),
-                                        &mesh_subset_information_storage_buffer_T_source};
-
-                                    brx_storage_asset_buffer **const destination_asset_buffers[DEMO_MESH_SUBSET_ASSET_BUFFER_COUNT] = {
-                                        &out_subset.m_vertex_position_buffer,
-                                        &out_subset.m_vertex_varying_buffer,
-                                        &out_subset.m_vertex_joint_buffer,
-                                        &out_subset.m_index_buffer,
-                                        &out_subset.m_information_buffer};
-
-                                    for (uint32_t mesh_subset_asset_buffer_index = 0U; mesh_subset_asset_buffer_index < DEMO_MESH_SUBSET_ASSET_BUFFER_COUNT; ++mesh_subset_asset_buffer_index)
-                                    {
-                                        brx_storage_asset_buffer *&destination_asset_buffer = (*destination_asset_buffers[mesh_subset_asset_buffer_index]);
+#ifndef NDEBUG
+                    for (size_t mesh_subset_cook_task_index = 0U; mesh_subset_cook_task_index < mesh_subset_cook_tasks.size(); ++mesh_subset_cook_task_index)
+                    {
+                        total_cache_lines_before_locality_optimization += mesh_subset_cook_tasks[mesh_subset_cook_task_index].m_cache_lines_before_locality_optimization;
+                        total_cache_lines_after_locality_optimization += mesh_subset_cook_tasks[mesh_subset_cook_task_index].m_cache_lines_after_locality_optimization;
+                        total_triangle_count += mesh_subset_cook_tasks[mesh_subset_cook_task_index].m_triangle_count;
+                    }
+#endif
+                }
 
-                                        if (NULL != source_asset_buffers[mesh_subset_asset_buffer_index])
-                                        {
-                                            uint32_t const asset_buffer_size = static_cast<uint32_t>(source_asset_buffer_sizes[mesh_subset_asset_buffer_index]);
+                // write the scene cache on the worker threads
+                worker_pool_parallel_for(static_cast<uint32_t>(file_names.size()), scene_cache_write_task_main, &scene_asset_import_task_user_data);
 
-                                            destination_asset_buffer = device->create_storage_asset_buffer(asset_buffer_size);
+                // the scenes which do NOT fit in the bindless buffer slots are skipped (rather than asserted), and the limit is reported
+                // the count is conservative (the identical static meshes have NOT been collapsed yet), which guarantees that "allocate_bindless_buffers" never fails
+                {
+                    // the geometry pool buffer
+                    uint64_t bindless_buffer_count = 1U;
+                    for (size_t file_name_index = 0U; file_name_index < file_names.size(); ++file_name_index)
+                    {
+                        scene_asset_import_result &import_result = scene_asset_import_results[file_name_index];
 
-                                            brx_staging_upload_buffer *const asset_buffer_staging_upload_buffer = device->create_staging_upload_buffer(asset_buffer_size);
+                        if (import_result.m_scene_loaded)
+                        {
+                            uint64_t scene_bindless_buffer_count = 0U;
+                            for (size_t mesh_index = 0U; mesh_index < import_result.m_cooked_mesh_data.size(); ++mesh_index)
+                            {
+                                scene_cache_mesh const &in_mesh_data = import_result.m_cooked_mesh_data[mesh_index];
 
-                                            staging_upload_buffers.push_back(asset_buffer_staging_upload_buffer);
+                                // the index buffer (shared by all instances) and the vertex position buffer (static) or the skinned vertex position and varying buffers (per instance)
+                                scene_bindless_buffer_count += in_mesh_data.m_subsets.size() * (1U + (in_mesh_data.m_skinned ? (2U * in_mesh_data.m_instance_model_transforms.size()) : 1U));
+                            }
 
-                                            std::memcpy(asset_buffer_staging_upload_buffer->get_host_memory_range_base(), source_asset_buffers[mesh_subset_asset_buffer_index], asset_buffer_size);
+                            if ((bindless_buffer_count + scene_bindless_buffer_count) <= MAX_MESH_SUBSET_BUFFER_COUNT)
+                            {
+                                bindless_buffer_count += scene_bindless_buffer_count;
+                            }
+                            else
+                            {
+                                printf("Bindless Buffers: the scene \"%s\" is skipped, since %llu bindless buffers are required and %llu are left (MAX_MESH_SUBSET_BUFFER_COUNT %u)\n", file_names[file_name_index].c_str(), static_cast<unsigned long long>(scene_bindless_buffer_count), static_cast<unsigned long long>(MAX_MESH_SUBSET_BUFFER_COUNT - bindless_buffer_count), static_cast<unsigned>(MAX_MESH_SUBSET_BUFFER_COUNT));
+                                import_result.m_scene_loaded = false;
+                            }
+                        }
+                    }
+                }
 
-                                            upload_command_buffer->upload_from_staging_upload_buffer_to_storage_asset_buffer(destination_asset_buffer, 0U, asset_buffer_staging_upload_buffer, 0U, asset_buffer_size);
-                                        }
-                                        else
-                                        {
-                                            assert(0U == source_asset_buffer_sizes[mesh_subset_asset_buffer_index]);
+                // stream the textures
+                // the textures are deduplicated on this thread, and the staging buffers and the images are also created on this thread
+                // the image data is decoded on the streaming thread, and uploaded over several frames by "update_texture_streaming"
+                {
+                    uint32_t const staging_upload_buffer_offset_alignment = device->get_staging_upload_buffer_offset_alignment();
+                    uint32_t const staging_upload_buffer_row_pitch_alignment = device->get_staging_upload_buffer_row_pitch_alignment();
 
-                                            assert(NULL == source_asset_buffers[mesh_subset_asset_buffer_index]);
+                    assert(this->m_streaming_textures.empty());
 
-                                            destination_asset_buffer = NULL;
-                                        }
-                                    }
-                                }
+                    mcrt_vector<mcrt_string> streaming_texture_file_names;
 
-                                // Texture
-                                {
-                                    static constexpr uint32_t const DEMO_MESH_SUBSET_ASSET_TEXTURE_COUNT = 4U;
+                    for (size_t file_name_index = 0U; file_name_index < file_names.size(); ++file_name_index)
+                    {
+                        mcrt_string const &file_name = file_names[file_name_index];
 
-                                    uint32_t const staging_upload_buffer_offset_alignment = device->get_staging_upload_buffer_offset_alignment();
-                                    uint32_t const staging_upload_buffer_row_pitch_alignment = device->get_staging_upload_buffer_row_pitch_alignment();
+                        scene_asset_import_result const &import_result = scene_asset_import_results[file_name_index];
 
-                                    mcrt_string const *const asset_texture_image_uris[DEMO_MESH_SUBSET_ASSET_TEXTURE_COUNT] = {
-                                        &in_subset_data.m_normal_texture_image_uri,
-                                        &in_subset_data.m_emissive_texture_image_uri,
-                                        &in_subset_data.m_base_color_texture_image_uri,
-                                        &in_subset_data.m_metallic_roughness_texture_image_uri};
+                        if (import_result.m_scene_loaded)
+                        {
+                            for (size_t mesh_index = 0U; mesh_index < import_result.m_cooked_mesh_data.size(); ++mesh_index)
+                            {
+                                scene_cache_mesh const &in_mesh_data = import_result.m_cooked_mesh_data[mesh_index];
 
-                                    brx_sampled_asset_image **const destination_asset_textures[DEMO_MESH_SUBSET_ASSET_TEXTURE_COUNT] = {
-                                        &out_subset.m_normal_texture,
-                                        &out_subset.m_emissive_texture,
-                                        &out_subset.m_base_color_texture,
-                                        &out_subset.m_metallic_roughness_texture};
+                                for (size_t subset_index = 0U; subset_index < in_mesh_data.m_subsets.size(); ++subset_index)
+                                {
+                                    scene_cache_mesh_subset const &in_subset_data = in_mesh_data.m_subsets[subset_index];
 
-                                    for (uint32_t mesh_subset_asset_texture_index = 0U; mesh_subset_asset_texture_index < DEMO_MESH_SUBSET_ASSET_TEXTURE_COUNT; ++mesh_subset_asset_texture_index)
+                                    for (uint32_t mesh_subset_asset_texture_index = 0U; mesh_subset_asset_texture_index < SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT; ++mesh_subset_asset_texture_index)
                                     {
-                                        mcrt_string const &asset_texture_image_uri = (*asset_texture_image_uris[mesh_subset_asset_texture_index]);
-
-                                        brx_sampled_asset_image *&destination_asset_texture = (*destination_asset_textures[mesh_subset_asset_texture_index]);
+                                        mcrt_string const &asset_texture_image_uri = in_subset_data.m_texture_image_uris[mesh_subset_asset_texture_index];
 
                                         if (!asset_texture_image_uri.empty())
                                         {
+                                            mcrt_string image_asset_file_name_source;
                                             mcrt_string image_asset_file_name_dds;
                                             mcrt_string image_asset_file_name_pvr;
-                                            {
-                                                mcrt_string image_asset_file_name;
-
-                                                size_t dir_name_pos = file_name.find_last_of("/\\");
-                                                if (mcrt_string::npos != dir_name_pos)
-                                                {
-                                                    image_asset_file_name = file_name.substr(0U, dir_name_pos + 1U);
-                                                }
-                                                else
-                                                {
-                                                    image_asset_file_name += "./";
-                                                }
-
-                                                size_t ext_name_pos = asset_texture_image_uri.find_last_of(".");
-                                                if (mcrt_string::npos != ext_name_pos)
-                                                {
-                                                    image_asset_file_name += asset_texture_image_uri.substr(0U, ext_name_pos + 1U);
-                                                }
-                                                else
-                                                {
-                                                    image_asset_file_name += asset_texture_image_uri;
-                                                }
-
-                                                image_asset_file_name_dds = (image_asset_file_name + "dds");
-                                                image_asset_file_name_pvr = (image_asset_file_name + "pvr");
-                                            }
+                                            texture_cook_get_image_asset_file_names(file_name, asset_texture_image_uri, &image_asset_file_name_source, &image_asset_file_name_dds, &image_asset_file_name_pvr);
 
                                             mcrt_unordered_map<mcrt_string, brx_sampled_asset_image *>::const_iterator found;
-                                            if (mapped_textures.end() != (found = mapped_textures.find(image_asset_file_name_dds)) || mapped_textures.end() != (found = mapped_textures.find(image_asset_file_name_pvr)))
-                                            {
-                                                assert(NULL != found->second);
-                                                destination_asset_texture = found->second;
-                                            }
-                                            else
+                                            if (mapped_textures.end() == (found = mapped_textures.find(image_asset_file_name_dds)) && mapped_textures.end() == (found = mapped_textures.find(image_asset_file_name_pvr)) && mapped_textures.end() == (found = mapped_textures.find(image_asset_file_name_source)))
                                             {
+                                                // the textures cooked by the cooker are preferred over the cooked images shipped with the assets
+                                                import_asset_input_stream_factory *const cooked_texture_input_stream_factory = this->m_use_cooked_texture_input_stream_factory ? this->m_cooked_texture_input_stream_factory.get_input_stream_factory() : NULL;
+
                                                 mcrt_string import_image_asset_file_name;
+                                                import_asset_input_stream_factory *import_image_asset_input_stream_factory;
                                                 import_asset_input_stream *import_image_asset_input_stream;
                                                 bool (*pfn_import_image_asset_header_from_input_stream)(import_asset_input_stream *, IMPORT_ASSET_IMAGE_HEADER *, size_t *);
                                                 bool (*pfn_import_image_asset_data_from_input_stream)(import_asset_input_stream *, IMPORT_ASSET_IMAGE_HEADER const *, size_t, void *, size_t, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *);
-                                                if (device->is_sampled_asset_image_compression_bc_supported() && (NULL != (import_image_asset_input_stream = input_stream_factory->create_instance(image_asset_file_name_dds.c_str()))))
+                                                if (device->is_sampled_asset_image_compression_bc_supported() && (NULL != cooked_texture_input_stream_factory) && (NULL != (import_image_asset_input_stream = cooked_texture_input_stream_factory->create_instance(texture_cook_get_cooked_image_asset_file_name(image_asset_file_name_dds).c_str()))))
+                                                {
+                                                    import_image_asset_file_name = image_asset_file_name_dds;
+                                                    import_image_asset_input_stream_factory = cooked_texture_input_stream_factory;
+                                                    pfn_import_image_asset_header_from_input_stream = import_dds_image_asset_header_from_input_stream;
+                                                    pfn_import_image_asset_data_from_input_stream = import_dds_image_asset_data_from_input_stream;
+                                                }
+                                                else if (device->is_sampled_asset_image_compression_astc_supported() && (NULL != cooked_texture_input_stream_factory) && (NULL != (import_image_asset_input_stream = cooked_texture_input_stream_factory->create_instance(texture_cook_get_cooked_image_asset_file_name(image_asset_file_name_pvr).c_str()))))
+                                                {
+                                                    import_image_asset_file_name = image_asset_file_name_pvr;
+                                                    import_image_asset_input_stream_factory = cooked_texture_input_stream_factory;
+                                                    pfn_import_image_asset_header_from_input_stream = import_pvr_image_asset_header_from_input_stream;
+                                                    pfn_import_image_asset_data_from_input_stream = import_pvr_image_asset_data_from_input_stream;
+                                                }
+                                                else if (device->is_sampled_asset_image_compression_bc_supported() && (NULL != (import_image_asset_input_stream = input_stream_factory->create_instance(image_asset_file_name_dds.c_str()))))
                                                 {
                                                     import_image_asset_file_name = image_asset_file_name_dds;
+                                                    import_image_asset_input_stream_factory = input_stream_factory;
                                                     pfn_import_image_asset_header_from_input_stream = import_dds_image_asset_header_from_input_stream;
                                                     pfn_import_image_asset_data_from_input_stream = import_dds_image_asset_data_from_input_stream;
                                                 }
                                                 else if (device->is_sampled_asset_image_compression_astc_supported() && (NULL != (import_image_asset_input_stream = input_stream_factory->create_instance(image_asset_file_name_pvr.c_str()))))
                                                 {
                                                     import_image_asset_file_name = image_asset_file_name_pvr;
+                                                    import_image_asset_input_stream_factory = input_stream_factory;
                                                     pfn_import_image_asset_header_from_input_stream = import_pvr_image_asset_header_from_input_stream;
                                                     pfn_import_image_asset_data_from_input_stream = import_pvr_image_asset_data_from_input_stream;
                                                 }
-                                                else
+                                                else if (texture_cook_is_source_image_supported(image_asset_file_name_source) && (NULL != (import_image_asset_input_stream = input_stream_factory->create_instance(image_asset_file_name_source.c_str()))))
                                                 {
+                                                    // the texture has not been cooked (or the compression is not supported by the device): transcoded to RGBA8 on the worker thread
                                                     // TODO: jpeg
-                                                    // TODO: png
+                                                    import_image_asset_file_name = image_asset_file_name_source;
+                                                    import_image_asset_input_stream_factory = input_stream_factory;
+                                                    pfn_import_image_asset_header_from_input_stream = (TEXTURE_COOK_USAGE_COLOR == texture_cook_get_usage(mesh_subset_asset_texture_index)) ? texture_transcode_png_color_image_asset_header_from_input_stream : texture_transcode_png_linear_image_asset_header_from_input_stream;
+                                                    pfn_import_image_asset_data_from_input_stream = texture_transcode_png_image_asset_data_from_input_stream;
+                                                }
+                                                else
+                                                {
+                                                    import_image_asset_input_stream_factory = NULL;
                                                     import_image_asset_input_stream = NULL;
                                                     pfn_import_image_asset_header_from_input_stream = NULL;
                                                     pfn_import_image_asset_data_from_input_stream = NULL;
@@ -400,1545 +522,2941 @@ void Demo::init(brx_device *device)
 
                                                 if (NULL != import_image_asset_input_stream && NULL != pfn_import_image_asset_header_from_input_stream && NULL != pfn_import_image_asset_data_from_input_stream)
                                                 {
-                                                    IMPORT_ASSET_IMAGE_HEADER image_asset_header;
-                                                    mcrt_vector<BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST> subresource_memcpy_dests;
-                                                    brx_staging_upload_buffer *image_staging_upload_buffer = NULL;
-                                                    {
-                                                        size_t image_asset_data_offset;
-                                                        bool const res_import_image_asset_header = pfn_import_image_asset_header_from_input_stream(import_image_asset_input_stream, &image_asset_header, &image_asset_data_offset);
-                                                        assert(res_import_image_asset_header);
-
-                                                        uint32_t const subresource_count = image_asset_header.mip_levels;
-                                                        subresource_memcpy_dests.resize(subresource_count);
-
-                                                        // TODO: support more image paramters
-                                                        assert(!image_asset_header.is_cube_map);
-                                                        assert(IMPORT_ASSET_IMAGE_TYPE_2D == image_asset_header.type);
-                                                        assert(1U == image_asset_header.depth);
-                                                        assert(1U == image_asset_header.array_layers);
-                                                        uint32_t const total_bytes = brx_sampled_asset_image_import_calculate_subresource_memcpy_dests(image_asset_header.format, image_asset_header.width, image_asset_header.height, 1U, image_asset_header.mip_levels, 1U, 0U, staging_upload_buffer_offset_alignment, staging_upload_buffer_row_pitch_alignment, subresource_count, &subresource_memcpy_dests[0]);
-                                                        image_staging_upload_buffer = device->create_staging_upload_buffer(static_cast<uint32_t>(total_bytes));
-                                                        staging_upload_buffers.push_back(image_staging_upload_buffer);
-
-                                                        bool const res_import_image_asset_data = pfn_import_image_asset_data_from_input_stream(import_image_asset_input_stream, &image_asset_header, image_asset_data_offset, image_staging_upload_buffer->get_host_memory_range_base(), subresource_count, &subresource_memcpy_dests[0]);
-                                                        assert(res_import_image_asset_data);
-                                                    }
-                                                    input_stream_factory->destory_instance(import_image_asset_input_stream);
-
-                                                    destination_asset_texture = device->create_sampled_asset_image(image_asset_header.format, image_asset_header.width, image_asset_header.height, image_asset_header.mip_levels);
-
-                                                    mapped_textures.emplace_hint(found, import_image_asset_file_name, destination_asset_texture);
-
-                                                    for (uint32_t mip_level = 0U; mip_level < image_asset_header.mip_levels; ++mip_level)
-                                                    {
-                                                        upload_command_buffer->upload_from_staging_upload_buffer_to_sampled_asset_image(destination_asset_texture, image_asset_header.format, image_asset_header.width, image_asset_header.height, mip_level, image_staging_upload_buffer, subresource_memcpy_dests[mip_level].staging_upload_buffer_offset, subresource_memcpy_dests[mip_level].output_row_pitch, subresource_memcpy_dests[mip_level].output_row_count);
-                                                    }
-                                                }
-                                                else
-                                                {
-                                                    destination_asset_texture = NULL;
+                                                    Demo_Streaming_Texture import_task;
+                                                    import_task.m_input_stream_factory = import_image_asset_input_stream_factory;
+                                                    import_task.m_input_stream = import_image_asset_input_stream;
+                                                    import_task.m_pfn_import_image_asset_data_from_input_stream = pfn_import_image_asset_data_from_input_stream;
+
+                                                    bool const res_import_image_asset_header = pfn_import_image_asset_header_from_input_stream(import_image_asset_input_stream, &import_task.m_header, &import_task.m_data_offset);
+                                                    assert(res_import_image_asset_header);
+
+                                                    uint32_t const subresource_count = import_task.m_header.mip_levels;
+                                                    import_task.m_subresource_memcpy_dests.resize(subresource_count);
+
+                                                    // TODO: support more image paramters
+                                                    assert(!import_task.m_header.is_cube_map);
+                                                    assert(IMPORT_ASSET_IMAGE_TYPE_2D == import_task.m_header.type);
+                                                    assert(1U == import_task.m_header.depth);
+                                                    assert(1U == import_task.m_header.array_layers);
+                                                    uint32_t const total_bytes = brx_sampled_asset_image_import_calculate_subresource_memcpy_dests(import_task.m_header.format, import_task.m_header.width, import_task.m_header.height, 1U, import_task.m_header.mip_levels, 1U, 0U, staging_upload_buffer_offset_alignment, staging_upload_buffer_row_pitch_alignment, subresource_count, &import_task.m_subresource_memcpy_dests[0]);
+                                                    // allocated by "prepare_texture_streaming" (when there is enough free space in the staging upload ring) and freed after the upload has completed
+                                                    import_task.m_staging_upload_size = total_bytes;
+                                                    import_task.m_staging_upload_buffer = NULL;
+                                                    import_task.m_staging_upload_buffer_offset = 0U;
+                                                    import_task.m_staging_upload_ring_region_size = 0U;
+                                                    import_task.m_staging_upload_buffer_host_memory_range_base = NULL;
+
+                                                    // the image is created after the memory budget has been applied
+                                                    import_task.m_skipped_mip_level_count = 0U;
+                                                    import_task.m_image = NULL;
+
+                                                    import_task.m_decoded = false;
+
+                                                    mapped_textures.emplace(import_image_asset_file_name, static_cast<brx_sampled_asset_image *>(NULL));
+
+                                                    streaming_texture_file_names.push_back(import_image_asset_file_name);
+
+                                                    this->m_streaming_textures.push_back(std::move(import_task));
                                                 }
                                             }
                                         }
-                                        else
-                                        {
-                                            destination_asset_texture = NULL;
-                                        }
                                     }
                                 }
                             }
+                        }
+                    }
 
-                            out_mesh.m_instances.resize(total_mesh_data[mesh_index].m_instances.size());
+                    // drop the most detailed mips until the scene textures fit in the memory budget
+                    // the staging memory is only allocated for the resident mips
+                    {
+                        char const *const texture_memory_budget_string = getenv(texture_memory_budget_environment_variable_name);
+                        uint64_t const texture_memory_budget = (NULL != texture_memory_budget_string) ? (static_cast<uint64_t>(strtoull(texture_memory_budget_string, NULL, 10)) * 1024ULL * 1024ULL) : 0U;
 
-                            for (size_t instance_index = 0U; instance_index < total_mesh_data[mesh_index].m_instances.size(); ++instance_index)
-                            {
-                                scene_mesh_instance_data &in_instance_data = total_mesh_data[mesh_index].m_instances[instance_index];
+#ifndef NDEBUG
+                        // the resident size is only reported by the debug build
+                        uint64_t const texture_memory_size = apply_texture_memory_budget(texture_memory_budget, this->m_streaming_textures);
 
-                                Demo_Mesh_Instance &out_mesh_instance = out_mesh.m_instances[instance_index];
+                        if (0U != texture_memory_budget)
+                        {
+                            printf("Texture Memory Budget: %llu MiB, resident %.3f MiB\n", static_cast<unsigned long long>(texture_memory_budget / (1024ULL * 1024ULL)), static_cast<double>(texture_memory_size) / (1024.0 * 1024.0));
+                        }
+#else
+                        apply_texture_memory_budget(texture_memory_budget, this->m_streaming_textures);
+#endif
+                    }
 
-                                DirectX::XMStoreFloat4x4(&out_mesh_instance.m_model_transform, DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&in_instance_data.m_model_transform), DirectX::XMLoadFloat4x4(&root_transform)));
+                    assert(streaming_texture_file_names.size() == this->m_streaming_textures.size());
 
-                                out_mesh_instance.m_animation_skeleton = std::move(in_instance_data.m_animation_skeleton);
+                    this->m_scene_textures.reserve(this->m_streaming_textures.size());
+                    for (size_t streaming_texture_index = 0U; streaming_texture_index < this->m_streaming_textures.size(); ++streaming_texture_index)
+                    {
+                        Demo_Streaming_Texture &streaming_texture = this->m_streaming_textures[streaming_texture_index];
 
-                                if (!in_mesh_data.m_skinned)
-                                {
-                                    assert(out_mesh_instance.m_skinned_subsets.empty());
-                                }
-                                else
-                                {
-                                    out_mesh_instance.m_skinned_subsets.resize(in_mesh_data.m_subsets.size());
+                        drop_skipped_streaming_texture_mips(staging_upload_buffer_offset_alignment, staging_upload_buffer_row_pitch_alignment, &streaming_texture);
 
-                                    for (size_t subset_index = 0U; subset_index < in_mesh_data.m_subsets.size(); ++subset_index)
-                                    {
-                                        scene_mesh_subset_data const &in_subset_data = in_mesh_data.m_subsets[subset_index];
+                        streaming_texture.m_image = device->create_sampled_asset_image(streaming_texture.m_header.format, streaming_texture.m_header.width, streaming_texture.m_header.height, streaming_texture.m_header.mip_levels);
 
-                                        Demo_Mesh_Skinned_Subset &out_mesh_skinned_subset = out_mesh_instance.m_skinned_subsets[subset_index];
+                        mcrt_unordered_map<mcrt_string, brx_sampled_asset_image *>::iterator found = mapped_textures.find(streaming_texture_file_names[streaming_texture_index]);
+                        assert(mapped_textures.end() != found);
+                        assert(NULL == found->second);
+                        found->second = streaming_texture.m_image;
 
-                                        uint32_t const vertex_count = static_cast<uint32_t>(in_subset_data.m_vertex_position_binding.size());
+                        this->m_scene_textures.push_back(streaming_texture.m_image);
+                    }
 
-                                        uint32_t const vertex_position_buffer_size = sizeof(scene_mesh_vertex_position_binding) * vertex_count;
+                    // the textures are decoded while the geometry is uploaded and the acceleration structures are built
+                    this->m_texture_streaming_thread_context.m_streaming_texture_count = static_cast<uint32_t>(this->m_streaming_textures.size());
+                    this->m_texture_streaming_thread_context.m_streaming_textures = this->m_streaming_textures.data();
+                    this->m_texture_streaming_thread_context.m_prepared_count = 0U;
+                    this->m_texture_streaming_thread_context.m_stop = false;
+                    this->m_texture_streaming_thread_context.m_decoded_count.store(0U, std::memory_order_relaxed);
+                    this->m_texture_streaming_submitted_count = 0U;
+                    this->m_texture_streaming_retired_count = 0U;
+                    if (!this->m_streaming_textures.empty())
+                    {
+                        this->m_texture_streaming_staging_upload_ring.init(device, texture_streaming_staging_upload_ring_size);
 
-                                        out_mesh_skinned_subset.m_skinned_vertex_position_buffer = device->create_storage_intermediate_buffer(vertex_position_buffer_size);
+                        this->prepare_texture_streaming(device);
 
-                                        assert(vertex_count == in_subset_data.m_vertex_varying_binding.size());
+                        // the worker threads are kept alive until all textures have been decoded, rather than being created for each batch
+                        // "hardware_concurrency" may return zero when it is not computable, and the streaming thread is also used as a worker thread
+                        uint32_t const hardware_concurrency = std::max(1U, static_cast<uint32_t>(std::thread::hardware_concurrency()));
 
-                                        uint32_t const vertex_varying_buffer_size = sizeof(scene_mesh_vertex_varying_binding) * vertex_count;
+                        this->m_texture_streaming_thread_context.m_decode_worker_pool.init(std::min(hardware_concurrency, texture_streaming_batch_texture_count) - 1U);
 
-                                        out_mesh_skinned_subset.m_skinned_vertex_varying_buffer = device->create_storage_intermediate_buffer(vertex_varying_buffer_size);
-                                    }
-                                }
-                            }
-                        }
+                        this->m_texture_streaming_thread = std::thread(texture_streaming_thread_main, &this->m_texture_streaming_thread_context);
                     }
                 }
 
-                import_asset_destroy_memory_input_stream_factory(input_stream_factory);
-                input_stream_factory = NULL;
-
-                this->m_scene_textures.reserve(mapped_textures.size());
-                for (mcrt_unordered_map<mcrt_string, brx_sampled_asset_image *>::const_iterator material_texture_iterator = mapped_textures.begin(); material_texture_iterator != mapped_textures.end(); ++material_texture_iterator)
+                // the static meshes with the identical geometry and material bindings (repeated in the same file or shared across files) are collapsed into one mesh with several instances
+                // the skinned meshes are never collapsed (since each mesh is animated by its own skeleton)
+                load_arena_vector<load_arena_vector<uint32_t>> scene_mesh_indices(file_names.size(), load_arena_vector<uint32_t>(&load_arena), &load_arena);
+                load_arena_vector<uint32_t> scene_mesh_source_file_name_indices(&load_arena);
+                load_arena_vector<uint32_t> scene_mesh_source_mesh_indices(&load_arena);
                 {
-                    brx_sampled_asset_image *const material_texture = material_texture_iterator->second;
+                    mcrt_unordered_map<uint64_t, uint32_t> scene_mesh_content_hashes;
 
-                    assert(NULL != material_texture);
+                    mcrt_vector<brx_sampled_asset_image *> mesh_textures;
+                    mcrt_vector<brx_sampled_asset_image *> source_mesh_textures;
 
-                    this->m_scene_textures.push_back(material_texture);
-                }
-            }
+#ifndef NDEBUG
+                    // only reported by the debug build
+                    uint32_t deduplicated_mesh_count = 0U;
+#endif
 
-            // Place Holder Buffer
-            {
-                uint32_t const size = 1U;
+                    for (size_t file_name_index = 0U; file_name_index < file_names.size(); ++file_name_index)
+                    {
+                        scene_asset_import_result const &import_result = scene_asset_import_results[file_name_index];
 
-                this->m_place_holder_buffer = device->create_storage_asset_buffer(size);
+                        if (import_result.m_scene_loaded)
+                        {
+                            scene_mesh_indices[file_name_index].resize(import_result.m_cooked_mesh_data.size());
 
-                brx_staging_upload_buffer *const place_holder_buffer_staging_upload_buffer = device->create_staging_upload_buffer(size);
+                            for (size_t mesh_index = 0U; mesh_index < import_result.m_cooked_mesh_data.size(); ++mesh_index)
+                            {
+                                scene_cache_mesh const &in_mesh_data = import_result.m_cooked_mesh_data[mesh_index];
 
-                staging_upload_buffers.push_back(place_holder_buffer_staging_upload_buffer);
+                                uint32_t const new_scene_mesh_index = static_cast<uint32_t>(scene_mesh_source_file_name_indices.size());
 
-                std::memset(place_holder_buffer_staging_upload_buffer->get_host_memory_range_base(), 0, size);
+                                uint32_t scene_mesh_index = new_scene_mesh_index;
 
-                upload_command_buffer->upload_from_staging_upload_buffer_to_storage_asset_buffer(this->m_place_holder_buffer, 0U, place_holder_buffer_staging_upload_buffer, 0U, size);
-            }
+                                if (!in_mesh_data.m_skinned)
+                                {
+                                    find_scene_mesh_textures(mapped_textures, file_names[file_name_index], in_mesh_data, mesh_textures);
 
-            // Place Holder Texture
-            {
-                uint32_t const staging_upload_buffer_offset_alignment = device->get_staging_upload_buffer_offset_alignment();
-                uint32_t const staging_upload_buffer_row_pitch_alignment = device->get_staging_upload_buffer_row_pitch_alignment();
+                                    uint64_t const content_hash = compute_scene_mesh_content_hash(in_mesh_data, mesh_textures);
 
-                BRX_SAMPLED_ASSET_IMAGE_FORMAT const format = BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_UNORM;
-                uint32_t const width = 1U;
-                uint32_t const height = 1U;
-                uint32_t const mip_levels = 1U;
-                this->m_place_holder_texture = device->create_sampled_asset_image(format, width, height, mip_levels);
+                                    mcrt_unordered_map<uint64_t, uint32_t>::const_iterator found = scene_mesh_content_hashes.find(content_hash);
+                                    if (scene_mesh_content_hashes.end() != found)
+                                    {
+                                        uint32_t const source_file_name_index = scene_mesh_source_file_name_indices[found->second];
+                                        scene_cache_mesh const &source_mesh_data = scene_asset_import_results[source_file_name_index].m_cooked_mesh_data[scene_mesh_source_mesh_indices[found->second]];
 
-                mcrt_vector<BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST> subresource_memcpy_dests;
-                uint32_t const subresource_count = mip_levels;
-                subresource_memcpy_dests.resize(subresource_count);
+                                        find_scene_mesh_textures(mapped_textures, file_names[source_file_name_index], source_mesh_data, source_mesh_textures);
 
-                uint32_t const total_bytes = brx_sampled_asset_image_import_calculate_subresource_memcpy_dests(format, width, height, 1U, mip_levels, 1U, 0U, staging_upload_buffer_offset_alignment, staging_upload_buffer_row_pitch_alignment, subresource_count, &subresource_memcpy_dests[0]);
-                brx_staging_upload_buffer *place_holder_image_staging_upload_buffer = device->create_staging_upload_buffer(total_bytes);
+                                        // the meshes are NOT collapsed when the hash collides
+                                        if (is_scene_mesh_content_equal(in_mesh_data, mesh_textures, source_mesh_data, source_mesh_textures))
+                                        {
+                                            scene_mesh_index = found->second;
+                                        }
+                                    }
+                                    else
+                                    {
+                                        scene_mesh_content_hashes.emplace(content_hash, new_scene_mesh_index);
+                                    }
+                                }
 
-                staging_upload_buffers.push_back(place_holder_image_staging_upload_buffer);
+                                if (new_scene_mesh_index == scene_mesh_index)
+                                {
+                                    scene_mesh_source_file_name_indices.push_back(static_cast<uint32_t>(file_name_index));
+                                    scene_mesh_source_mesh_indices.push_back(static_cast<uint32_t>(mesh_index));
+                                }
+#ifndef NDEBUG
+                                else
+                                {
+                                    ++deduplicated_mesh_count;
+                                }
+#endif
 
-                uint32_t const mip_level = 0U;
-                uint32_t const subresource_index = brx_sampled_asset_image_import_calculate_subresource_index(mip_level, 0U, 0U, mip_levels, 1U);
-                for (uint32_t output_slice_index = 0U; output_slice_index < subresource_memcpy_dests[mip_level].output_slice_count; ++output_slice_index)
-                {
-                    for (uint32_t output_row_index = 0U; output_row_index < subresource_memcpy_dests[mip_level].output_row_count; ++output_row_index)
-                    {
-                        void *destination = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(place_holder_image_staging_upload_buffer->get_host_memory_range_base()) + (subresource_memcpy_dests[subresource_index].staging_upload_buffer_offset + subresource_memcpy_dests[subresource_index].output_slice_pitch * output_slice_index + subresource_memcpy_dests[subresource_index].output_row_pitch * output_row_index));
+                                scene_mesh_indices[file_name_index][mesh_index] = scene_mesh_index;
+                            }
+                        }
+                    }
 
-                        std::memset(destination, 0, subresource_memcpy_dests[mip_level].output_row_size);
+#ifndef NDEBUG
+                    if (deduplicated_mesh_count > 0U)
+                    {
+                        printf("Scene Meshes: %u identical meshes collapsed into the instances of %u meshes\n", static_cast<unsigned>(deduplicated_mesh_count), static_cast<unsigned>(scene_mesh_source_file_name_indices.size()));
                     }
+#endif
                 }
 
-                upload_command_buffer->upload_from_staging_upload_buffer_to_sampled_asset_image(this->m_place_holder_texture, format, width, height, mip_level, place_holder_image_staging_upload_buffer, subresource_memcpy_dests[mip_level].staging_upload_buffer_offset, subresource_memcpy_dests[mip_level].output_row_pitch, subresource_memcpy_dests[mip_level].output_row_count);
-            }
-
-            // build staging non compacted bottom level acceleration structure
-            // release
-            // acquire
-            {
-                // build staging non compacted bottom level acceleration structure
+                // the stress mode replicates each instance of the loaded scenes on a grid
+                // the number of the copies is clamped by the limits (rather than asserted), and the limits are reported
+                load_arena_vector<DirectX::XMFLOAT4X4> stress_replica_transforms(&load_arena);
+                load_arena_vector<uint32_t> stress_replica_animation_frame_offsets(&load_arena);
                 {
-                    mcrt_vector<brx_acceleration_structure_build_input_read_only_buffer const *> non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers;
-                    uint32_t scene_non_compacted_bottom_level_acceleration_structure_count = 0U;
-                    for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+                    char const *const stress_replication_count_string = getenv(stress_replication_count_environment_variable_name);
+                    uint32_t const requested_stress_replication_count = (NULL != stress_replication_count_string) ? std::max(1U, static_cast<uint32_t>(strtoul(stress_replication_count_string, NULL, 10))) : 1U;
+
+                    // the instances and the bindless buffers which are used by each copy
+                    uint64_t copy_instance_count = 0U;
+                    uint64_t copy_bindless_buffer_count = 0U;
+                    // the bindless buffers which are shared by all copies (the geometry pool buffer, the index buffers and the vertex position buffers of the static meshes)
+                    uint64_t shared_bindless_buffer_count = 1U;
+                    for (size_t file_name_index = 0U; file_name_index < file_names.size(); ++file_name_index)
                     {
-                        Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+                        scene_asset_import_result const &import_result = scene_asset_import_results[file_name_index];
 
-                        if (!scene_mesh.m_skinned)
+                        if (import_result.m_scene_loaded)
                         {
-                            for (size_t subset_index = 0U; subset_index < scene_mesh.m_subsets.size(); ++subset_index)
+                            for (size_t mesh_index = 0U; mesh_index < import_result.m_cooked_mesh_data.size(); ++mesh_index)
                             {
-                                Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[subset_index];
+                                scene_cache_mesh const &in_mesh_data = import_result.m_cooked_mesh_data[mesh_index];
 
-                                non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.push_back(scene_mesh_subset.m_vertex_position_buffer->get_acceleration_structure_build_input_read_only_buffer());
+                                copy_instance_count += in_mesh_data.m_instance_model_transforms.size();
 
-                                non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.push_back(scene_mesh_subset.m_index_buffer->get_acceleration_structure_build_input_read_only_buffer());
+                                if (in_mesh_data.m_skinned)
+                                {
+                                    copy_bindless_buffer_count += 2U * in_mesh_data.m_subsets.size() * in_mesh_data.m_instance_model_transforms.size();
+                                }
                             }
-
-                            ++scene_non_compacted_bottom_level_acceleration_structure_count;
                         }
                     }
-
-                    if (scene_non_compacted_bottom_level_acceleration_structure_count > 0U)
+                    for (size_t scene_mesh_index = 0U; scene_mesh_index < scene_mesh_source_file_name_indices.size(); ++scene_mesh_index)
                     {
-                        upload_command_buffer->build_non_compacted_bottom_level_acceleration_structure_pass_load(static_cast<uint32_t>(non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.size()), non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.data());
+                        scene_cache_mesh const &in_mesh_data = scene_asset_import_results[scene_mesh_source_file_name_indices[scene_mesh_index]].m_cooked_mesh_data[scene_mesh_source_mesh_indices[scene_mesh_index]];
 
-                        assert(NULL == compacted_bottom_level_acceleration_structure_size_query_pool);
-                        compacted_bottom_level_acceleration_structure_size_query_pool = device->create_compacted_bottom_level_acceleration_structure_size_query_pool(scene_non_compacted_bottom_level_acceleration_structure_count);
+                        shared_bindless_buffer_count += (in_mesh_data.m_skinned ? 1U : 2U) * in_mesh_data.m_subsets.size();
+                    }
 
-                        scene_non_compacted_bottom_level_acceleration_structures.resize(scene_non_compacted_bottom_level_acceleration_structure_count);
+                    uint32_t stress_replication_count = requested_stress_replication_count;
 
-                        uint32_t non_compacted_bottom_level_acceleration_structure_index = 0U;
-                        for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
-                        {
-                            Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
-
-                            if (!scene_mesh.m_skinned)
-                            {
-                                mcrt_vector<BRX_BOTTOM_LEVEL_ACCELERATION_STRUCTURE_GEOMETRY> bottom_level_acceleration_structure_geometries(scene_mesh.m_subsets.size());
+                    if ((copy_instance_count > 0U) && ((copy_instance_count * stress_replication_count) > MAX_INSTANCE_COUNT))
+                    {
+                        stress_replication_count = static_cast<uint32_t>(MAX_INSTANCE_COUNT / copy_instance_count);
+                        printf("Stress Replication: clamped to %u copies by MAX_INSTANCE_COUNT %u (%llu instances per copy)\n", static_cast<unsigned>(stress_replication_count), static_cast<unsigned>(MAX_INSTANCE_COUNT), static_cast<unsigned long long>(copy_instance_count));
+                    }
 
-                                for (size_t subset_index = 0U; subset_index < scene_mesh.m_subsets.size(); ++subset_index)
-                                {
-                                    Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[subset_index];
+                    if ((copy_bindless_buffer_count > 0U) && ((shared_bindless_buffer_count + copy_bindless_buffer_count * stress_replication_count) > MAX_MESH_SUBSET_BUFFER_COUNT))
+                    {
+                        stress_replication_count = (shared_bindless_buffer_count < MAX_MESH_SUBSET_BUFFER_COUNT) ? static_cast<uint32_t>((MAX_MESH_SUBSET_BUFFER_COUNT - shared_bindless_buffer_count) / copy_bindless_buffer_count) : 0U;
+                        printf("Stress Replication: clamped to %u copies by MAX_MESH_SUBSET_BUFFER_COUNT %u (%llu shared bindless buffers, %llu bindless buffers per copy)\n", static_cast<unsigned>(stress_replication_count), static_cast<unsigned>(MAX_MESH_SUBSET_BUFFER_COUNT), static_cast<unsigned long long>(shared_bindless_buffer_count), static_cast<unsigned long long>(copy_bindless_buffer_count));
+                    }
 
-                                    bottom_level_acceleration_structure_geometries[subset_index] = BRX_BOTTOM_LEVEL_ACCELERATION_STRUCTURE_GEOMETRY{true,
-                                                                                                                                                    BRX_GRAPHICS_PIPELINE_VERTEX_ATTRIBUTE_FORMAT_R32G32B32_SFLOAT,
-                                                                                                                                                    sizeof(scene_mesh_vertex_position_binding),
-                                                                                                                                                    scene_mesh_subset.m_vertex_count,
-                                                                                                                                                    scene_mesh_subset.m_vertex_position_buffer->get_acceleration_structure_build_input_read_only_buffer(),
-                                                                                                                                                    scene_mesh_subset.m_index_type,
-                                                                                                                                                    scene_mesh_subset.m_index_count,
-                                                                                                                                                    scene_mesh_subset.m_index_buffer->get_acceleration_structure_build_input_read_only_buffer()};
-                                }
+                    // the loaded scenes are always kept
+                    stress_replication_count = std::max(1U, stress_replication_count);
 
-                                uint32_t non_compacted_bottom_level_acceleration_structure_size = -1;
-                                uint32_t non_compacted_bottom_level_acceleration_structure_build_scratch_size = -1;
-                                device->get_non_compacted_bottom_level_acceleration_structure_size(static_cast<uint32_t>(bottom_level_acceleration_structure_geometries.size()), bottom_level_acceleration_structure_geometries.data(), &non_compacted_bottom_level_acceleration_structure_size, &non_compacted_bottom_level_acceleration_structure_build_scratch_size);
+                    this->m_stress_replication_count = stress_replication_count;
+                    this->m_stress_report_enabled = (NULL != stress_replication_count_string);
 
-                                scene_non_compacted_bottom_level_acceleration_structures[non_compacted_bottom_level_acceleration_structure_index] = device->create_non_compacted_bottom_level_acceleration_structure(non_compacted_bottom_level_acceleration_structure_size);
+                    if (this->m_stress_report_enabled)
+                    {
+                        printf("Stress Replication: %u copies, %llu instances (MAX_INSTANCE_COUNT %u), %llu bindless buffers (MAX_MESH_SUBSET_BUFFER_COUNT %u)\n", static_cast<unsigned>(stress_replication_count), static_cast<unsigned long long>(copy_instance_count * stress_replication_count), static_cast<unsigned>(MAX_INSTANCE_COUNT), static_cast<unsigned long long>(shared_bindless_buffer_count + copy_bindless_buffer_count * stress_replication_count), static_cast<unsigned>(MAX_MESH_SUBSET_BUFFER_COUNT));
+                    }
 
-                                brx_scratch_buffer *const non_compacted_bottom_level_acceleration_structure_build_scratch_buffer = device->create_scratch_buffer(non_compacted_bottom_level_acceleration_structure_build_scratch_size);
-                                scratch_buffers.push_back(non_compacted_bottom_level_acceleration_structure_build_scratch_buffer);
+                    // the copy "0" is the loaded scenes, and the other copies are placed on the grid with the random rotations
+                    // the seed is fixed to make the benchmark reproducible
+                    std::minstd_rand random_engine(5489U);
+                    std::uniform_real_distribution<float> random_rotation_distribution(0.0F, DirectX::XM_2PI);
+                    std::uniform_int_distribution<uint32_t> random_animation_frame_offset_distribution(0U, stress_replication_max_animation_frame_offset - 1U);
 
-                                upload_command_buffer->build_non_compacted_bottom_level_acceleration_structure(scene_non_compacted_bottom_level_acceleration_structures[non_compacted_bottom_level_acceleration_structure_index], static_cast<uint32_t>(bottom_level_acceleration_structure_geometries.size()), bottom_level_acceleration_structure_geometries.data(), non_compacted_bottom_level_acceleration_structure_build_scratch_buffer, compacted_bottom_level_acceleration_structure_size_query_pool, non_compacted_bottom_level_acceleration_structure_index);
+                    uint32_t const grid_width = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(stress_replication_count))));
 
-                                ++non_compacted_bottom_level_acceleration_structure_index;
-                            }
+                    stress_replica_transforms.resize(stress_replication_count);
+                    stress_replica_animation_frame_offsets.resize(stress_replication_count);
+                    for (uint32_t replica_index = 0U; replica_index < stress_replication_count; ++replica_index)
+                    {
+                        if (0U == replica_index)
+                        {
+                            DirectX::XMStoreFloat4x4(&stress_replica_transforms[replica_index], DirectX::XMMatrixIdentity());
+                            stress_replica_animation_frame_offsets[replica_index] = 0U;
+                        }
+                        else
+                        {
+                            float const grid_x = stress_replication_grid_spacing * static_cast<float>(replica_index % grid_width);
+                            float const grid_z = stress_replication_grid_spacing * static_cast<float>(replica_index / grid_width);
+                            DirectX::XMStoreFloat4x4(&stress_replica_transforms[replica_index], DirectX::XMMatrixMultiply(DirectX::XMMatrixRotationY(random_rotation_distribution(random_engine)), DirectX::XMMatrixTranslation(grid_x, 0.0F, grid_z)));
+                            stress_replica_animation_frame_offsets[replica_index] = random_animation_frame_offset_distribution(random_engine);
                         }
-                        assert(scene_non_compacted_bottom_level_acceleration_structures.size() == non_compacted_bottom_level_acceleration_structure_index);
-
-                        upload_command_buffer->build_non_compacted_bottom_level_acceleration_structure_pass_store(static_cast<uint32_t>(non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.size()), non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.data());
                     }
                 }
 
-                mcrt_vector<brx_storage_asset_buffer const *> uploaded_storage_asset_buffers;
-                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+                // the vertex varying of the static mesh subsets and the information of all mesh subsets are packed into the geometry pool buffer
+                uint32_t geometry_pool_size = 0U;
+                for (size_t scene_mesh_index = 0U; scene_mesh_index < scene_mesh_source_file_name_indices.size(); ++scene_mesh_index)
                 {
-                    Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+                    scene_cache_mesh const &in_mesh_data = scene_asset_import_results[scene_mesh_source_file_name_indices[scene_mesh_index]].m_cooked_mesh_data[scene_mesh_source_mesh_indices[scene_mesh_index]];
 
-                    for (size_t subset_index = 0U; subset_index < scene_mesh.m_subsets.size(); ++subset_index)
+                    for (size_t subset_index = 0U; subset_index < in_mesh_data.m_subsets.size(); ++subset_index)
                     {
-                        Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[subset_index];
+                        scene_cache_mesh_subset const &in_subset_data = in_mesh_data.m_subsets[subset_index];
 
-                        uploaded_storage_asset_buffers.push_back(scene_mesh_subset.m_vertex_position_buffer);
-
-                        uploaded_storage_asset_buffers.push_back(scene_mesh_subset.m_vertex_varying_buffer);
-
-                        if (!scene_mesh.m_skinned)
+                        if (!in_mesh_data.m_skinned)
                         {
-                            assert(NULL == scene_mesh_subset.m_vertex_joint_buffer);
-                        }
-                        else
-                        {
-                            uploaded_storage_asset_buffers.push_back(scene_mesh_subset.m_vertex_joint_buffer);
+                            geometry_pool_size = tbb_align_up(geometry_pool_size, geometry_pool_alignment) + in_subset_data.m_buffer_sizes[GEOMETRY_POOL_VERTEX_VARYING_BUFFER_INDEX];
                         }
 
-                        uploaded_storage_asset_buffers.push_back(scene_mesh_subset.m_index_buffer);
-
-                        uploaded_storage_asset_buffers.push_back(scene_mesh_subset.m_information_buffer);
+                        geometry_pool_size = tbb_align_up(geometry_pool_size, geometry_pool_alignment) + in_subset_data.m_buffer_sizes[GEOMETRY_POOL_INFORMATION_BUFFER_INDEX];
                     }
                 }
 
-                // Place Holder Texture
+                brx_staging_upload_buffer *geometry_pool_staging_upload_buffer = NULL;
+                uint32_t geometry_pool_staging_upload_buffer_offset = 0U;
+                void *geometry_pool_staging_upload_buffer_host_memory = NULL;
+                if (geometry_pool_size > 0U)
                 {
-                    uploaded_storage_asset_buffers.push_back(this->m_place_holder_buffer);
-                }
+                    this->m_geometry_pool_buffer = device->create_storage_asset_buffer(geometry_pool_size);
 
-                mcrt_vector<brx_sampled_asset_image const *> uploaded_sampled_asset_images;
-                mcrt_vector<uint32_t> uploaded_destination_mip_levels;
-                for (mcrt_vector<brx_sampled_asset_image *>::const_iterator material_texture_iterator = this->m_scene_textures.begin(); material_texture_iterator != this->m_scene_textures.end(); ++material_texture_iterator)
+                    staging_upload_arena.allocate(device, geometry_pool_size, &geometry_pool_staging_upload_buffer, &geometry_pool_staging_upload_buffer_offset, &geometry_pool_staging_upload_buffer_host_memory);
+                }
+                else
                 {
-                    brx_sampled_asset_image *const material_texture = (*material_texture_iterator);
+                    this->m_geometry_pool_buffer = NULL;
+                }
+
+                uint32_t geometry_pool_allocated_size = 0U;
 
-                    assert(NULL != material_texture);
+                assert(this->m_scene_meshes.empty());
+                this->m_scene_meshes.resize(scene_mesh_source_file_name_indices.size());
+
+                // record the uploads on this thread
+                for (size_t file_name_index = 0U; file_name_index < file_names.size(); ++file_name_index)
+                {
+                    mcrt_string const &file_name = file_names[file_name_index];
+                    DirectX::XMFLOAT4X4 const &root_transform = root_transforms[file_name_index];
 
-                    uint32_t const mip_level_count = material_texture->get_mip_levels();
+                    scene_asset_import_result &import_result = scene_asset_import_results[file_name_index];
 
-                    for (uint32_t mip_level = 0U; mip_level < mip_level_count; ++mip_level)
+                    if (import_result.m_scene_loaded)
                     {
-                        uploaded_sampled_asset_images.push_back(material_texture);
+                        for (size_t mesh_index = 0U; mesh_index < import_result.m_cooked_mesh_data.size(); ++mesh_index)
+                        {
+                            scene_cache_mesh const &in_mesh_data = import_result.m_cooked_mesh_data[mesh_index];
 
-                        uploaded_destination_mip_levels.push_back(mip_level);
-                    }
-                }
+                            uint32_t const scene_mesh_index = scene_mesh_indices[file_name_index][mesh_index];
 
-                // Place Holder Texture
-                {
-                    uploaded_sampled_asset_images.push_back(this->m_place_holder_texture);
+                            Demo_Mesh &out_mesh = this->m_scene_meshes[scene_mesh_index];
 
-                    uploaded_destination_mip_levels.push_back(0U);
-                }
+                            // the subsets are only uploaded once, and the identical meshes only append their instances
+                            if ((scene_mesh_source_file_name_indices[scene_mesh_index] == file_name_index) && (scene_mesh_source_mesh_indices[scene_mesh_index] == mesh_index))
+                            {
+                                out_mesh.m_skinned = in_mesh_data.m_skinned;
 
-                assert(uploaded_sampled_asset_images.size() == uploaded_destination_mip_levels.size());
+                                out_mesh.m_subsets.resize(in_mesh_data.m_subsets.size());
 
-                // release
-                upload_command_buffer->release(static_cast<uint32_t>(uploaded_storage_asset_buffers.size()), uploaded_storage_asset_buffers.data(), static_cast<uint32_t>(uploaded_sampled_asset_images.size()), &uploaded_sampled_asset_images[0], uploaded_destination_mip_levels.data(), 0U, NULL);
+                                for (size_t subset_index = 0U; subset_index < in_mesh_data.m_subsets.size(); ++subset_index)
+                                {
+                                    scene_cache_mesh_subset const &in_subset_data = in_mesh_data.m_subsets[subset_index];
 
-                // acquire
-                graphics_command_buffer->acquire(static_cast<uint32_t>(uploaded_storage_asset_buffers.size()), uploaded_storage_asset_buffers.data(), static_cast<uint32_t>(uploaded_sampled_asset_images.size()), &uploaded_sampled_asset_images[0], uploaded_destination_mip_levels.data(), 0U, NULL);
-            }
+                                    Demo_Mesh_Subset &out_subset = out_mesh.m_subsets[subset_index];
 
-            upload_command_buffer->end();
+                                    // Buffer
+                                    {
+                                        static constexpr uint32_t const DEMO_MESH_SUBSET_ASSET_BUFFER_COUNT = SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT;
 
-            graphics_command_buffer->end();
+                                        out_subset.m_vertex_count = in_subset_data.m_vertex_count;
 
-            upload_queue->submit_and_signal(upload_command_buffer);
+                                        out_subset.m_index_count = in_subset_data.m_index_count;
 
-            device->reset_fence(fence);
+                                        out_subset.m_index_type = in_subset_data.m_index_type_uint16 ? BRX_GRAPHICS_PIPELINE_INDEX_TYPE_UINT16 : BRX_GRAPHICS_PIPELINE_INDEX_TYPE_UINT32;
 
-            graphics_queue->wait_and_submit(upload_command_buffer, graphics_command_buffer, fence);
+                                        // NULL when the buffer is sub-allocated from the geometry pool buffer
+                                        brx_storage_asset_buffer *geometry_pool_asset_buffer = NULL;
 
-            device->wait_for_fence(fence);
+                                        uint32_t *const geometry_pool_offsets[DEMO_MESH_SUBSET_ASSET_BUFFER_COUNT] = {
+                                            NULL,
+                                            NULL,
+                                            (!in_mesh_data.m_skinned) ? (&out_subset.m_vertex_varying_geometry_pool_offset) : NULL,
+                                            NULL,
+                                            NULL,
+                                            &out_subset.m_information_geometry_pool_offset};
 
-            for (brx_staging_upload_buffer *const staging_upload_buffer : staging_upload_buffers)
-            {
-                device->destroy_staging_upload_buffer(staging_upload_buffer);
-            }
+                                        brx_storage_asset_buffer **const destination_asset_buffers[DEMO_MESH_SUBSET_ASSET_BUFFER_COUNT] = {
+                                            &out_subset.m_vertex_position_buffer,
+                                            &out_subset.m_acceleration_structure_build_input_vertex_position_buffer,
+                                            (!in_mesh_data.m_skinned) ? (&geometry_pool_asset_buffer) : (&out_subset.m_vertex_varying_buffer),
+                                            &out_subset.m_vertex_joint_buffer,
+                                            &out_subset.m_index_buffer,
+                                            &geometry_pool_asset_buffer};
 
-            staging_upload_buffers.clear();
+                                        out_subset.m_vertex_varying_buffer = NULL;
+                                        out_subset.m_vertex_varying_geometry_pool_offset = 0U;
+                                        out_subset.m_information_geometry_pool_offset = 0U;
 
-            for (brx_scratch_buffer *const scratch_buffer : scratch_buffers)
-            {
-                device->destroy_scratch_buffer(scratch_buffer);
-            }
+                                        for (uint32_t mesh_subset_asset_buffer_index = 0U; mesh_subset_asset_buffer_index < DEMO_MESH_SUBSET_ASSET_BUFFER_COUNT; ++mesh_subset_asset_buffer_index)
+                                        {
+                                            brx_storage_asset_buffer *&destination_asset_buffer = (*destination_asset_buffers[mesh_subset_asset_buffer_index]);
 
-            scratch_buffers.clear();
-        }
+                                            if (NULL != geometry_pool_offsets[mesh_subset_asset_buffer_index])
+                                            {
+                                                assert(NULL != in_subset_data.m_buffers[mesh_subset_asset_buffer_index]);
 
-        // step 2
-        // compact bottom level acceleration structure
-        // build top level acceleration structure
-        {
-            mcrt_vector<brx_scratch_buffer *> scratch_buffers;
+                                                uint32_t const asset_buffer_size = in_subset_data.m_buffer_sizes[mesh_subset_asset_buffer_index];
 
-            device->reset_upload_command_buffer(upload_command_buffer);
+                                                uint32_t const geometry_pool_offset = tbb_align_up(geometry_pool_allocated_size, geometry_pool_alignment);
+                                                geometry_pool_allocated_size = geometry_pool_offset + asset_buffer_size;
+                                                assert(geometry_pool_allocated_size <= geometry_pool_size);
 
-            device->reset_graphics_command_buffer(graphics_command_buffer);
+                                                std::memcpy(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(geometry_pool_staging_upload_buffer_host_memory) + geometry_pool_offset), in_subset_data.m_buffers[mesh_subset_asset_buffer_index], asset_buffer_size);
 
-            upload_command_buffer->begin();
+                                                (*geometry_pool_offsets[mesh_subset_asset_buffer_index]) = geometry_pool_offset;
 
-            graphics_command_buffer->begin();
+                                                destination_asset_buffer = NULL;
+                                            }
+                                            else if (NULL != in_subset_data.m_buffers[mesh_subset_asset_buffer_index])
+                                            {
+                                                uint32_t const asset_buffer_size = in_subset_data.m_buffer_sizes[mesh_subset_asset_buffer_index];
 
-            // compact bottom level acceleration structure
-            {
-                mcrt_vector<brx_compacted_bottom_level_acceleration_structure *> uploaded_compacted_bottom_level_acceleration_structures(static_cast<size_t>(scene_non_compacted_bottom_level_acceleration_structures.size()));
+                                                destination_asset_buffer = device->create_storage_asset_buffer(asset_buffer_size);
 
-                uint32_t non_compacted_bottom_level_acceleration_structure_index = 0U;
-                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
-                {
-                    Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+                                                brx_staging_upload_buffer *asset_buffer_staging_upload_buffer;
+                                                uint32_t asset_buffer_staging_upload_buffer_offset;
+                                                void *asset_buffer_staging_upload_buffer_host_memory;
+                                                staging_upload_arena.allocate(device, asset_buffer_size, &asset_buffer_staging_upload_buffer, &asset_buffer_staging_upload_buffer_offset, &asset_buffer_staging_upload_buffer_host_memory);
 
-                    if (!scene_mesh.m_skinned)
-                    {
-                        uint32_t const compacted_bottom_level_acceleration_structure_size = device->get_compacted_bottom_level_acceleration_structure_size_query_pool_result(compacted_bottom_level_acceleration_structure_size_query_pool, non_compacted_bottom_level_acceleration_structure_index);
+                                                std::memcpy(asset_buffer_staging_upload_buffer_host_memory, in_subset_data.m_buffers[mesh_subset_asset_buffer_index], asset_buffer_size);
 
-                        scene_mesh.m_compacted_bottom_level_acceleration_structure = device->create_compacted_bottom_level_acceleration_structure(compacted_bottom_level_acceleration_structure_size);
-                        uploaded_compacted_bottom_level_acceleration_structures[non_compacted_bottom_level_acceleration_structure_index] = scene_mesh.m_compacted_bottom_level_acceleration_structure;
+                                                upload_command_buffer->upload_from_staging_upload_buffer_to_storage_asset_buffer(destination_asset_buffer, 0U, asset_buffer_staging_upload_buffer, asset_buffer_staging_upload_buffer_offset, asset_buffer_size);
+                                            }
+                                            else
+                                            {
+                                                assert(0U == in_subset_data.m_buffer_sizes[mesh_subset_asset_buffer_index]);
 
-                        upload_command_buffer->compact_bottom_level_acceleration_structure(scene_mesh.m_compacted_bottom_level_acceleration_structure, scene_non_compacted_bottom_level_acceleration_structures[non_compacted_bottom_level_acceleration_structure_index]);
+                                                destination_asset_buffer = NULL;
+                                            }
+                                        }
+                                    }
 
-                        ++non_compacted_bottom_level_acceleration_structure_index;
-                    }
-                    else
-                    {
-                        scene_mesh.m_compacted_bottom_level_acceleration_structure = NULL;
-                    }
-                }
-                assert(scene_non_compacted_bottom_level_acceleration_structures.size() == non_compacted_bottom_level_acceleration_structure_index);
-                assert(uploaded_compacted_bottom_level_acceleration_structures.size() == non_compacted_bottom_level_acceleration_structure_index);
+                                    // Texture
+                                    {
+                                        static constexpr uint32_t const DEMO_MESH_SUBSET_ASSET_TEXTURE_COUNT = SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT;
 
-                // release
-                upload_command_buffer->release(0U, NULL, 0U, NULL, NULL, static_cast<uint32_t>(uploaded_compacted_bottom_level_acceleration_structures.size()), uploaded_compacted_bottom_level_acceleration_structures.data());
+                                        brx_sampled_asset_image **const destination_asset_textures[DEMO_MESH_SUBSET_ASSET_TEXTURE_COUNT] = {
+                                            &out_subset.m_normal_texture,
+                                            &out_subset.m_emissive_texture,
+                                            &out_subset.m_base_color_texture,
+                                            &out_subset.m_metallic_roughness_texture};
 
-                // acquire
-                graphics_command_buffer->acquire(0U, NULL, 0U, NULL, NULL, static_cast<uint32_t>(uploaded_compacted_bottom_level_acceleration_structures.size()), uploaded_compacted_bottom_level_acceleration_structures.data());
-            }
+                                        for (uint32_t mesh_subset_asset_texture_index = 0U; mesh_subset_asset_texture_index < DEMO_MESH_SUBSET_ASSET_TEXTURE_COUNT; ++mesh_subset_asset_texture_index)
+                                        {
+                                            mcrt_string const &asset_texture_image_uri = in_subset_data.m_texture_image_uris[mesh_subset_asset_texture_index];
 
-            // build intermediate bottom level acceleration structure
-            {
-                mcrt_vector<brx_intermediate_bottom_level_acceleration_structure *> built_intermediate_bottom_level_acceleration_structures;
+                                            brx_sampled_asset_image *&destination_asset_texture = (*destination_asset_textures[mesh_subset_asset_texture_index]);
 
-                uint32_t intermediate_bottom_level_acceleration_structure_index = 0U;
-                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
-                {
-                    Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+                                            if (!asset_texture_image_uri.empty())
+                                            {
+                                                destination_asset_texture = find_scene_texture(mapped_textures, file_name, asset_texture_image_uri);
+                                            }
+                                            else
+                                            {
+                                                destination_asset_texture = NULL;
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                            else
+                            {
+                                assert(!in_mesh_data.m_skinned);
+                                assert(!out_mesh.m_skinned);
+                                assert(out_mesh.m_subsets.size() == in_mesh_data.m_subsets.size());
+                            }
 
-                    if (!scene_mesh.m_skinned)
-                    {
-                        for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                        {
-                            Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+                            size_t const instance_index_offset = out_mesh.m_instances.size();
 
-                            assert(scene_mesh_instance.m_skinned_subsets.empty());
+                            uint32_t const stress_replication_count = static_cast<uint32_t>(stress_replica_transforms.size());
 
-                            scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure = NULL;
+                            out_mesh.m_instances.resize(instance_index_offset + in_mesh_data.m_instance_model_transforms.size() * stress_replication_count);
 
-                            scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer = NULL;
-                        }
-                    }
-                    else
-                    {
-                        for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                        {
-                            Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+                            for (size_t instance_index = 0U; instance_index < in_mesh_data.m_instance_model_transforms.size(); ++instance_index)
+                            {
+                                for (uint32_t replica_index = 0U; replica_index < stress_replication_count; ++replica_index)
+                                {
+                                    Demo_Mesh_Instance &out_mesh_instance = out_mesh.m_instances[instance_index_offset + stress_replication_count * instance_index + replica_index];
 
-                            assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
+                                    DirectX::XMStoreFloat4x4(&out_mesh_instance.m_model_transform, DirectX::XMMatrixMultiply(DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&in_mesh_data.m_instance_model_transforms[instance_index]), DirectX::XMLoadFloat4x4(&root_transform)), DirectX::XMLoadFloat4x4(&stress_replica_transforms[replica_index])));
 
-                            mcrt_vector<BRX_BOTTOM_LEVEL_ACCELERATION_STRUCTURE_GEOMETRY> bottom_level_acceleration_structure_geometries(scene_mesh_instance.m_skinned_subsets.size());
+                                    out_mesh_instance.m_animation_frame_offset = stress_replica_animation_frame_offsets[replica_index];
 
-                            for (size_t mesh_subset_index = 0U; mesh_subset_index < scene_mesh_instance.m_skinned_subsets.size(); ++mesh_subset_index)
-                            {
-                                Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[mesh_subset_index];
+                                    if (!in_mesh_data.m_skinned)
+                                    {
+                                        assert(out_mesh_instance.m_skinned_subsets.empty());
+                                    }
+                                    else
+                                    {
+                                        // the skinned meshes are never read from the scene cache
+                                        assert(!import_result.m_scene_cache_hit);
 
-                                bottom_level_acceleration_structure_geometries[mesh_subset_index] = BRX_BOTTOM_LEVEL_ACCELERATION_STRUCTURE_GEOMETRY{true,
-                                                                                                                                                     BRX_GRAPHICS_PIPELINE_VERTEX_ATTRIBUTE_FORMAT_R32G32B32_SFLOAT,
-                                                                                                                                                     sizeof(scene_mesh_vertex_position_binding),
-                                                                                                                                                     scene_mesh_subset.m_vertex_count,
-                                                                                                                                                     scene_mesh_subset.m_vertex_position_buffer->get_acceleration_structure_build_input_read_only_buffer(),
-                                                                                                                                                     scene_mesh_subset.m_index_type,
-                                                                                                                                                     scene_mesh_subset.m_index_count,
-                                                                                                                                                     scene_mesh_subset.m_index_buffer->get_acceleration_structure_build_input_read_only_buffer()};
-                            }
+                                        // the skeleton is copied by the replicas and moved by the last one
+                                        if ((replica_index + 1U) < stress_replication_count)
+                                        {
+                                            out_mesh_instance.m_animation_skeleton = import_result.m_mesh_data[mesh_index].m_instances[instance_index].m_animation_skeleton;
+                                        }
+                                        else
+                                        {
+                                            out_mesh_instance.m_animation_skeleton = std::move(import_result.m_mesh_data[mesh_index].m_instances[instance_index].m_animation_skeleton);
+                                        }
 
-                            uint32_t intermediate_bottom_level_acceleration_structure_size = -1;
-                            uint32_t intermediate_bottom_level_acceleration_structure_build_scratch_size = -1;
-                            uint32_t intermediate_bottom_level_acceleration_structure_update_scratch_size = -1;
-                            device->get_intermediate_bottom_level_acceleration_structure_size(static_cast<uint32_t>(bottom_level_acceleration_structure_geometries.size()), bottom_level_acceleration_structure_geometries.data(), &intermediate_bottom_level_acceleration_structure_size, &intermediate_bottom_level_acceleration_structure_build_scratch_size, &intermediate_bottom_level_acceleration_structure_update_scratch_size);
+                                        out_mesh_instance.m_skinned_subsets.resize(in_mesh_data.m_subsets.size());
 
-                            scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure = device->create_intermediate_bottom_level_acceleration_structure(intermediate_bottom_level_acceleration_structure_size);
-                            built_intermediate_bottom_level_acceleration_structures.push_back(scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+                                        for (size_t subset_index = 0U; subset_index < in_mesh_data.m_subsets.size(); ++subset_index)
+                                        {
+                                            scene_cache_mesh_subset const &in_subset_data = in_mesh_data.m_subsets[subset_index];
 
-                            brx_scratch_buffer *const intermediate_bottom_level_acceleration_structure_build_scratch_buffer = device->create_scratch_buffer(intermediate_bottom_level_acceleration_structure_build_scratch_size);
-                            scratch_buffers.push_back(intermediate_bottom_level_acceleration_structure_build_scratch_buffer);
+                                            Demo_Mesh_Skinned_Subset &out_mesh_skinned_subset = out_mesh_instance.m_skinned_subsets[subset_index];
 
-                            graphics_command_buffer->build_intermediate_bottom_level_acceleration_structure(scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure, static_cast<uint32_t>(bottom_level_acceleration_structure_geometries.size()), bottom_level_acceleration_structure_geometries.data(), intermediate_bottom_level_acceleration_structure_build_scratch_buffer);
+                                            uint32_t const vertex_count = in_subset_data.m_vertex_count;
 
-                            scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer = device->create_scratch_buffer(intermediate_bottom_level_acceleration_structure_update_scratch_size);
+                                            uint32_t const vertex_position_buffer_size = sizeof(scene_mesh_vertex_position_binding) * vertex_count;
 
-                            ++intermediate_bottom_level_acceleration_structure_index;
+                                            out_mesh_skinned_subset.m_skinned_vertex_position_buffer = device->create_storage_intermediate_buffer(vertex_position_buffer_size);
+
+                                            uint32_t const vertex_varying_buffer_size = sizeof(scene_mesh_vertex_varying_binding) * vertex_count;
+
+                                            out_mesh_skinned_subset.m_skinned_vertex_varying_buffer = device->create_storage_intermediate_buffer(vertex_varying_buffer_size);
+                                        }
+                                    }
+                                }
+                            }
                         }
                     }
+
+                    if (import_result.m_scene_cache_hit)
+                    {
+                        // the buffers have been copied into the staging buffers
+                        unmap_file(&import_result.m_scene_cache_file);
+                    }
                 }
-                assert(built_intermediate_bottom_level_acceleration_structures.size() == intermediate_bottom_level_acceleration_structure_index);
 
-                graphics_command_buffer->build_intermediate_bottom_level_acceleration_structure_store(static_cast<uint32_t>(built_intermediate_bottom_level_acceleration_structures.size()), built_intermediate_bottom_level_acceleration_structures.data());
-            }
+                assert(geometry_pool_allocated_size == geometry_pool_size);
+                if (geometry_pool_size > 0U)
+                {
+                    upload_command_buffer->upload_from_staging_upload_buffer_to_storage_asset_buffer(this->m_geometry_pool_buffer, 0U, geometry_pool_staging_upload_buffer, geometry_pool_staging_upload_buffer_offset, geometry_pool_size);
+                }
 
-            // build top level acceleration structure
-            {
-                uint32_t scene_instance_count = 0U;
-                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+                if (this->m_streaming_textures.empty())
                 {
-                    Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+                    // the input streams are no longer used after the assets are uploaded into the staging buffers
+                    // otherwise, the input streams are destroyed after the streaming has finished
+                    if (this->m_use_mapped_file_input_stream_factory)
+                    {
+                        this->m_mapped_file_input_stream_factory.destroy();
+                    }
+                    else
+                    {
+                        import_asset_destroy_memory_input_stream_factory(this->m_input_stream_factory);
+                    }
+                    this->m_input_stream_factory = NULL;
 
-                    uint32_t const mesh_instance_count = static_cast<uint32_t>(scene_mesh.m_instances.size());
-                    scene_instance_count += mesh_instance_count;
+                    if (this->m_use_cooked_texture_input_stream_factory)
+                    {
+                        this->m_cooked_texture_input_stream_factory.destroy();
+                    }
                 }
-                assert(scene_instance_count <= MAX_INSTANCE_COUNT);
 
-                for (uint32_t frame_throttling_index = 0U; frame_throttling_index < FRAME_THROTTLING_COUNT; ++frame_throttling_index)
+#ifndef NDEBUG
+                if (SCENE_COOK_ENABLE_MESH_LOCALITY_OPTIMIZATION && (total_triangle_count > 0U))
                 {
-                    this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index] = device->create_top_level_acceleration_structure_instance_upload_buffer(scene_instance_count);
+                    printf("Mesh Locality Optimization: %llu triangles, average cache lines per triangle %.3f -> %.3f\n", static_cast<unsigned long long>(total_triangle_count), total_cache_lines_before_locality_optimization / static_cast<double>(total_triangle_count), total_cache_lines_after_locality_optimization / static_cast<double>(total_triangle_count));
                 }
+#endif
+            }
 
-                // we use the 0 index when initializing
-                constexpr uint32_t const frame_throttling_index = 0U;
+            // Place Holder Buffer
+            {
+                uint32_t const size = 1U;
 
-                uint32_t top_level_acceleration_structure_size = -1;
-                uint32_t top_level_acceleration_structure_build_scratch_size = -1;
-                uint32_t top_level_acceleration_structure_update_scratch_size = -1;
-                device->get_top_level_acceleration_structure_size(scene_instance_count, &top_level_acceleration_structure_size, &top_level_acceleration_structure_build_scratch_size, &top_level_acceleration_structure_update_scratch_size);
+                this->m_place_holder_buffer = device->create_storage_asset_buffer(size);
 
-                this->m_scene_top_level_acceleration_structure = device->create_top_level_acceleration_structure(top_level_acceleration_structure_size);
+                brx_staging_upload_buffer *place_holder_buffer_staging_upload_buffer;
+                uint32_t place_holder_buffer_staging_upload_buffer_offset;
+                void *place_holder_buffer_staging_upload_buffer_host_memory;
+                staging_upload_arena.allocate(device, size, &place_holder_buffer_staging_upload_buffer, &place_holder_buffer_staging_upload_buffer_offset, &place_holder_buffer_staging_upload_buffer_host_memory);
 
-                uint32_t scene_instance_index = 0U;
-                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
-                {
-                    Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+                std::memset(place_holder_buffer_staging_upload_buffer_host_memory, 0, size);
 
-                    if (!scene_mesh.m_skinned)
-                    {
-                        for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                        {
-                            Demo_Mesh_Instance const &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+                upload_command_buffer->upload_from_staging_upload_buffer_to_storage_asset_buffer(this->m_place_holder_buffer, 0U, place_holder_buffer_staging_upload_buffer, place_holder_buffer_staging_upload_buffer_offset, size);
+            }
 
-                            assert(NULL == scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+            // Place Holder Texture
+            {
+                uint32_t const staging_upload_buffer_offset_alignment = device->get_staging_upload_buffer_offset_alignment();
+                uint32_t const staging_upload_buffer_row_pitch_alignment = device->get_staging_upload_buffer_row_pitch_alignment();
 
-                            BRX_TOP_LEVEL_ACCELERATION_STRUCTURE_INSTANCE top_level_acceleration_structure_instance = {
-                                {},
-                                scene_instance_index,
-                                0XFFU,
-                                true,
-                                false,
-                                false,
-                                false,
-                                scene_mesh.m_compacted_bottom_level_acceleration_structure->get_bottom_level_acceleration_structure()};
+                BRX_SAMPLED_ASSET_IMAGE_FORMAT const format = BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_UNORM;
+                uint32_t const width = 1U;
+                uint32_t const height = 1U;
+                uint32_t const mip_levels = 1U;
+                this->m_place_holder_texture = device->create_sampled_asset_image(format, width, height, mip_levels);
 
-                            DirectX::XMStoreFloat3x4(reinterpret_cast<DirectX::XMFLOAT3X4 *>(&top_level_acceleration_structure_instance.transform_matrix), DirectX::XMLoadFloat4x4(&scene_mesh_instance.m_model_transform));
+                load_arena_vector<BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST> subresource_memcpy_dests(&load_arena);
+                uint32_t const subresource_count = mip_levels;
+                subresource_memcpy_dests.resize(subresource_count);
 
-                            this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index]->write_instance(scene_instance_index, &top_level_acceleration_structure_instance);
+                uint32_t const total_bytes = brx_sampled_asset_image_import_calculate_subresource_memcpy_dests(format, width, height, 1U, mip_levels, 1U, 0U, staging_upload_buffer_offset_alignment, staging_upload_buffer_row_pitch_alignment, subresource_count, &subresource_memcpy_dests[0]);
+                brx_staging_upload_buffer *place_holder_image_staging_upload_buffer;
+                uint32_t place_holder_image_staging_upload_buffer_offset;
+                void *place_holder_image_staging_upload_buffer_host_memory;
+                staging_upload_arena.allocate(device, total_bytes, &place_holder_image_staging_upload_buffer, &place_holder_image_staging_upload_buffer_offset, &place_holder_image_staging_upload_buffer_host_memory);
 
-                            ++scene_instance_index;
-                        }
-                    }
-                    else
+                uint32_t const mip_level = 0U;
+                uint32_t const subresource_index = brx_sampled_asset_image_import_calculate_subresource_index(mip_level, 0U, 0U, mip_levels, 1U);
+                for (uint32_t output_slice_index = 0U; output_slice_index < subresource_memcpy_dests[mip_level].output_slice_count; ++output_slice_index)
+                {
+                    for (uint32_t output_row_index = 0U; output_row_index < subresource_memcpy_dests[mip_level].output_row_count; ++output_row_index)
                     {
-                        assert(NULL == scene_mesh.m_compacted_bottom_level_acceleration_structure);
-
-                        for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                        {
-                            Demo_Mesh_Instance const &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
-
-                            BRX_TOP_LEVEL_ACCELERATION_STRUCTURE_INSTANCE top_level_acceleration_structure_instance = {
-                                {},
-                                scene_instance_index,
-                                0XFFU,
-                                true,
-                                false,
-                                false,
-                                false,
-                                scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure->get_bottom_level_acceleration_structure()};
-
-                            DirectX::XMStoreFloat3x4(reinterpret_cast<DirectX::XMFLOAT3X4 *>(&top_level_acceleration_structure_instance.transform_matrix), DirectX::XMLoadFloat4x4(&scene_mesh_instance.m_model_transform));
-
-                            this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index]->write_instance(scene_instance_index, &top_level_acceleration_structure_instance);
+                        void *destination = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(place_holder_image_staging_upload_buffer_host_memory) + (subresource_memcpy_dests[subresource_index].staging_upload_buffer_offset + subresource_memcpy_dests[subresource_index].output_slice_pitch * output_slice_index + subresource_memcpy_dests[subresource_index].output_row_pitch * output_row_index));
 
-                            ++scene_instance_index;
-                        }
+                        std::memset(destination, 0, subresource_memcpy_dests[mip_level].output_row_size);
                     }
                 }
-                assert(scene_instance_count == scene_instance_index);
-
-                brx_scratch_buffer *const top_level_acceleration_structure_build_scratch_buffer = device->create_scratch_buffer(top_level_acceleration_structure_build_scratch_size);
-                scratch_buffers.push_back(top_level_acceleration_structure_build_scratch_buffer);
-
-                graphics_command_buffer->build_top_level_acceleration_structure(this->m_scene_top_level_acceleration_structure, scene_instance_count, this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index], top_level_acceleration_structure_build_scratch_buffer);
-
-                graphics_command_buffer->build_top_level_acceleration_structure_store(this->m_scene_top_level_acceleration_structure);
-
-                this->m_scene_top_level_acceleration_structure_update_scratch_buffer = device->create_scratch_buffer(top_level_acceleration_structure_update_scratch_size);
-            }
-
-            upload_command_buffer->end();
-
-            graphics_command_buffer->end();
-
-            upload_queue->submit_and_signal(upload_command_buffer);
-
-            device->reset_fence(fence);
-
-            graphics_queue->wait_and_submit(upload_command_buffer, graphics_command_buffer, fence);
 
-            device->wait_for_fence(fence);
-
-            if (!scene_non_compacted_bottom_level_acceleration_structures.empty())
-            {
-                device->destroy_compacted_bottom_level_acceleration_structure_size_query_pool(compacted_bottom_level_acceleration_structure_size_query_pool);
-            }
-            else
-            {
-                assert(NULL == compacted_bottom_level_acceleration_structure_size_query_pool);
-            }
-
-            for (uint32_t non_compacted_bottom_level_acceleration_structure_index = 0U; non_compacted_bottom_level_acceleration_structure_index < scene_non_compacted_bottom_level_acceleration_structures.size(); ++non_compacted_bottom_level_acceleration_structure_index)
-            {
-                device->destroy_non_compacted_bottom_level_acceleration_structure(scene_non_compacted_bottom_level_acceleration_structures[non_compacted_bottom_level_acceleration_structure_index]);
+                upload_command_buffer->upload_from_staging_upload_buffer_to_sampled_asset_image(this->m_place_holder_texture, format, width, height, mip_level, place_holder_image_staging_upload_buffer, place_holder_image_staging_upload_buffer_offset + subresource_memcpy_dests[mip_level].staging_upload_buffer_offset, subresource_memcpy_dests[mip_level].output_row_pitch, subresource_memcpy_dests[mip_level].output_row_count);
             }
-            scene_non_compacted_bottom_level_acceleration_structures.clear();
 
-            for (brx_scratch_buffer *const scratch_buffer : scratch_buffers)
+            // Scene Information Buffer
+            // upload instance information buffer
+            // upload geometry information buffer
             {
-                device->destroy_scratch_buffer(scratch_buffer);
-            }
-
-            scratch_buffers.clear();
-        }
-
-        device->destroy_fence(fence);
-
-        device->destroy_upload_command_buffer(upload_command_buffer);
-
-        device->destroy_graphics_command_buffer(graphics_command_buffer);
-
-        device->destroy_upload_queue(upload_queue);
+                this->m_bindless_buffer_allocator.init(MAX_MESH_SUBSET_BUFFER_COUNT);
+                this->m_bindless_texture_allocator.init(MAX_MESH_SUBSET_TEXTURE_COUNT);
 
-        device->destroy_graphics_queue(graphics_queue);
-    }
+                this->m_gbuffer_pipeline_none_update_bindless_buffer_descriptor_set = device->create_descriptor_set(gbuffer_pipeline_none_update_bindless_buffer_descriptor_set_layout);
+                this->m_gbuffer_pipeline_none_update_bindless_texture_descriptor_set = device->create_descriptor_set(gbuffer_pipeline_none_update_bindless_texture_descriptor_set_layout);
 
-    // Sampler
-    {
-        this->m_sampler = device->create_sampler(BRX_SAMPLER_FILTER_LINEAR);
-    }
+                // the slots which are NOT allocated are always written with the place holder
+                {
+                    load_arena_vector<brx_read_only_storage_buffer const *> read_only_storage_buffers(static_cast<size_t>(MAX_MESH_SUBSET_BUFFER_COUNT), this->m_place_holder_buffer->get_read_only_storage_buffer(), &load_arena);
+                    device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_bindless_buffer_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_READ_ONLY_STORAGE_BUFFER, 0U, static_cast<uint32_t>(read_only_storage_buffers.size()), NULL, NULL, read_only_storage_buffers.data(), NULL, NULL, NULL, NULL, NULL);
 
-    // Uniform Buffer
-    {
-        this->m_uniform_upload_buffer_offset_alignment = device->get_uniform_upload_buffer_offset_alignment();
+                    load_arena_vector<brx_sampled_image const *> sample_images(static_cast<size_t>(MAX_MESH_SUBSET_TEXTURE_COUNT), this->m_place_holder_texture->get_sampled_image(), &load_arena);
+                    device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_bindless_texture_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 0U, static_cast<uint32_t>(sample_images.size()), NULL, NULL, NULL, NULL, sample_images.data(), NULL, NULL, NULL);
+                }
 
-        this->m_common_gbuffer_pipeline_ambient_occlusion_pipeline_none_update_uniform_buffer = device->create_uniform_upload_buffer(tbb_align_up(static_cast<uint32_t>(sizeof(common_none_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * FRAME_THROTTLING_COUNT);
+                // the place holder texture is used when the mesh subset has no texture
+                // the first allocation never fails
+                brx_sampled_image const *const place_holder_sampled_image = this->m_place_holder_texture->get_sampled_image();
+                uint32_t const place_holder_texture_bindless_index = this->allocate_bindless_textures(device, 1U, &place_holder_sampled_image);
+                assert(UINT32_MAX != place_holder_texture_bindless_index);
 
-        this->m_gbuffer_pipeline_none_update_instance_information_uniform_buffer = device->create_uniform_upload_buffer(tbb_align_up(static_cast<uint32_t>(sizeof(gbuffer_pipeline_none_update_set_instance_information_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * FRAME_THROTTLING_COUNT);
+                // the scene textures have NOT been uploaded yet, and the slots are written with the place holder until "update_texture_streaming" has found the upload completed
+                mcrt_unordered_map<brx_sampled_asset_image const *, uint32_t> scene_texture_bindless_indices;
+                if (!this->m_scene_textures.empty())
+                {
+                    load_arena_vector<brx_sampled_image const *> material_sampled_images(this->m_scene_textures.size(), place_holder_sampled_image, &load_arena);
 
-        for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
-        {
-            Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+                    this->m_scene_texture_bindless_base_index = this->allocate_bindless_textures(device, static_cast<uint32_t>(material_sampled_images.size()), material_sampled_images.data());
 
-            for (size_t instance_index = 0U; instance_index < scene_mesh.m_instances.size(); ++instance_index)
-            {
-                Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[instance_index];
+                    if (UINT32_MAX != this->m_scene_texture_bindless_base_index)
+                    {
+                        for (size_t material_texture_index = 0U; material_texture_index < this->m_scene_textures.size(); ++material_texture_index)
+                        {
+                            scene_texture_bindless_indices.emplace(this->m_scene_textures[material_texture_index], this->m_scene_texture_bindless_base_index + static_cast<uint32_t>(material_texture_index));
+                        }
+                    }
+                    else
+                    {
+                        // the scene textures are never bound (but still streamed), and the place holder is used instead
+                        printf("Bindless Textures: %u scene textures do NOT fit in %u bindless texture slots (MAX_MESH_SUBSET_TEXTURE_COUNT %u), and the place holder is used instead\n", static_cast<unsigned>(this->m_scene_textures.size()), static_cast<unsigned>(this->m_bindless_texture_allocator.get_capacity() - this->m_bindless_texture_allocator.get_allocated_count()), static_cast<unsigned>(MAX_MESH_SUBSET_TEXTURE_COUNT));
 
-                if (!scene_mesh.m_skinned)
-                {
-                    scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_uniform_buffer = NULL;
+                        for (size_t material_texture_index = 0U; material_texture_index < this->m_scene_textures.size(); ++material_texture_index)
+                        {
+                            scene_texture_bindless_indices.emplace(this->m_scene_textures[material_texture_index], place_holder_texture_bindless_index);
+                        }
+                    }
                 }
                 else
                 {
-                    scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_uniform_buffer = device->create_uniform_upload_buffer(tbb_align_up(static_cast<uint32_t>(sizeof(skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * FRAME_THROTTLING_COUNT);
+                    this->m_scene_texture_bindless_base_index = 0U;
                 }
-            }
-        }
-    }
-
-    // Descriptor
-    {
-        // Skin Pipeline
-        {
-            for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
-            {
-                Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
 
-                if (!scene_mesh.m_skinned)
+                // the geometry pool buffer is shared by all mesh subsets
+                // the geometry pool buffer is NOT created when no scene is loaded (e.g., the content root is empty, or all scenes are skipped), and there is no mesh subset to refer to it
+                uint32_t geometry_pool_bindless_index = UINT32_MAX;
+                if (NULL != this->m_geometry_pool_buffer)
                 {
-                    for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                    {
-                        Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
-
-                        assert(scene_mesh_instance.m_skinned_subsets.empty());
-
-                        scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_descriptor_set = NULL;
-                    }
+                    brx_read_only_storage_buffer const *const geometry_pool_read_only_storage_buffer = this->m_geometry_pool_buffer->get_read_only_storage_buffer();
+                    geometry_pool_bindless_index = this->allocate_bindless_buffers(device, 1U, &geometry_pool_read_only_storage_buffer);
+                    assert(UINT32_MAX != geometry_pool_bindless_index);
                 }
                 else
                 {
-                    for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                    {
-                        Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
-
-                        assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
+                    assert(this->m_scene_meshes.empty());
+                }
 
-                        for (size_t mesh_subset_index = 0U; mesh_subset_index < scene_mesh_instance.m_skinned_subsets.size(); ++mesh_subset_index)
-                        {
-                            Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[mesh_subset_index];
+                load_arena_vector<uint32_t> scene_instance_information(&load_arena);
+                load_arena_vector<geometry_information_storage_buffer_T> scene_geometry_information(&load_arena);
+                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+                {
+                    Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
 
-                            Demo_Mesh_Skinned_Subset &scene_mesh_skinned_subset = scene_mesh_instance.m_skinned_subsets[mesh_subset_index];
+                    // the index buffer, the information buffer and the textures are shared by all instances of the mesh
+                    load_arena_vector<geometry_information_storage_buffer_T> mesh_geometry_information(scene_mesh.m_subsets.size(), &load_arena);
+                    for (size_t mesh_subset_index = 0U; mesh_subset_index < scene_mesh.m_subsets.size(); ++mesh_subset_index)
+                    {
+                        Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[mesh_subset_index];
 
-                            {
-                                scene_mesh_skinned_subset.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set = device->create_descriptor_set(skin_pipeline_per_mesh_skinned_subset_update_descriptor_set_layout);
+                        static constexpr uint32_t const DEMO_MESH_SUBSET_ASSET_TEXTURE_COUNT = 4U;
 
-                                brx_read_only_storage_buffer const *const read_only_storage_buffers[] = {
-                                    scene_mesh_subset.m_vertex_position_buffer->get_read_only_storage_buffer(),
-                                    scene_mesh_subset.m_vertex_varying_buffer->get_read_only_storage_buffer(),
-                                    scene_mesh_subset.m_vertex_joint_buffer->get_read_only_storage_buffer()};
-                                device->write_descriptor_set(scene_mesh_skinned_subset.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_READ_ONLY_STORAGE_BUFFER, 0U, sizeof(read_only_storage_buffers) / sizeof(read_only_storage_buffers[0]), NULL, NULL, read_only_storage_buffers, NULL, NULL, NULL, NULL, NULL);
+                        brx_sampled_asset_image const *const mesh_subset_textures[DEMO_MESH_SUBSET_ASSET_TEXTURE_COUNT] = {
+                            scene_mesh_subset.m_normal_texture,
+                            scene_mesh_subset.m_emissive_texture,
+                            scene_mesh_subset.m_base_color_texture,
+                            scene_mesh_subset.m_metallic_roughness_texture};
 
-                                brx_storage_buffer const *const storage_buffers[] = {
-                                    scene_mesh_skinned_subset.m_skinned_vertex_position_buffer->get_storage_buffer(),
-                                    scene_mesh_skinned_subset.m_skinned_vertex_varying_buffer->get_storage_buffer()};
-                                device->write_descriptor_set(scene_mesh_skinned_subset.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set, 1U, BRX_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0U, sizeof(storage_buffers) / sizeof(storage_buffers[0]), NULL, NULL, NULL, storage_buffers, NULL, NULL, NULL, NULL);
-                            }
-                        }
+                        uint32_t mesh_subset_texture_bindless_indices[DEMO_MESH_SUBSET_ASSET_TEXTURE_COUNT];
 
+                        for (uint32_t mesh_subset_asset_texture_index = 0U; mesh_subset_asset_texture_index < DEMO_MESH_SUBSET_ASSET_TEXTURE_COUNT; ++mesh_subset_asset_texture_index)
                         {
-                            scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_descriptor_set = device->create_descriptor_set(skin_pipeline_per_mesh_instance_update_descriptor_set_layout);
-
-                            constexpr uint32_t const dynamic_uniform_buffers_range = sizeof(skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding);
-                            device->write_descriptor_set(scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER, 0U, 1U, &scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_uniform_buffer, &dynamic_uniform_buffers_range, NULL, NULL, NULL, NULL, NULL, NULL);
+                            if (NULL != mesh_subset_textures[mesh_subset_asset_texture_index])
+                            {
+                                mcrt_unordered_map<brx_sampled_asset_image const *, uint32_t>::const_iterator found = scene_texture_bindless_indices.find(mesh_subset_textures[mesh_subset_asset_texture_index]);
+                                assert(scene_texture_bindless_indices.end() != found);
+                                mesh_subset_texture_bindless_indices[mesh_subset_asset_texture_index] = found->second;
+                            }
+                            else
+                            {
+                                mesh_subset_texture_bindless_indices[mesh_subset_asset_texture_index] = place_holder_texture_bindless_index;
+                            }
                         }
-                    }
-                }
-            }
-        }
 
-        // GBuffer Pipeline
-        {
-            this->m_gbuffer_pipeline_none_update_descriptor_set = device->create_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set_layout);
-            {
-                constexpr uint32_t const dynamic_uniform_buffers_range = sizeof(common_none_update_set_uniform_buffer_binding);
-                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER, 0U, 1U, &this->m_common_gbuffer_pipeline_ambient_occlusion_pipeline_none_update_uniform_buffer, &dynamic_uniform_buffers_range, NULL, NULL, NULL, NULL, NULL, NULL);
-            }
-            {
-                brx_top_level_acceleration_structure const *const top_level_acceleration_structures[] = {
-                    this->m_scene_top_level_acceleration_structure};
-                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set, 1U, BRX_DESCRIPTOR_TYPE_TOP_LEVEL_ACCELERATION_STRUCTURE, 0U, sizeof(top_level_acceleration_structures) / sizeof(top_level_acceleration_structures[0]), NULL, NULL, NULL, NULL, NULL, NULL, NULL, &top_level_acceleration_structures[0]);
-            }
-            {
-                constexpr uint32_t const dynamic_uniform_buffers_range = sizeof(gbuffer_pipeline_none_update_set_instance_information_uniform_buffer_binding);
-                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set, 2U, BRX_DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER, 0U, 1U, &this->m_gbuffer_pipeline_none_update_instance_information_uniform_buffer, &dynamic_uniform_buffers_range, NULL, NULL, NULL, NULL, NULL, NULL);
-            }
-            {
-                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set, 3U, BRX_DESCRIPTOR_TYPE_SAMPLER, 0U, 1U, NULL, NULL, NULL, NULL, NULL, NULL, &this->m_sampler, NULL);
-            }
+                        brx_read_only_storage_buffer const *const index_buffer = scene_mesh_subset.m_index_buffer->get_read_only_storage_buffer();
 
-            this->m_gbuffer_pipeline_none_update_bindless_buffer_descriptor_set = device->create_descriptor_set(gbuffer_pipeline_none_update_bindless_buffer_descriptor_set_layout);
-            this->m_gbuffer_pipeline_none_update_bindless_texture_descriptor_set = device->create_descriptor_set(gbuffer_pipeline_none_update_bindless_texture_descriptor_set_layout);
-            {
-                uint32_t scene_geometry_count = 0U;
-                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
-                {
-                    Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+                        uint32_t const index_buffer_bindless_index = this->allocate_bindless_buffers(device, 1U, &index_buffer);
+                        assert(UINT32_MAX != index_buffer_bindless_index);
 
-                    if (!scene_mesh.m_skinned)
-                    {
-                        uint32_t const mesh_geometry_count = static_cast<uint32_t>(scene_mesh.m_subsets.size());
-                        scene_geometry_count += mesh_geometry_count;
-                    }
-                    else
-                    {
-                        uint32_t const mesh_geometry_count = static_cast<uint32_t>(scene_mesh.m_subsets.size() * scene_mesh.m_instances.size());
-                        scene_geometry_count += mesh_geometry_count;
+                        mesh_geometry_information[mesh_subset_index].m_packed_vertex_position_buffer_index_vertex_varying_buffer_index = 0U;
+                        mesh_geometry_information[mesh_subset_index].m_packed_index_buffer_index_information_buffer_index = pack_r16g16_uint(index_buffer_bindless_index, geometry_pool_bindless_index);
+                        mesh_geometry_information[mesh_subset_index].m_packed_normal_texture_index_emissive_texture_index = pack_r16g16_uint(mesh_subset_texture_bindless_indices[0], mesh_subset_texture_bindless_indices[1]);
+                        mesh_geometry_information[mesh_subset_index].m_packed_base_color_texture_index_metallic_roughness_texture_index = pack_r16g16_uint(mesh_subset_texture_bindless_indices[2], mesh_subset_texture_bindless_indices[3]);
+                        mesh_geometry_information[mesh_subset_index].m_vertex_varying_buffer_offset = 0U;
+                        mesh_geometry_information[mesh_subset_index].m_information_buffer_offset = scene_mesh_subset.m_information_geometry_pool_offset;
+                        mesh_geometry_information[mesh_subset_index]._unused_padding_1 = 0U;
+                        mesh_geometry_information[mesh_subset_index]._unused_padding_2 = 0U;
                     }
-                }
-                assert(scene_geometry_count <= MAX_GEOMETRY_COUNT);
-
-                mcrt_vector<brx_read_only_storage_buffer const *> read_only_storage_buffers(static_cast<size_t>(MAX_MESH_SUBSET_BUFFER_COUNT));
-                mcrt_vector<brx_sampled_image const *> sample_images(static_cast<size_t>(MAX_MESH_SUBSET_TEXTURE_COUNT));
-
-                uint32_t scene_geometry_index = 0U;
-                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
-                {
-                    Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
 
                     if (!scene_mesh.m_skinned)
                     {
+                        // all instances share the same geometries
+                        uint32_t const global_geometry_index_offset = static_cast<uint32_t>(scene_geometry_information.size());
+
                         for (size_t mesh_subset_index = 0U; mesh_subset_index < scene_mesh.m_subsets.size(); ++mesh_subset_index)
                         {
                             Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[mesh_subset_index];
 
-                            read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index] = scene_mesh_subset.m_vertex_position_buffer->get_read_only_storage_buffer();
-                            read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index + 1U] = scene_mesh_subset.m_vertex_varying_buffer->get_read_only_storage_buffer();
-                            read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index + 2U] = scene_mesh_subset.m_index_buffer->get_read_only_storage_buffer();
-                            read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index + 3U] = scene_mesh_subset.m_information_buffer->get_read_only_storage_buffer();
+                            assert(NULL == scene_mesh_subset.m_vertex_varying_buffer);
+
+                            brx_read_only_storage_buffer const *const vertex_position_buffer = scene_mesh_subset.m_vertex_position_buffer->get_read_only_storage_buffer();
 
-                            sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index] = (NULL != scene_mesh_subset.m_normal_texture) ? scene_mesh_subset.m_normal_texture->get_sampled_image() : this->m_place_holder_texture->get_sampled_image();
-                            sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index + 1U] = (NULL != scene_mesh_subset.m_emissive_texture) ? scene_mesh_subset.m_emissive_texture->get_sampled_image() : this->m_place_holder_texture->get_sampled_image();
-                            sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index + 2U] = (NULL != scene_mesh_subset.m_base_color_texture) ? scene_mesh_subset.m_base_color_texture->get_sampled_image() : this->m_place_holder_texture->get_sampled_image();
-                            sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index + 3U] = (NULL != scene_mesh_subset.m_metallic_roughness_texture) ? scene_mesh_subset.m_metallic_roughness_texture->get_sampled_image() : this->m_place_holder_texture->get_sampled_image();
+                            uint32_t const vertex_position_buffer_bindless_index = this->allocate_bindless_buffers(device, 1U, &vertex_position_buffer);
+                            assert(UINT32_MAX != vertex_position_buffer_bindless_index);
 
-                            ++scene_geometry_index;
+                            geometry_information_storage_buffer_T geometry_information = mesh_geometry_information[mesh_subset_index];
+                            geometry_information.m_packed_vertex_position_buffer_index_vertex_varying_buffer_index = pack_r16g16_uint(vertex_position_buffer_bindless_index, geometry_pool_bindless_index);
+                            geometry_information.m_vertex_varying_buffer_offset = scene_mesh_subset.m_vertex_varying_geometry_pool_offset;
+                            scene_geometry_information.push_back(geometry_information);
+                        }
+
+                        for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
+                        {
+                            scene_instance_information.push_back(global_geometry_index_offset);
                         }
                     }
                     else
                     {
+                        // each instance has its own skinned geometries
                         for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
                         {
                             Demo_Mesh_Instance const &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
 
                             assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
 
+                            uint32_t const global_geometry_index_offset = static_cast<uint32_t>(scene_geometry_information.size());
+
                             for (size_t mesh_subset_index = 0U; mesh_subset_index < scene_mesh_instance.m_skinned_subsets.size(); ++mesh_subset_index)
                             {
-                                Demo_Mesh_Skinned_Subset const &scene_mesh_skin_subset = scene_mesh_instance.m_skinned_subsets[mesh_subset_index];
-
-                                Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[mesh_subset_index];
+                                Demo_Mesh_Skinned_Subset const &scene_mesh_skinned_subset = scene_mesh_instance.m_skinned_subsets[mesh_subset_index];
 
-                                read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index] = scene_mesh_skin_subset.m_skinned_vertex_position_buffer->get_read_only_storage_buffer();
-                                read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index + 1U] = scene_mesh_skin_subset.m_skinned_vertex_varying_buffer->get_read_only_storage_buffer();
-                                read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index + 2U] = scene_mesh_subset.m_index_buffer->get_read_only_storage_buffer();
-                                read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index + 3U] = scene_mesh_subset.m_information_buffer->get_read_only_storage_buffer();
+                                brx_read_only_storage_buffer const *const mesh_skinned_subset_vertex_buffers[] = {
+                                    scene_mesh_skinned_subset.m_skinned_vertex_position_buffer->get_read_only_storage_buffer(),
+                                    scene_mesh_skinned_subset.m_skinned_vertex_varying_buffer->get_read_only_storage_buffer()};
 
-                                sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index] = (NULL != scene_mesh_subset.m_normal_texture) ? scene_mesh_subset.m_normal_texture->get_sampled_image() : this->m_place_holder_texture->get_sampled_image();
-                                sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index + 1U] = (NULL != scene_mesh_subset.m_emissive_texture) ? scene_mesh_subset.m_emissive_texture->get_sampled_image() : this->m_place_holder_texture->get_sampled_image();
-                                sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index + 2U] = (NULL != scene_mesh_subset.m_base_color_texture) ? scene_mesh_subset.m_base_color_texture->get_sampled_image() : this->m_place_holder_texture->get_sampled_image();
-                                sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index + 3U] = (NULL != scene_mesh_subset.m_metallic_roughness_texture) ? scene_mesh_subset.m_metallic_roughness_texture->get_sampled_image() : this->m_place_holder_texture->get_sampled_image();
+                                uint32_t const vertex_position_buffer_bindless_index = this->allocate_bindless_buffers(device, sizeof(mesh_skinned_subset_vertex_buffers) / sizeof(mesh_skinned_subset_vertex_buffers[0]), mesh_skinned_subset_vertex_buffers);
+                                assert(UINT32_MAX != vertex_position_buffer_bindless_index);
+                                uint32_t const vertex_varying_buffer_bindless_index = vertex_position_buffer_bindless_index + 1U;
 
-                                ++scene_geometry_index;
+                                geometry_information_storage_buffer_T geometry_information = mesh_geometry_information[mesh_subset_index];
+                                geometry_information.m_packed_vertex_position_buffer_index_vertex_varying_buffer_index = pack_r16g16_uint(vertex_position_buffer_bindless_index, vertex_varying_buffer_bindless_index);
+                                scene_geometry_information.push_back(geometry_information);
                             }
+
+                            scene_instance_information.push_back(global_geometry_index_offset);
                         }
                     }
                 }
-                assert(scene_geometry_count == scene_geometry_index);
+                this->m_scene_instance_count = static_cast<uint32_t>(scene_instance_information.size());
+                this->m_scene_geometry_count = static_cast<uint32_t>(scene_geometry_information.size());
 
-                while (scene_geometry_index < MAX_GEOMETRY_COUNT)
+                size_t const source_asset_buffer_sizes[SCENE_INFORMATION_BUFFER_COUNT] = {
+                    sizeof(uint32_t) * scene_instance_information.size(),
+                    sizeof(geometry_information_storage_buffer_T) * scene_geometry_information.size()};
+
+                void const *const source_asset_buffers[SCENE_INFORMATION_BUFFER_COUNT] = {
+                    scene_instance_information.data(),
+                    scene_geometry_information.data()};
+
+                brx_storage_asset_buffer **const destination_asset_buffers[SCENE_INFORMATION_BUFFER_COUNT] = {
+                    &this->m_scene_instance_information_buffer,
+                    &this->m_scene_geometry_information_buffer};
+
+                for (uint32_t scene_information_buffer_index = 0U; scene_information_buffer_index < SCENE_INFORMATION_BUFFER_COUNT; ++scene_information_buffer_index)
                 {
-                    read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index] = this->m_place_holder_buffer->get_read_only_storage_buffer();
-                    read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index + 1U] = this->m_place_holder_buffer->get_read_only_storage_buffer();
-                    read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index + 2U] = this->m_place_holder_buffer->get_read_only_storage_buffer();
-                    read_only_storage_buffers[PER_MESH_SUBSET_BUFFER_COUNT * scene_geometry_index + 3U] = this->m_place_holder_buffer->get_read_only_storage_buffer();
+                    uint32_t const asset_buffer_size = static_cast<uint32_t>(source_asset_buffer_sizes[scene_information_buffer_index]);
 
-                    sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index] = this->m_place_holder_texture->get_sampled_image();
-                    sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index + 1U] = this->m_place_holder_texture->get_sampled_image();
-                    sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index + 2U] = this->m_place_holder_texture->get_sampled_image();
-                    sample_images[PER_MESH_SUBSET_TEXTURE_COUNT * scene_geometry_index + 3U] = this->m_place_holder_texture->get_sampled_image();
+                    // the empty buffer is NOT created, and the place holder is written into the descriptor instead
+                    if (asset_buffer_size > 0U)
+                    {
+                        (*destination_asset_buffers[scene_information_buffer_index]) = device->create_storage_asset_buffer(asset_buffer_size);
 
-                    ++scene_geometry_index;
-                }
+                        brx_staging_upload_buffer *asset_buffer_staging_upload_buffer;
+                        uint32_t asset_buffer_staging_upload_buffer_offset;
+                        void *asset_buffer_staging_upload_buffer_host_memory;
+                        staging_upload_arena.allocate(device, asset_buffer_size, &asset_buffer_staging_upload_buffer, &asset_buffer_staging_upload_buffer_offset, &asset_buffer_staging_upload_buffer_host_memory);
 
-                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_bindless_buffer_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_READ_ONLY_STORAGE_BUFFER, 0U, static_cast<uint32_t>(read_only_storage_buffers.size()), NULL, NULL, read_only_storage_buffers.data(), NULL, NULL, NULL, NULL, NULL);
+                        std::memcpy(asset_buffer_staging_upload_buffer_host_memory, source_asset_buffers[scene_information_buffer_index], asset_buffer_size);
 
-                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_bindless_texture_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 0U, static_cast<uint32_t>(sample_images.size()), NULL, NULL, NULL, NULL, sample_images.data(), NULL, NULL, NULL);
+                        upload_command_buffer->upload_from_staging_upload_buffer_to_storage_asset_buffer((*destination_asset_buffers[scene_information_buffer_index]), 0U, asset_buffer_staging_upload_buffer, asset_buffer_staging_upload_buffer_offset, asset_buffer_size);
+                    }
+                    else
+                    {
+                        (*destination_asset_buffers[scene_information_buffer_index]) = NULL;
+                    }
+                }
             }
-        }
 
-        // Ambient Occlusion Pipeline
-        {
-            this->m_ambient_occlusion_pipeline_none_update_descriptor_set = device->create_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set_layout);
+            // build staging non compacted bottom level acceleration structure
+            // release
+            // acquire
             {
-                constexpr uint32_t const dynamic_uniform_buffers_range = sizeof(common_none_update_set_uniform_buffer_binding);
-                device->write_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER, 0U, 1U, &this->m_common_gbuffer_pipeline_ambient_occlusion_pipeline_none_update_uniform_buffer, &dynamic_uniform_buffers_range, NULL, NULL, NULL, NULL, NULL, NULL);
-            }
+                // build staging non compacted bottom level acceleration structure
+                {
+                    load_arena_vector<brx_acceleration_structure_build_input_read_only_buffer const *> non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers(&load_arena);
+                    uint32_t scene_non_compacted_bottom_level_acceleration_structure_count = 0U;
+                    for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+                    {
+                        Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+
+                        if (!scene_mesh.m_skinned)
+                        {
+                            for (size_t subset_index = 0U; subset_index < scene_mesh.m_subsets.size(); ++subset_index)
+                            {
+                                Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[subset_index];
+
+                                brx_storage_asset_buffer const *const acceleration_structure_build_input_vertex_position_buffer = (NULL != scene_mesh_subset.m_acceleration_structure_build_input_vertex_position_buffer) ? scene_mesh_subset.m_acceleration_structure_build_input_vertex_position_buffer : scene_mesh_subset.m_vertex_position_buffer;
+
+                                non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.push_back(acceleration_structure_build_input_vertex_position_buffer->get_acceleration_structure_build_input_read_only_buffer());
+
+                                non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.push_back(scene_mesh_subset.m_index_buffer->get_acceleration_structure_build_input_read_only_buffer());
+                            }
+
+                            ++scene_non_compacted_bottom_level_acceleration_structure_count;
+                        }
+                    }
+
+                    if (scene_non_compacted_bottom_level_acceleration_structure_count > 0U)
+                    {
+                        upload_command_buffer->build_non_compacted_bottom_level_acceleration_structure_pass_load(static_cast<uint32_t>(non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.size()), non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.data());
+
+                        assert(NULL == compacted_bottom_level_acceleration_structure_size_query_pool);
+                        compacted_bottom_level_acceleration_structure_size_query_pool = device->create_compacted_bottom_level_acceleration_structure_size_query_pool(scene_non_compacted_bottom_level_acceleration_structure_count);
+
+                        scene_non_compacted_bottom_level_acceleration_structures.resize(scene_non_compacted_bottom_level_acceleration_structure_count);
+
+                        uint32_t non_compacted_bottom_level_acceleration_structure_index = 0U;
+                        for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+                        {
+                            Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+
+                            if (!scene_mesh.m_skinned)
+                            {
+                                load_arena_vector<BRX_BOTTOM_LEVEL_ACCELERATION_STRUCTURE_GEOMETRY> bottom_level_acceleration_structure_geometries(scene_mesh.m_subsets.size(), &load_arena);
+
+                                for (size_t subset_index = 0U; subset_index < scene_mesh.m_subsets.size(); ++subset_index)
+                                {
+                                    Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[subset_index];
+
+                                    brx_storage_asset_buffer const *const acceleration_structure_build_input_vertex_position_buffer = (NULL != scene_mesh_subset.m_acceleration_structure_build_input_vertex_position_buffer) ? scene_mesh_subset.m_acceleration_structure_build_input_vertex_position_buffer : scene_mesh_subset.m_vertex_position_buffer;
+
+                                    bottom_level_acceleration_structure_geometries[subset_index] = BRX_BOTTOM_LEVEL_ACCELERATION_STRUCTURE_GEOMETRY{true,
+                                                                                                                                                    BRX_GRAPHICS_PIPELINE_VERTEX_ATTRIBUTE_FORMAT_R32G32B32_SFLOAT,
+                                                                                                                                                    sizeof(scene_mesh_vertex_position_binding),
+                                                                                                                                                    scene_mesh_subset.m_vertex_count,
+                                                                                                                                                    acceleration_structure_build_input_vertex_position_buffer->get_acceleration_structure_build_input_read_only_buffer(),
+                                                                                                                                                    scene_mesh_subset.m_index_type,
+                                                                                                                                                    scene_mesh_subset.m_index_count,
+                                                                                                                                                    scene_mesh_subset.m_index_buffer->get_acceleration_structure_build_input_read_only_buffer()};
+                                }
+
+                                uint32_t non_compacted_bottom_level_acceleration_structure_size = -1;
+                                uint32_t non_compacted_bottom_level_acceleration_structure_build_scratch_size = -1;
+                                device->get_non_compacted_bottom_level_acceleration_structure_size(static_cast<uint32_t>(bottom_level_acceleration_structure_geometries.size()), bottom_level_acceleration_structure_geometries.data(), &non_compacted_bottom_level_acceleration_structure_size, &non_compacted_bottom_level_acceleration_structure_build_scratch_size);
+
+                                scene_non_compacted_bottom_level_acceleration_structures[non_compacted_bottom_level_acceleration_structure_index] = device->create_non_compacted_bottom_level_acceleration_structure(non_compacted_bottom_level_acceleration_structure_size);
+
+                                brx_scratch_buffer *const non_compacted_bottom_level_acceleration_structure_build_scratch_buffer = device->create_scratch_buffer(non_compacted_bottom_level_acceleration_structure_build_scratch_size);
+                                scratch_buffers.push_back(non_compacted_bottom_level_acceleration_structure_build_scratch_buffer);
+
+                                upload_command_buffer->build_non_compacted_bottom_level_acceleration_structure(scene_non_compacted_bottom_level_acceleration_structures[non_compacted_bottom_level_acceleration_structure_index], static_cast<uint32_t>(bottom_level_acceleration_structure_geometries.size()), bottom_level_acceleration_structure_geometries.data(), non_compacted_bottom_level_acceleration_structure_build_scratch_buffer, compacted_bottom_level_acceleration_structure_size_query_pool, non_compacted_bottom_level_acceleration_structure_index);
+
+                                ++non_compacted_bottom_level_acceleration_structure_index;
+                            }
+                        }
+                        assert(scene_non_compacted_bottom_level_acceleration_structures.size() == non_compacted_bottom_level_acceleration_structure_index);
+
+                        upload_command_buffer->build_non_compacted_bottom_level_acceleration_structure_pass_store(static_cast<uint32_t>(non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.size()), non_compacted_bottom_level_acceleration_structure_build_input_read_only_buffers.data());
+                    }
+                }
+
+                load_arena_vector<brx_storage_asset_buffer const *> uploaded_storage_asset_buffers(&load_arena);
+                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+                {
+                    Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+
+                    for (size_t subset_index = 0U; subset_index < scene_mesh.m_subsets.size(); ++subset_index)
+                    {
+                        Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[subset_index];
+
+                        uploaded_storage_asset_buffers.push_back(scene_mesh_subset.m_vertex_position_buffer);
+
+                        if (NULL != scene_mesh_subset.m_acceleration_structure_build_input_vertex_position_buffer)
+                        {
+                            uploaded_storage_asset_buffers.push_back(scene_mesh_subset.m_acceleration_structure_build_input_vertex_position_buffer);
+                        }
+
+                        if (!scene_mesh.m_skinned)
+                        {
+                            assert(NULL == scene_mesh_subset.m_vertex_varying_buffer);
+                            assert(NULL == scene_mesh_subset.m_vertex_joint_buffer);
+                        }
+                        else
+                        {
+                            uploaded_storage_asset_buffers.push_back(scene_mesh_subset.m_vertex_varying_buffer);
+                            uploaded_storage_asset_buffers.push_back(scene_mesh_subset.m_vertex_joint_buffer);
+                        }
+
+                        uploaded_storage_asset_buffers.push_back(scene_mesh_subset.m_index_buffer);
+                    }
+                }
+
+                // Geometry Pool Buffer
+                if (NULL != this->m_geometry_pool_buffer)
+                {
+                    uploaded_storage_asset_buffers.push_back(this->m_geometry_pool_buffer);
+                }
+
+                // Place Holder Texture
+                {
+                    uploaded_storage_asset_buffers.push_back(this->m_place_holder_buffer);
+                }
+
+                // Scene Information Buffer
+                {
+                    if (NULL != this->m_scene_instance_information_buffer)
+                    {
+                        uploaded_storage_asset_buffers.push_back(this->m_scene_instance_information_buffer);
+                    }
+
+                    if (NULL != this->m_scene_geometry_information_buffer)
+                    {
+                        uploaded_storage_asset_buffers.push_back(this->m_scene_geometry_information_buffer);
+                    }
+                }
+
+                // the scene textures are released and acquired by "update_texture_streaming"
+                load_arena_vector<brx_sampled_asset_image const *> uploaded_sampled_asset_images(&load_arena);
+                load_arena_vector<uint32_t> uploaded_destination_mip_levels(&load_arena);
+
+                // Place Holder Texture
+                {
+                    uploaded_sampled_asset_images.push_back(this->m_place_holder_texture);
+
+                    uploaded_destination_mip_levels.push_back(0U);
+                }
+
+                assert(uploaded_sampled_asset_images.size() == uploaded_destination_mip_levels.size());
+
+                // release
+                upload_command_buffer->release(static_cast<uint32_t>(uploaded_storage_asset_buffers.size()), uploaded_storage_asset_buffers.data(), static_cast<uint32_t>(uploaded_sampled_asset_images.size()), &uploaded_sampled_asset_images[0], uploaded_destination_mip_levels.data(), 0U, NULL);
+
+                // acquire
+                graphics_command_buffer->acquire(static_cast<uint32_t>(uploaded_storage_asset_buffers.size()), uploaded_storage_asset_buffers.data(), static_cast<uint32_t>(uploaded_sampled_asset_images.size()), &uploaded_sampled_asset_images[0], uploaded_destination_mip_levels.data(), 0U, NULL);
+            }
+
+            upload_command_buffer->end();
+
+            graphics_command_buffer->end();
+
+            upload_queue->submit_and_signal(upload_command_buffer);
+
+            device->reset_fence(fence);
+
+            graphics_queue->wait_and_submit(upload_command_buffer, graphics_command_buffer, fence);
+
+            device->wait_for_fence(fence);
+
+            staging_upload_arena.destroy(device);
+
+            for (brx_scratch_buffer *const scratch_buffer : scratch_buffers)
+            {
+                device->destroy_scratch_buffer(scratch_buffer);
+            }
+
+            scratch_buffers.clear();
+
+            // the bottom level acceleration structure has been built and the float vertex positions are no longer used
+            for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+            {
+                Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+
+                for (size_t subset_index = 0U; subset_index < scene_mesh.m_subsets.size(); ++subset_index)
+                {
+                    Demo_Mesh_Subset &scene_mesh_subset = scene_mesh.m_subsets[subset_index];
+
+                    if (NULL != scene_mesh_subset.m_acceleration_structure_build_input_vertex_position_buffer)
+                    {
+                        device->destroy_storage_asset_buffer(scene_mesh_subset.m_acceleration_structure_build_input_vertex_position_buffer);
+                        scene_mesh_subset.m_acceleration_structure_build_input_vertex_position_buffer = NULL;
+                    }
+                }
+            }
+        }
+
+        // step 2
+        // compact bottom level acceleration structure
+        // build top level acceleration structure
+        {
+            load_arena_vector<brx_scratch_buffer *> scratch_buffers(&load_arena);
+
+            device->reset_upload_command_buffer(upload_command_buffer);
+
+            device->reset_graphics_command_buffer(graphics_command_buffer);
+
+            upload_command_buffer->begin();
+
+            graphics_command_buffer->begin();
+
+            // compact bottom level acceleration structure
+            {
+                load_arena_vector<brx_compacted_bottom_level_acceleration_structure *> uploaded_compacted_bottom_level_acceleration_structures(static_cast<size_t>(scene_non_compacted_bottom_level_acceleration_structures.size()), &load_arena);
+
+                uint32_t non_compacted_bottom_level_acceleration_structure_index = 0U;
+                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+                {
+                    Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+
+                    if (!scene_mesh.m_skinned)
+                    {
+                        uint32_t const compacted_bottom_level_acceleration_structure_size = device->get_compacted_bottom_level_acceleration_structure_size_query_pool_result(compacted_bottom_level_acceleration_structure_size_query_pool, non_compacted_bottom_level_acceleration_structure_index);
+
+                        scene_mesh.m_compacted_bottom_level_acceleration_structure = device->create_compacted_bottom_level_acceleration_structure(compacted_bottom_level_acceleration_structure_size);
+                        uploaded_compacted_bottom_level_acceleration_structures[non_compacted_bottom_level_acceleration_structure_index] = scene_mesh.m_compacted_bottom_level_acceleration_structure;
+
+                        upload_command_buffer->compact_bottom_level_acceleration_structure(scene_mesh.m_compacted_bottom_level_acceleration_structure, scene_non_compacted_bottom_level_acceleration_structures[non_compacted_bottom_level_acceleration_structure_index]);
+
+                        ++non_compacted_bottom_level_acceleration_structure_index;
+                    }
+                    else
+                    {
+                        scene_mesh.m_compacted_bottom_level_acceleration_structure = NULL;
+                    }
+                }
+                assert(scene_non_compacted_bottom_level_acceleration_structures.size() == non_compacted_bottom_level_acceleration_structure_index);
+                assert(uploaded_compacted_bottom_level_acceleration_structures.size() == non_compacted_bottom_level_acceleration_structure_index);
+
+                // release
+                upload_command_buffer->release(0U, NULL, 0U, NULL, NULL, static_cast<uint32_t>(uploaded_compacted_bottom_level_acceleration_structures.size()), uploaded_compacted_bottom_level_acceleration_structures.data());
+
+                // acquire
+                graphics_command_buffer->acquire(0U, NULL, 0U, NULL, NULL, static_cast<uint32_t>(uploaded_compacted_bottom_level_acceleration_structures.size()), uploaded_compacted_bottom_level_acceleration_structures.data());
+            }
+
+            // build intermediate bottom level acceleration structure
+            {
+                load_arena_vector<brx_intermediate_bottom_level_acceleration_structure *> built_intermediate_bottom_level_acceleration_structures(&load_arena);
+
+                uint32_t intermediate_bottom_level_acceleration_structure_index = 0U;
+                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+                {
+                    Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+
+                    if (!scene_mesh.m_skinned)
+                    {
+                        for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
+                        {
+                            Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+
+                            assert(scene_mesh_instance.m_skinned_subsets.empty());
+
+                            scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure = NULL;
+
+                            scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer = NULL;
+                        }
+                    }
+                    else
+                    {
+                        for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
+                        {
+                            Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+
+                            assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
+
+                            load_arena_vector<BRX_BOTTOM_LEVEL_ACCELERATION_STRUCTURE_GEOMETRY> bottom_level_acceleration_structure_geometries(scene_mesh_instance.m_skinned_subsets.size(), &load_arena);
+
+                            for (size_t mesh_subset_index = 0U; mesh_subset_index < scene_mesh_instance.m_skinned_subsets.size(); ++mesh_subset_index)
+                            {
+                                Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[mesh_subset_index];
+
+                                bottom_level_acceleration_structure_geometries[mesh_subset_index] = BRX_BOTTOM_LEVEL_ACCELERATION_STRUCTURE_GEOMETRY{true,
+                                                                                                                                                     BRX_GRAPHICS_PIPELINE_VERTEX_ATTRIBUTE_FORMAT_R32G32B32_SFLOAT,
+                                                                                                                                                     sizeof(scene_mesh_vertex_position_binding),
+                                                                                                                                                     scene_mesh_subset.m_vertex_count,
+                                                                                                                                                     scene_mesh_subset.m_vertex_position_buffer->get_acceleration_structure_build_input_read_only_buffer(),
+                                                                                                                                                     scene_mesh_subset.m_index_type,
+                                                                                                                                                     scene_mesh_subset.m_index_count,
+                                                                                                                                                     scene_mesh_subset.m_index_buffer->get_acceleration_structure_build_input_read_only_buffer()};
+                            }
+
+                            uint32_t intermediate_bottom_level_acceleration_structure_size = -1;
+                            uint32_t intermediate_bottom_level_acceleration_structure_build_scratch_size = -1;
+                            uint32_t intermediate_bottom_level_acceleration_structure_update_scratch_size = -1;
+                            device->get_intermediate_bottom_level_acceleration_structure_size(static_cast<uint32_t>(bottom_level_acceleration_structure_geometries.size()), bottom_level_acceleration_structure_geometries.data(), &intermediate_bottom_level_acceleration_structure_size, &intermediate_bottom_level_acceleration_structure_build_scratch_size, &intermediate_bottom_level_acceleration_structure_update_scratch_size);
+
+                            scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure = device->create_intermediate_bottom_level_acceleration_structure(intermediate_bottom_level_acceleration_structure_size);
+                            built_intermediate_bottom_level_acceleration_structures.push_back(scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+
+                            brx_scratch_buffer *const intermediate_bottom_level_acceleration_structure_build_scratch_buffer = device->create_scratch_buffer(intermediate_bottom_level_acceleration_structure_build_scratch_size);
+                            scratch_buffers.push_back(intermediate_bottom_level_acceleration_structure_build_scratch_buffer);
+
+                            graphics_command_buffer->build_intermediate_bottom_level_acceleration_structure(scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure, static_cast<uint32_t>(bottom_level_acceleration_structure_geometries.size()), bottom_level_acceleration_structure_geometries.data(), intermediate_bottom_level_acceleration_structure_build_scratch_buffer);
+
+                            scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer = device->create_scratch_buffer(intermediate_bottom_level_acceleration_structure_update_scratch_size);
+
+                            ++intermediate_bottom_level_acceleration_structure_index;
+                        }
+                    }
+                }
+                assert(built_intermediate_bottom_level_acceleration_structures.size() == intermediate_bottom_level_acceleration_structure_index);
+
+                graphics_command_buffer->build_intermediate_bottom_level_acceleration_structure_store(static_cast<uint32_t>(built_intermediate_bottom_level_acceleration_structures.size()), built_intermediate_bottom_level_acceleration_structures.data());
+            }
+
+            // build top level acceleration structure
+            {
+                uint32_t const scene_instance_count = this->m_scene_instance_count;
+
+                // the empty top level acceleration structure is built when no scene is loaded, and the rays always miss
+                // the instance upload buffer can NOT be empty
+                for (uint32_t frame_throttling_index = 0U; frame_throttling_index < FRAME_THROTTLING_COUNT; ++frame_throttling_index)
+                {
+                    this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index] = device->create_top_level_acceleration_structure_instance_upload_buffer(std::max(scene_instance_count, 1U));
+                }
+
+                // we use the 0 index when initializing
+                constexpr uint32_t const frame_throttling_index = 0U;
+
+                uint32_t top_level_acceleration_structure_size = -1;
+                uint32_t top_level_acceleration_structure_build_scratch_size = -1;
+                uint32_t top_level_acceleration_structure_update_scratch_size = -1;
+                device->get_top_level_acceleration_structure_size(scene_instance_count, &top_level_acceleration_structure_size, &top_level_acceleration_structure_build_scratch_size, &top_level_acceleration_structure_update_scratch_size);
+
+                this->m_scene_top_level_acceleration_structure = device->create_top_level_acceleration_structure(top_level_acceleration_structure_size);
+
+                uint32_t scene_instance_index = 0U;
+                for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+                {
+                    Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+
+                    if (!scene_mesh.m_skinned)
+                    {
+                        for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
+                        {
+                            Demo_Mesh_Instance const &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+
+                            assert(NULL == scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+
+                            BRX_TOP_LEVEL_ACCELERATION_STRUCTURE_INSTANCE top_level_acceleration_structure_instance = {
+                                {},
+                                scene_instance_index,
+                                0XFFU,
+                                true,
+                                false,
+                                false,
+                                false,
+                                scene_mesh.m_compacted_bottom_level_acceleration_structure->get_bottom_level_acceleration_structure()};
+
+                            DirectX::XMStoreFloat3x4(reinterpret_cast<DirectX::XMFLOAT3X4 *>(&top_level_acceleration_structure_instance.transform_matrix), DirectX::XMLoadFloat4x4(&scene_mesh_instance.m_model_transform));
+
+                            this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index]->write_instance(scene_instance_index, &top_level_acceleration_structure_instance);
+
+                            ++scene_instance_index;
+                        }
+                    }
+                    else
+                    {
+                        assert(NULL == scene_mesh.m_compacted_bottom_level_acceleration_structure);
+
+                        for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
+                        {
+                            Demo_Mesh_Instance const &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+
+                            BRX_TOP_LEVEL_ACCELERATION_STRUCTURE_INSTANCE top_level_acceleration_structure_instance = {
+                                {},
+                                scene_instance_index,
+                                0XFFU,
+                                true,
+                                false,
+                                false,
+                                false,
+                                scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure->get_bottom_level_acceleration_structure()};
+
+                            DirectX::XMStoreFloat3x4(reinterpret_cast<DirectX::XMFLOAT3X4 *>(&top_level_acceleration_structure_instance.transform_matrix), DirectX::XMLoadFloat4x4(&scene_mesh_instance.m_model_transform));
+
+                            this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index]->write_instance(scene_instance_index, &top_level_acceleration_structure_instance);
+
+                            ++scene_instance_index;
+                        }
+                    }
+                }
+                assert(scene_instance_count == scene_instance_index);
+
+                brx_scratch_buffer *const top_level_acceleration_structure_build_scratch_buffer = device->create_scratch_buffer(top_level_acceleration_structure_build_scratch_size);
+                scratch_buffers.push_back(top_level_acceleration_structure_build_scratch_buffer);
+
+                graphics_command_buffer->build_top_level_acceleration_structure(this->m_scene_top_level_acceleration_structure, scene_instance_count, this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index], top_level_acceleration_structure_build_scratch_buffer);
+
+                graphics_command_buffer->build_top_level_acceleration_structure_store(this->m_scene_top_level_acceleration_structure);
+
+                this->m_scene_top_level_acceleration_structure_update_scratch_buffer = device->create_scratch_buffer(top_level_acceleration_structure_update_scratch_size);
+            }
+
+            upload_command_buffer->end();
+
+            graphics_command_buffer->end();
+
+            upload_queue->submit_and_signal(upload_command_buffer);
+
+            device->reset_fence(fence);
+
+            graphics_queue->wait_and_submit(upload_command_buffer, graphics_command_buffer, fence);
+
+            device->wait_for_fence(fence);
+
+            if (!scene_non_compacted_bottom_level_acceleration_structures.empty())
+            {
+                device->destroy_compacted_bottom_level_acceleration_structure_size_query_pool(compacted_bottom_level_acceleration_structure_size_query_pool);
+            }
+            else
+            {
+                assert(NULL == compacted_bottom_level_acceleration_structure_size_query_pool);
+            }
+
+            for (uint32_t non_compacted_bottom_level_acceleration_structure_index = 0U; non_compacted_bottom_level_acceleration_structure_index < scene_non_compacted_bottom_level_acceleration_structures.size(); ++non_compacted_bottom_level_acceleration_structure_index)
+            {
+                device->destroy_non_compacted_bottom_level_acceleration_structure(scene_non_compacted_bottom_level_acceleration_structures[non_compacted_bottom_level_acceleration_structure_index]);
+            }
+            scene_non_compacted_bottom_level_acceleration_structures.clear();
+
+            for (brx_scratch_buffer *const scratch_buffer : scratch_buffers)
+            {
+                device->destroy_scratch_buffer(scratch_buffer);
+            }
+
+            scratch_buffers.clear();
+        }
+
+        device->destroy_fence(fence);
+
+        device->destroy_upload_command_buffer(upload_command_buffer);
+
+        device->destroy_graphics_command_buffer(graphics_command_buffer);
+
+        device->destroy_upload_queue(upload_queue);
+
+        device->destroy_graphics_queue(graphics_queue);
+
+#ifndef NDEBUG
+        // the load time statistics are only reported by the debug build
+        printf("Load Arena: %llu allocations (%.3f MiB) from %u chunks\n", static_cast<unsigned long long>(load_arena.get_allocation_count()), static_cast<double>(load_arena.get_allocation_size()) / (1024.0 * 1024.0), static_cast<unsigned>(load_arena.get_chunk_count()));
+#endif
+
+        load_arena.destroy();
+    }
+
+    // Texture Streaming
+    {
+        if (!this->m_streaming_textures.empty())
+        {
+            this->m_texture_streaming_upload_command_buffer = device->create_upload_command_buffer();
+
+            this->m_texture_streaming_graphics_command_buffer = device->create_graphics_command_buffer();
+
+            this->m_texture_streaming_upload_queue = device->create_upload_queue();
+
+            this->m_texture_streaming_graphics_queue = device->create_graphics_queue();
+
+            this->m_texture_streaming_fence = device->create_fence(true);
+
+            // each batch retires at most "texture_streaming_batch_texture_count" textures, and uploads at most all mips of them
+            uint32_t max_mip_level_count = 1U;
+            for (size_t streaming_texture_index = 0U; streaming_texture_index < this->m_streaming_textures.size(); ++streaming_texture_index)
+            {
+                max_mip_level_count = std::max(max_mip_level_count, static_cast<uint32_t>(this->m_streaming_textures[streaming_texture_index].m_header.mip_levels));
+            }
+
+            this->m_texture_streaming_retired_sampled_images.reserve(texture_streaming_batch_texture_count);
+            this->m_texture_streaming_uploaded_sampled_asset_images.reserve(static_cast<size_t>(texture_streaming_batch_texture_count) * max_mip_level_count);
+            this->m_texture_streaming_uploaded_destination_mip_levels.reserve(static_cast<size_t>(texture_streaming_batch_texture_count) * max_mip_level_count);
+        }
+        else
+        {
+            this->m_texture_streaming_upload_command_buffer = NULL;
+
+            this->m_texture_streaming_graphics_command_buffer = NULL;
+
+            this->m_texture_streaming_upload_queue = NULL;
+
+            this->m_texture_streaming_graphics_queue = NULL;
+
+            this->m_texture_streaming_fence = NULL;
+        }
+    }
+
+    // Sampler
+    {
+        this->m_sampler = device->create_sampler(BRX_SAMPLER_FILTER_LINEAR);
+    }
+
+    // Uniform Buffer
+    {
+        this->m_uniform_upload_buffer_offset_alignment = device->get_uniform_upload_buffer_offset_alignment();
+
+        this->m_common_gbuffer_pipeline_ambient_occlusion_pipeline_none_update_uniform_buffer = device->create_uniform_upload_buffer(tbb_align_up(static_cast<uint32_t>(sizeof(common_none_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * FRAME_THROTTLING_COUNT);
+
+        this->m_skin_pipeline_per_mesh_instance_update_uniform_buffer_frame_size = 0U;
+        for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+        {
+            Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+
+            for (size_t instance_index = 0U; instance_index < scene_mesh.m_instances.size(); ++instance_index)
+            {
+                Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[instance_index];
+
+                if (!scene_mesh.m_skinned)
+                {
+                    scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_joint_count = 0U;
+                }
+                else
+                {
+                    // only the joints of the skeleton are uploaded rather than the whole MAX_JOINT_COUNT
+                    scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_joint_count = scene_mesh_instance.m_animation_skeleton.get_pose(0U).get_joint_count();
+                    assert(scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_joint_count <= MAX_JOINT_COUNT);
+
+                    this->m_skin_pipeline_per_mesh_instance_update_uniform_buffer_frame_size += tbb_align_up(static_cast<uint32_t>(sizeof(skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding::g_dual_quaternions[0]) * 2U * scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_joint_count), this->m_uniform_upload_buffer_offset_alignment);
+                }
+
+                scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_dynamic_offset = 0U;
+            }
+        }
+
+        // the range of the dynamic uniform buffer is always the whole binding
+        // the tail is padded to make sure that the range of the last allocation is within the buffer
+        this->m_skin_pipeline_per_mesh_instance_update_uniform_buffer = device->create_uniform_upload_buffer(this->m_skin_pipeline_per_mesh_instance_update_uniform_buffer_frame_size * FRAME_THROTTLING_COUNT + tbb_align_up(static_cast<uint32_t>(sizeof(skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment));
+    }
+
+    // Descriptor
+    {
+        // Skin Pipeline
+        {
+            {
+                this->m_skin_pipeline_per_mesh_instance_update_descriptor_set = device->create_descriptor_set(skin_pipeline_per_mesh_instance_update_descriptor_set_layout);
+
+                constexpr uint32_t const dynamic_uniform_buffers_range = sizeof(skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding);
+                device->write_descriptor_set(this->m_skin_pipeline_per_mesh_instance_update_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER, 0U, 1U, &this->m_skin_pipeline_per_mesh_instance_update_uniform_buffer, &dynamic_uniform_buffers_range, NULL, NULL, NULL, NULL, NULL, NULL);
+            }
+
+            for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+            {
+                Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+
+                if (!scene_mesh.m_skinned)
+                {
+                    for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
+                    {
+                        Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+
+                        assert(scene_mesh_instance.m_skinned_subsets.empty());
+                    }
+                }
+                else
+                {
+                    for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
+                    {
+                        Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+
+                        assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
+
+                        for (size_t mesh_subset_index = 0U; mesh_subset_index < scene_mesh_instance.m_skinned_subsets.size(); ++mesh_subset_index)
+                        {
+                            Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[mesh_subset_index];
+
+                            Demo_Mesh_Skinned_Subset &scene_mesh_skinned_subset = scene_mesh_instance.m_skinned_subsets[mesh_subset_index];
+
+                            {
+                                scene_mesh_skinned_subset.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set = device->create_descriptor_set(skin_pipeline_per_mesh_skinned_subset_update_descriptor_set_layout);
+
+                                brx_read_only_storage_buffer const *const read_only_storage_buffers[] = {
+                                    scene_mesh_subset.m_vertex_position_buffer->get_read_only_storage_buffer(),
+                                    scene_mesh_subset.m_vertex_varying_buffer->get_read_only_storage_buffer(),
+                                    scene_mesh_subset.m_vertex_joint_buffer->get_read_only_storage_buffer()};
+                                device->write_descriptor_set(scene_mesh_skinned_subset.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_READ_ONLY_STORAGE_BUFFER, 0U, sizeof(read_only_storage_buffers) / sizeof(read_only_storage_buffers[0]), NULL, NULL, read_only_storage_buffers, NULL, NULL, NULL, NULL, NULL);
+
+                                brx_storage_buffer const *const storage_buffers[] = {
+                                    scene_mesh_skinned_subset.m_skinned_vertex_position_buffer->get_storage_buffer(),
+                                    scene_mesh_skinned_subset.m_skinned_vertex_varying_buffer->get_storage_buffer()};
+                                device->write_descriptor_set(scene_mesh_skinned_subset.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set, 1U, BRX_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0U, sizeof(storage_buffers) / sizeof(storage_buffers[0]), NULL, NULL, NULL, storage_buffers, NULL, NULL, NULL, NULL);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // GBuffer Pipeline
+        {
+            this->m_gbuffer_pipeline_none_update_descriptor_set = device->create_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set_layout);
+            {
+                constexpr uint32_t const dynamic_uniform_buffers_range = sizeof(common_none_update_set_uniform_buffer_binding);
+                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER, 0U, 1U, &this->m_common_gbuffer_pipeline_ambient_occlusion_pipeline_none_update_uniform_buffer, &dynamic_uniform_buffers_range, NULL, NULL, NULL, NULL, NULL, NULL);
+            }
+            {
+                brx_top_level_acceleration_structure const *const top_level_acceleration_structures[] = {
+                    this->m_scene_top_level_acceleration_structure};
+                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set, 1U, BRX_DESCRIPTOR_TYPE_TOP_LEVEL_ACCELERATION_STRUCTURE, 0U, sizeof(top_level_acceleration_structures) / sizeof(top_level_acceleration_structures[0]), NULL, NULL, NULL, NULL, NULL, NULL, NULL, &top_level_acceleration_structures[0]);
+            }
+            {
+                // the place holder is used when the scene is empty (and the rays always miss)
+                brx_read_only_storage_buffer const *const read_only_storage_buffers[SCENE_INFORMATION_BUFFER_COUNT] = {
+                    (NULL != this->m_scene_instance_information_buffer) ? this->m_scene_instance_information_buffer->get_read_only_storage_buffer() : this->m_place_holder_buffer->get_read_only_storage_buffer(),
+                    (NULL != this->m_scene_geometry_information_buffer) ? this->m_scene_geometry_information_buffer->get_read_only_storage_buffer() : this->m_place_holder_buffer->get_read_only_storage_buffer()};
+                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set, 2U, BRX_DESCRIPTOR_TYPE_READ_ONLY_STORAGE_BUFFER, 0U, sizeof(read_only_storage_buffers) / sizeof(read_only_storage_buffers[0]), NULL, NULL, read_only_storage_buffers, NULL, NULL, NULL, NULL, NULL);
+            }
+            {
+                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set, 3U, BRX_DESCRIPTOR_TYPE_SAMPLER, 0U, 1U, NULL, NULL, NULL, NULL, NULL, NULL, &this->m_sampler, NULL);
+            }
+        }
+
+        // Ambient Occlusion Pipeline
+        {
+            this->m_ambient_occlusion_pipeline_none_update_descriptor_set = device->create_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set_layout);
+            {
+                constexpr uint32_t const dynamic_uniform_buffers_range = sizeof(common_none_update_set_uniform_buffer_binding);
+                device->write_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_DYNAMIC_UNIFORM_BUFFER, 0U, 1U, &this->m_common_gbuffer_pipeline_ambient_occlusion_pipeline_none_update_uniform_buffer, &dynamic_uniform_buffers_range, NULL, NULL, NULL, NULL, NULL, NULL);
+            }
+            {
+                brx_top_level_acceleration_structure const *const top_level_acceleration_structures[] = {
+                    this->m_scene_top_level_acceleration_structure};
+                device->write_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set, 1U, BRX_DESCRIPTOR_TYPE_TOP_LEVEL_ACCELERATION_STRUCTURE, 0U, sizeof(top_level_acceleration_structures) / sizeof(top_level_acceleration_structures[0]), NULL, NULL, NULL, NULL, NULL, NULL, NULL, &top_level_acceleration_structures[0]);
+            }
+        }
+    }
+
+    device->destroy_descriptor_set_layout(skin_pipeline_per_mesh_instance_update_descriptor_set_layout);
+    skin_pipeline_per_mesh_instance_update_descriptor_set_layout = NULL;
+    device->destroy_descriptor_set_layout(skin_pipeline_per_mesh_skinned_subset_update_descriptor_set_layout);
+    skin_pipeline_per_mesh_skinned_subset_update_descriptor_set_layout = NULL;
+    device->destroy_descriptor_set_layout(gbuffer_pipeline_none_update_bindless_buffer_descriptor_set_layout);
+    gbuffer_pipeline_none_update_bindless_buffer_descriptor_set_layout = NULL;
+    device->destroy_descriptor_set_layout(gbuffer_pipeline_none_update_bindless_texture_descriptor_set_layout);
+    gbuffer_pipeline_none_update_bindless_texture_descriptor_set_layout = NULL;
+
+    // Init Intermediate Images
+    this->m_intermediate_width = 0U;
+    this->m_intermediate_height = 0U;
+    this->m_gbuffer_depth_image = NULL;
+    this->m_gbuffer_normal_image = NULL;
+    this->m_ambient_occlusion_image = NULL;
+
+    // Init Camera
+    g_camera.SetRightHanded(true);
+    g_camera.SetScalers(2.0F, 5.0F);
+    g_camera.SetRotateButtons(false, false, true, false);
+    DirectX::XMFLOAT3 eye_position(0.0F, 0.5F, 5.0F);
+    DirectX::XMFLOAT3 eye_direction(0.0F, 0.0523359776F, -0.998629570F);
+    DirectX::XMFLOAT3 up_direction(0.0F, 1.0F, 0.0F);
+    DirectX::XMFLOAT3 look_at_position(eye_position.x + eye_direction.x, eye_position.y + eye_direction.y, eye_position.z + eye_direction.z);
+    g_camera.SetViewParams(DirectX::XMLoadFloat3(&eye_position), DirectX::XMLoadFloat3(&look_at_position), DirectX::XMLoadFloat3(&up_direction));
+    float fov = 0.7F;
+    float near_plane = 0.01F;
+    float far_plane = 1000.0F;
+    g_camera.SetProjParams(fov, 1.0F, near_plane, far_plane);
+
+    // Init Animation Time
+    this->m_animation_time = 0.0F;
+
+    // the skinned vertices have NOT been written by the skin pass, and the acceleration structures should be updated by the first frame
+    this->m_acceleration_structure_animation_frame_index = SIZE_MAX;
+
+    // Init Draw Lists and Worker Pool
+    {
+        // the scene meshes are NOT changed after the loading, and the pointers to the instances remain valid
+        for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+        {
+            Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+
+            for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
+            {
+                Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+
+                if (scene_mesh.m_skinned)
+                {
+                    this->m_skinned_mesh_instances.push_back(&scene_mesh_instance);
+
+                    // the dispatches of the skin pass and the inputs of the bottom level acceleration structure updates, in the same order as the skinned instances
+                    assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
+
+                    for (size_t subset_index = 0U; subset_index < scene_mesh_instance.m_skinned_subsets.size(); ++subset_index)
+                    {
+                        Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[subset_index];
+
+                        Demo_Mesh_Skinned_Subset const &scene_mesh_skinned_subset = scene_mesh_instance.m_skinned_subsets[subset_index];
+
+                        this->m_skin_pass_storage_buffers.push_back(scene_mesh_skinned_subset.m_skinned_vertex_position_buffer->get_storage_buffer());
+                        this->m_skin_pass_storage_buffers.push_back(scene_mesh_skinned_subset.m_skinned_vertex_varying_buffer->get_storage_buffer());
+
+                        uint32_t const vertex_count = scene_mesh_subset.m_vertex_count;
+
+                        Demo_Skin_Pass_Dispatch skin_pass_dispatch;
+                        skin_pass_dispatch.m_mesh_instance = &scene_mesh_instance;
+                        skin_pass_dispatch.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set = scene_mesh_skinned_subset.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set;
+                        skin_pass_dispatch.m_group_count_x = (vertex_count <= MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION) ? vertex_count : MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION;
+                        skin_pass_dispatch.m_group_count_y = (vertex_count + MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION - 1U) / MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION;
+                        assert(skin_pass_dispatch.m_group_count_x <= MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION);
+                        assert(skin_pass_dispatch.m_group_count_y <= MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION);
+                        this->m_skin_pass_dispatches.push_back(skin_pass_dispatch);
+
+                        this->m_update_intermediate_bottom_level_acceleration_structure_geometry_vertex_position_buffers.push_back(scene_mesh_skinned_subset.m_skinned_vertex_position_buffer->get_acceleration_structure_build_input_read_only_buffer());
+                    }
+
+                    this->m_update_intermediate_bottom_level_acceleration_structures.push_back(scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+                }
+
+                // the same order as the instances of the top level acceleration structure
+                Demo_Scene_Instance scene_instance;
+                scene_instance.m_mesh = &scene_mesh;
+                scene_instance.m_mesh_instance = &scene_mesh_instance;
+                this->m_scene_instances.push_back(scene_instance);
+            }
+        }
+        assert(this->m_scene_instance_count == this->m_scene_instances.size());
+
+        assert(this->m_skin_pass_storage_buffers.size() == 2U * this->m_skin_pass_dispatches.size());
+
+        this->m_skin_pass_storage_buffer_load_operations.assign(this->m_skin_pass_storage_buffers.size(), BRX_COMPUTE_PASS_STORAGE_BUFFER_LOAD_OPERATION_DONT_CARE);
+        this->m_skin_pass_storage_buffer_store_operations.assign(this->m_skin_pass_storage_buffers.size(), BRX_COMPUTE_PASS_STORAGE_BUFFER_STORE_OPERATION_FLUSH_FOR_READ_ONLY_STORAGE_BUFFER_AND_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BUFFER);
+
+        // "hardware_concurrency" may return zero when it is not computable, and the render thread is also used as a worker thread
+        uint32_t const hardware_concurrency = std::max(1U, static_cast<uint32_t>(std::thread::hardware_concurrency()));
+
+        this->m_draw_worker_pool.init(hardware_concurrency - 1U);
+
+#ifndef NDEBUG
+        this->get_draw_list_storage(this->m_draw_list_datas, this->m_draw_list_capacities);
+#endif
+    }
+
+    // Init Stress Report
+    this->m_stress_report_frame_count = 0U;
+    this->m_stress_report_interval_time = 0.0;
+    for (uint32_t stress_report_pass_index = 0U; stress_report_pass_index < STRESS_REPORT_PASS_COUNT; ++stress_report_pass_index)
+    {
+        this->m_stress_report_pass_tick_counts[stress_report_pass_index] = 0U;
+    }
+}
+
+void Demo::destroy(brx_device *device)
+{
+    // Draw Lists and Worker Pool
+    {
+        this->m_draw_worker_pool.destroy();
+
+        mcrt_vector<Demo_Mesh_Instance *>().swap(this->m_skinned_mesh_instances);
+        mcrt_vector<Demo_Scene_Instance>().swap(this->m_scene_instances);
+
+        mcrt_vector<brx_storage_buffer const *>().swap(this->m_skin_pass_storage_buffers);
+        mcrt_vector<BRX_COMPUTE_PASS_STORAGE_BUFFER_LOAD_OPERATION>().swap(this->m_skin_pass_storage_buffer_load_operations);
+        mcrt_vector<BRX_COMPUTE_PASS_STORAGE_BUFFER_STORE_OPERATION>().swap(this->m_skin_pass_storage_buffer_store_operations);
+        mcrt_vector<Demo_Skin_Pass_Dispatch>().swap(this->m_skin_pass_dispatches);
+        mcrt_vector<brx_intermediate_bottom_level_acceleration_structure *>().swap(this->m_update_intermediate_bottom_level_acceleration_structures);
+        mcrt_vector<brx_acceleration_structure_build_input_read_only_buffer const *>().swap(this->m_update_intermediate_bottom_level_acceleration_structure_geometry_vertex_position_buffers);
+    }
+
+    // Texture Streaming
+    {
+        this->destroy_texture_streaming(device);
+    }
+
+    // Descriptor
+    {
+        // Skin Pipeline
+        {
+            device->destroy_descriptor_set(this->m_skin_pipeline_per_mesh_instance_update_descriptor_set);
+
+            for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+            {
+                Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+
+                if (!scene_mesh.m_skinned)
+                {
+                    for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
+                    {
+                        Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+
+                        assert(scene_mesh_instance.m_skinned_subsets.empty());
+                    }
+                }
+                else
+                {
+                    for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
+                    {
+                        Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+
+                        assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
+
+                        for (size_t mesh_subset_index = 0U; mesh_subset_index < scene_mesh_instance.m_skinned_subsets.size(); ++mesh_subset_index)
+                        {
+                            Demo_Mesh_Skinned_Subset &scene_mesh_skinned_subset = scene_mesh_instance.m_skinned_subsets[mesh_subset_index];
+
+                            device->destroy_descriptor_set(scene_mesh_skinned_subset.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set);
+                        }
+                    }
+                }
+            }
+        }
+
+        // GBuffer Pipeline
+        {
+            device->destroy_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set);
+
+            device->destroy_descriptor_set(this->m_gbuffer_pipeline_none_update_bindless_buffer_descriptor_set);
+
+            device->destroy_descriptor_set(this->m_gbuffer_pipeline_none_update_bindless_texture_descriptor_set);
+
+            this->m_bindless_buffer_allocator.destroy();
+
+            this->m_bindless_texture_allocator.destroy();
+
+            device->destroy_descriptor_set_layout(this->m_gbuffer_pipeline_none_update_descriptor_set_layout);
+        }
+
+        // Ambient Occlusion Pipeline
+        {
+            device->destroy_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set);
+
+            device->destroy_descriptor_set_layout(this->m_ambient_occlusion_pipeline_none_update_descriptor_set_layout);
+        }
+    }
+
+    // Uniform Buffer
+    {
+        device->destroy_uniform_upload_buffer(this->m_common_gbuffer_pipeline_ambient_occlusion_pipeline_none_update_uniform_buffer);
+
+        device->destroy_uniform_upload_buffer(this->m_skin_pipeline_per_mesh_instance_update_uniform_buffer);
+    }
+
+    // Sampler
+    {
+        device->destroy_sampler(this->m_sampler);
+    }
+
+    // Place Holder Buffer
+    {
+        device->destroy_storage_asset_buffer(this->m_place_holder_buffer);
+    }
+
+    // Place Holder Texture
+    {
+        device->destroy_sampled_asset_image(this->m_place_holder_texture);
+    }
+
+    // Scene Information Buffer
+    {
+        if (NULL != this->m_scene_instance_information_buffer)
+        {
+            device->destroy_storage_asset_buffer(this->m_scene_instance_information_buffer);
+        }
+
+        if (NULL != this->m_scene_geometry_information_buffer)
+        {
+            device->destroy_storage_asset_buffer(this->m_scene_geometry_information_buffer);
+        }
+    }
+
+    // Asset
+    {
+        for (size_t scene_texture_index = 0U; scene_texture_index < this->m_scene_textures.size(); ++scene_texture_index)
+        {
+            brx_sampled_asset_image *const material_texture = this->m_scene_textures[scene_texture_index];
+
+            assert(NULL != material_texture);
+            device->destroy_sampled_asset_image(material_texture);
+        }
+
+        for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+        {
+            Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+
+            for (size_t subset_index = 0U; subset_index < scene_mesh.m_subsets.size(); ++subset_index)
+            {
+                Demo_Mesh_Subset &scene_mesh_subset = scene_mesh.m_subsets[subset_index];
+
+                device->destroy_storage_asset_buffer(scene_mesh_subset.m_vertex_position_buffer);
+
+                assert(NULL == scene_mesh_subset.m_acceleration_structure_build_input_vertex_position_buffer);
+
+                if (!scene_mesh.m_skinned)
+                {
+                    assert(NULL == scene_mesh_subset.m_vertex_varying_buffer);
+                    assert(NULL == scene_mesh_subset.m_vertex_joint_buffer);
+                }
+                else
+                {
+                    device->destroy_storage_asset_buffer(scene_mesh_subset.m_vertex_varying_buffer);
+                    device->destroy_storage_asset_buffer(scene_mesh_subset.m_vertex_joint_buffer);
+                }
+
+                device->destroy_storage_asset_buffer(scene_mesh_subset.m_index_buffer);
+            }
+
+            if (!scene_mesh.m_skinned)
+            {
+                device->destroy_compacted_bottom_level_acceleration_structure(scene_mesh.m_compacted_bottom_level_acceleration_structure);
+
+                for (size_t instance_index = 0U; instance_index < scene_mesh.m_instances.size(); ++instance_index)
+                {
+                    Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[instance_index];
+
+                    assert(scene_mesh_instance.m_skinned_subsets.empty());
+
+                    assert(NULL == scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+
+                    assert(NULL == scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer);
+                }
+            }
+            else
+            {
+                assert(NULL == scene_mesh.m_compacted_bottom_level_acceleration_structure);
+
+                for (size_t instance_index = 0U; instance_index < scene_mesh.m_instances.size(); ++instance_index)
+                {
+                    Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[instance_index];
+
+                    for (size_t subset_index = 0U; subset_index < scene_mesh.m_subsets.size(); ++subset_index)
+                    {
+                        Demo_Mesh_Skinned_Subset &scene_mesh_skinned_subset = scene_mesh_instance.m_skinned_subsets[subset_index];
+
+                        device->destroy_storage_intermediate_buffer(scene_mesh_skinned_subset.m_skinned_vertex_position_buffer);
+
+                        device->destroy_storage_intermediate_buffer(scene_mesh_skinned_subset.m_skinned_vertex_varying_buffer);
+                    }
+
+                    device->destroy_intermediate_bottom_level_acceleration_structure(scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+
+                    device->destroy_scratch_buffer(scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer);
+                }
+            }
+        }
+
+        if (NULL != this->m_geometry_pool_buffer)
+        {
+            device->destroy_storage_asset_buffer(this->m_geometry_pool_buffer);
+            this->m_geometry_pool_buffer = NULL;
+        }
+    }
+
+    // Top Level Acceleration Structure
+    {
+        device->destroy_top_level_acceleration_structure(this->m_scene_top_level_acceleration_structure);
+
+        for (uint32_t frame_throttling_index = 0U; frame_throttling_index < FRAME_THROTTLING_COUNT; ++frame_throttling_index)
+        {
+            device->destroy_top_level_acceleration_structure_instance_upload_buffer(this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index]);
+        }
+
+        device->destroy_scratch_buffer(this->m_scene_top_level_acceleration_structure_update_scratch_buffer);
+    }
+
+    // Render Pass and Pipeline
+    {
+        device->destroy_compute_pipeline(this->m_ambient_occlusion_pipeline);
+
+        device->destroy_pipeline_layout(this->m_ambient_occlusion_pipeline_layout);
+
+        device->destroy_compute_pipeline(this->m_gbuffer_pipeline);
+
+        device->destroy_pipeline_layout(this->m_gbuffer_pipeline_layout);
+
+        device->destroy_compute_pipeline(this->m_skin_pipeline);
+
+        device->destroy_pipeline_layout(this->m_skin_pipeline_layout);
+    }
+}
+
+void Demo::on_swap_chain_attach(brx_device *device, uint32_t swap_chain_image_width, uint32_t swap_chain_image_height)
+{
+    assert(0U == this->m_intermediate_width);
+    assert(0U == this->m_intermediate_height);
+
+    assert(NULL == this->m_gbuffer_depth_image);
+    assert(NULL == this->m_gbuffer_normal_image);
+    assert(NULL == this->m_ambient_occlusion_image);
+
+    this->m_intermediate_width = swap_chain_image_width;
+    this->m_intermediate_height = swap_chain_image_height;
+
+    // Intermediate Images
+    this->m_gbuffer_depth_image = device->create_storage_image(BRX_STORAGE_IMAGE_FORMAT_R32_UINT, this->m_intermediate_width, this->m_intermediate_height, true);
+    this->m_gbuffer_normal_image = device->create_storage_image(BRX_STORAGE_IMAGE_FORMAT_R32_UINT, this->m_intermediate_width, this->m_intermediate_height, true);
+    this->m_ambient_occlusion_image = device->create_storage_image(BRX_STORAGE_IMAGE_FORMAT_R16_SFLOAT, this->m_intermediate_width, this->m_intermediate_height, true);
+
+    // Descriptor
+    {
+        // GBuffer Pipeline
+        {
+            // The VkDescriptorSetLayout should still be valid when perform write update on VkDescriptorSet
+            assert(NULL != this->m_gbuffer_pipeline_none_update_descriptor_set_layout);
+            {
+                brx_storage_image const *const storage_images[] = {
+                    this->m_gbuffer_depth_image,
+                    this->m_gbuffer_normal_image};
+                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set, 4U, BRX_DESCRIPTOR_TYPE_STORAGE_IMAGE, 0U, sizeof(storage_images) / sizeof(storage_images[0]), NULL, NULL, NULL, NULL, NULL, &storage_images[0], NULL, NULL);
+            }
+        }
+
+        // Ambient Occlusion Pipeline
+        {
+            // The VkDescriptorSetLayout should still be valid when perform write update on VkDescriptorSet
+            assert(NULL != this->m_ambient_occlusion_pipeline_none_update_descriptor_set_layout);
             {
-                brx_top_level_acceleration_structure const *const top_level_acceleration_structures[] = {
-                    this->m_scene_top_level_acceleration_structure};
-                device->write_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set, 1U, BRX_DESCRIPTOR_TYPE_TOP_LEVEL_ACCELERATION_STRUCTURE, 0U, sizeof(top_level_acceleration_structures) / sizeof(top_level_acceleration_structures[0]), NULL, NULL, NULL, NULL, NULL, NULL, NULL, &top_level_acceleration_structures[0]);
+                brx_sampled_image const *const sampled_images[] = {
+                    this->m_gbuffer_depth_image->get_sampled_image(),
+                    this->m_gbuffer_normal_image->get_sampled_image()};
+                device->write_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set, 2U, BRX_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 0U, sizeof(sampled_images) / sizeof(sampled_images[0]), NULL, NULL, NULL, NULL, sampled_images, NULL, NULL, NULL);
+            }
+            {
+                brx_storage_image const *const storage_images[] = {
+                    this->m_ambient_occlusion_image};
+                device->write_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set, 3U, BRX_DESCRIPTOR_TYPE_STORAGE_IMAGE, 0U, sizeof(storage_images) / sizeof(storage_images[0]), NULL, NULL, NULL, NULL, NULL, &storage_images[0], NULL, NULL);
             }
         }
     }
 
-    device->destroy_descriptor_set_layout(skin_pipeline_per_mesh_instance_update_descriptor_set_layout);
-    skin_pipeline_per_mesh_instance_update_descriptor_set_layout = NULL;
-    device->destroy_descriptor_set_layout(skin_pipeline_per_mesh_skinned_subset_update_descriptor_set_layout);
-    skin_pipeline_per_mesh_skinned_subset_update_descriptor_set_layout = NULL;
-    device->destroy_descriptor_set_layout(gbuffer_pipeline_none_update_bindless_buffer_descriptor_set_layout);
-    gbuffer_pipeline_none_update_bindless_buffer_descriptor_set_layout = NULL;
-    device->destroy_descriptor_set_layout(gbuffer_pipeline_none_update_bindless_texture_descriptor_set_layout);
-    gbuffer_pipeline_none_update_bindless_texture_descriptor_set_layout = NULL;
+    // Camera
+    g_camera.SetProjParams(g_camera.GetFOV(), static_cast<float>(this->m_intermediate_width) / static_cast<float>(this->m_intermediate_height), g_camera.GetNearClip(), g_camera.GetFarClip());
+}
+
+brx_sampled_image const *Demo::get_sampled_image_for_present()
+{
+    return this->m_ambient_occlusion_image->get_sampled_image();
+}
+
+void Demo::on_swap_chain_dettach(brx_device *device)
+{
+    device->destroy_storage_image(this->m_gbuffer_depth_image);
+    device->destroy_storage_image(this->m_gbuffer_normal_image);
+    device->destroy_storage_image(this->m_ambient_occlusion_image);
 
-    // Init Intermediate Images
-    this->m_intermediate_width = 0U;
-    this->m_intermediate_height = 0U;
     this->m_gbuffer_depth_image = NULL;
     this->m_gbuffer_normal_image = NULL;
     this->m_ambient_occlusion_image = NULL;
 
-    // Init Camera
-    g_camera.SetRightHanded(true);
-    g_camera.SetScalers(2.0F, 5.0F);
-    g_camera.SetRotateButtons(false, false, true, false);
-    DirectX::XMFLOAT3 eye_position(0.0F, 0.5F, 5.0F);
-    DirectX::XMFLOAT3 eye_direction(0.0F, 0.0523359776F, -0.998629570F);
-    DirectX::XMFLOAT3 up_direction(0.0F, 1.0F, 0.0F);
-    DirectX::XMFLOAT3 look_at_position(eye_position.x + eye_direction.x, eye_position.y + eye_direction.y, eye_position.z + eye_direction.z);
-    g_camera.SetViewParams(DirectX::XMLoadFloat3(&eye_position), DirectX::XMLoadFloat3(&look_at_position), DirectX::XMLoadFloat3(&up_direction));
-    float fov = 0.7F;
-    float near_plane = 0.01F;
-    float far_plane = 1000.0F;
-    g_camera.SetProjParams(fov, 1.0F, near_plane, far_plane);
+    this->m_intermediate_width = 0U;
+    this->m_intermediate_height = 0U;
+}
 
-    // Init Animation Time
-    this->m_animation_time = 0.0F;
+void Demo::simulate(float interval_time, Demo_Frame_Packet *out_frame_packet)
+{
+    out_frame_packet->m_interval_time = interval_time;
+
+    // Camera
+    {
+        g_camera.FrameMove(interval_time);
+
+        DirectX::XMStoreFloat4x4(&out_frame_packet->m_view_transform, g_camera.GetViewMatrix());
+    }
+
+    // Animation
+    {
+        this->m_animation_time += interval_time;
+
+        out_frame_packet->m_animation_frame_index = static_cast<size_t>(animation_frame_rate * this->m_animation_time);
+    }
 }
 
-void Demo::destroy(brx_device *device)
+void Demo::draw(brx_device *device, brx_graphics_command_buffer *command_buffer, Demo_Frame_Packet const *frame_packet, uint32_t frame_throttling_index)
 {
-    // Descriptor
+    // Texture Streaming
     {
-        // Skin Pipeline
+        this->update_texture_streaming(device, frame_throttling_index);
+    }
+
+    // the recording cost of each pass (the GPU cost is reflected by the interval time since the frames are throttled)
+    uint64_t stress_report_pass_tick_counts[STRESS_REPORT_PASS_COUNT + 1U];
+
+    stress_report_pass_tick_counts[0] = tick_count_now();
+
+#ifndef NDEBUG
+    // the texture streaming above is NOT in the steady state
+    // only the global "operator new" is counted, and the lists (the "mcrt_vector") which are used in the steady state are checked by the capacity instead
+    uint64_t const steady_state_allocation_count = allocation_counter_get_thread_allocation_count();
+#endif
+
+    // the skinned vertices and the acceleration structures only change when the animation advances (the model transforms are NOT changed after the loading)
+    // the maintenance of the acceleration structures is skipped by the frames which are drawn faster than the animation frame rate
+    bool const acceleration_structure_update_required = (!this->m_skinned_mesh_instances.empty()) && (this->m_acceleration_structure_animation_frame_index != frame_packet->m_animation_frame_index);
+
+    // Update Uniform Buffer
+    {
+        // Skin Pipeline - Per Mesh Instance Update
+        if (acceleration_structure_update_required)
         {
-            for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+            // linear allocator (reset per frame)
+            uint32_t const frame_begin_offset = this->m_skin_pipeline_per_mesh_instance_update_uniform_buffer_frame_size * frame_throttling_index;
+            uint32_t frame_allocated_offset = frame_begin_offset;
+
+            // the offsets are allocated in order on the render thread, and the joint palettes are written by the worker pool
+            for (size_t skinned_mesh_instance_index = 0U; skinned_mesh_instance_index < this->m_skinned_mesh_instances.size(); ++skinned_mesh_instance_index)
             {
-                Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+                Demo_Mesh_Instance *const scene_mesh_instance = this->m_skinned_mesh_instances[skinned_mesh_instance_index];
 
-                if (!scene_mesh.m_skinned)
-                {
-                    for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                    {
-                        Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+                scene_mesh_instance->m_skin_pipeline_per_mesh_instance_update_dynamic_offset = frame_allocated_offset;
+                frame_allocated_offset += tbb_align_up(static_cast<uint32_t>(sizeof(skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding::g_dual_quaternions[0]) * 2U * scene_mesh_instance->m_skin_pipeline_per_mesh_instance_update_joint_count), this->m_uniform_upload_buffer_offset_alignment);
+                assert((frame_allocated_offset - frame_begin_offset) <= this->m_skin_pipeline_per_mesh_instance_update_uniform_buffer_frame_size);
+            }
 
-                        assert(scene_mesh_instance.m_skinned_subsets.empty());
+            uint32_t const skinned_mesh_instance_count = static_cast<uint32_t>(this->m_skinned_mesh_instances.size());
 
-                        assert(NULL == scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_descriptor_set);
-                    }
-                }
-                else
-                {
-                    for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                    {
-                        Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+            draw_skin_task_data skin_task_user_data;
+            skin_task_user_data.m_skinned_mesh_instances = this->m_skinned_mesh_instances.data();
+            skin_task_user_data.m_skinned_mesh_instance_count = skinned_mesh_instance_count;
+            skin_task_user_data.m_animation_frame_index = frame_packet->m_animation_frame_index;
+            skin_task_user_data.m_skin_pipeline_per_mesh_instance_update_uniform_buffer_host_memory_range_base = this->m_skin_pipeline_per_mesh_instance_update_uniform_buffer->get_host_memory_range_base();
 
-                        assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
+            this->m_draw_worker_pool.parallel_for((skinned_mesh_instance_count + draw_task_chunk_instance_count - 1U) / draw_task_chunk_instance_count, draw_skin_task_main, &skin_task_user_data);
+        }
 
-                        for (size_t mesh_subset_index = 0U; mesh_subset_index < scene_mesh_instance.m_skinned_subsets.size(); ++mesh_subset_index)
-                        {
-                            Demo_Mesh_Skinned_Subset &scene_mesh_skinned_subset = scene_mesh_instance.m_skinned_subsets[mesh_subset_index];
+        // Common - None Update (update frequency denotes the updating of the resource bindings)
+        {
+            common_none_update_set_uniform_buffer_binding *const common_none_update_set_uniform_buffer_binding_destination = reinterpret_cast<common_none_update_set_uniform_buffer_binding *>(reinterpret_cast<uintptr_t>(this->m_common_gbuffer_pipeline_ambient_occlusion_pipeline_none_update_uniform_buffer->get_host_memory_range_base()) + tbb_align_up(static_cast<uint32_t>(sizeof(common_none_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * frame_throttling_index);
 
-                            device->destroy_descriptor_set(scene_mesh_skinned_subset.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set);
-                        }
+            DirectX::XMMATRIX view_transform = DirectX::XMLoadFloat4x4(&frame_packet->m_view_transform);
+            // the projection is only changed by the "on_swap_chain_attach" on the same thread
+            DirectX::XMMATRIX projection_transform = g_camera.GetProjMatrix();
 
-                        device->destroy_descriptor_set(scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_descriptor_set);
-                    }
-                }
+            DirectX::XMStoreFloat4x4(&common_none_update_set_uniform_buffer_binding_destination->g_view_transform, view_transform);
+            DirectX::XMStoreFloat4x4(&common_none_update_set_uniform_buffer_binding_destination->g_projection_transform, projection_transform);
+            DirectX::XMStoreFloat4x4(&common_none_update_set_uniform_buffer_binding_destination->g_inverse_view_transform, DirectX::XMMatrixInverse(NULL, view_transform));
+            DirectX::XMStoreFloat4x4(&common_none_update_set_uniform_buffer_binding_destination->g_inverse_projection_transform, DirectX::XMMatrixInverse(NULL, projection_transform));
+
+            common_none_update_set_uniform_buffer_binding_destination->g_screen_width = static_cast<float>(this->m_intermediate_width);
+            common_none_update_set_uniform_buffer_binding_destination->g_screen_height = static_cast<float>(this->m_intermediate_height);
+
+            common_none_update_set_uniform_buffer_binding_destination->g_ambient_occlusion_max_distance = 2.5F;
+            common_none_update_set_uniform_buffer_binding_destination->g_ambient_occlusion_sample_count = 128.0F;
+        }
+    }
+
+    stress_report_pass_tick_counts[1] = tick_count_now();
+
+    // Skin Pass
+    if (acceleration_structure_update_required)
+    {
+        if (!this->m_skin_pass_dispatches.empty())
+        {
+            command_buffer->begin_debug_utils_label("Skin Pass");
+
+            command_buffer->compute_pass_load(static_cast<uint32_t>(this->m_skin_pass_storage_buffers.size()), this->m_skin_pass_storage_buffers.data(), this->m_skin_pass_storage_buffer_load_operations.data(), 0U, NULL, NULL);
+
+            command_buffer->bind_compute_pipeline(this->m_skin_pipeline);
+
+            for (size_t skin_pass_dispatch_index = 0U; skin_pass_dispatch_index < this->m_skin_pass_dispatches.size(); ++skin_pass_dispatch_index)
+            {
+                Demo_Skin_Pass_Dispatch const &skin_pass_dispatch = this->m_skin_pass_dispatches[skin_pass_dispatch_index];
+
+                brx_descriptor_set *const descritor_sets[] = {
+                    this->m_skin_pipeline_per_mesh_instance_update_descriptor_set,
+                    skin_pass_dispatch.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set};
+
+                // the joint palette is allocated per frame
+                uint32_t const dynamic_offsets[] = {
+                    skin_pass_dispatch.m_mesh_instance->m_skin_pipeline_per_mesh_instance_update_dynamic_offset};
+
+                command_buffer->bind_compute_descriptor_sets(this->m_skin_pipeline_layout, sizeof(descritor_sets) / sizeof(descritor_sets[0]), descritor_sets, sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0]), dynamic_offsets);
+
+                command_buffer->dispatch(skin_pass_dispatch.m_group_count_x, skin_pass_dispatch.m_group_count_y, 1U);
             }
+
+            command_buffer->compute_pass_store(static_cast<uint32_t>(this->m_skin_pass_storage_buffers.size()), this->m_skin_pass_storage_buffers.data(), this->m_skin_pass_storage_buffer_store_operations.data(), 0U, NULL, NULL);
+
+            command_buffer->end_debug_utils_label();
         }
+    }
 
-        // GBuffer Pipeline
+    stress_report_pass_tick_counts[2] = tick_count_now();
+
+    // Update Bottom Level Acceleration Structure Pass
+    if (acceleration_structure_update_required)
+    {
+        command_buffer->begin_debug_utils_label("Update Bottom Level Acceleration Structure Pass");
+
+        assert(this->m_update_intermediate_bottom_level_acceleration_structures.size() == this->m_skinned_mesh_instances.size());
+
+        // the geometries of the skinned instance "i" start after the geometries of the skinned instances [0, i)
+        size_t geometry_vertex_position_buffer_offset = 0U;
+        for (size_t skinned_mesh_instance_index = 0U; skinned_mesh_instance_index < this->m_skinned_mesh_instances.size(); ++skinned_mesh_instance_index)
         {
-            device->destroy_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set);
+            Demo_Mesh_Instance const *const scene_mesh_instance = this->m_skinned_mesh_instances[skinned_mesh_instance_index];
 
-            device->destroy_descriptor_set(this->m_gbuffer_pipeline_none_update_bindless_buffer_descriptor_set);
+            assert(scene_mesh_instance->m_intermediate_bottom_level_acceleration_structure == this->m_update_intermediate_bottom_level_acceleration_structures[skinned_mesh_instance_index]);
 
-            device->destroy_descriptor_set(this->m_gbuffer_pipeline_none_update_bindless_texture_descriptor_set);
+            command_buffer->update_intermediate_bottom_level_acceleration_structure(scene_mesh_instance->m_intermediate_bottom_level_acceleration_structure, this->m_update_intermediate_bottom_level_acceleration_structure_geometry_vertex_position_buffers.data() + geometry_vertex_position_buffer_offset, scene_mesh_instance->m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer);
 
-            device->destroy_descriptor_set_layout(this->m_gbuffer_pipeline_none_update_descriptor_set_layout);
+            geometry_vertex_position_buffer_offset += scene_mesh_instance->m_skinned_subsets.size();
         }
+        assert(this->m_update_intermediate_bottom_level_acceleration_structure_geometry_vertex_position_buffers.size() == geometry_vertex_position_buffer_offset);
 
-        // Ambient Occlusion Pipeline
+        command_buffer->update_intermediate_bottom_level_acceleration_structure_store(static_cast<uint32_t>(this->m_update_intermediate_bottom_level_acceleration_structures.size()), this->m_update_intermediate_bottom_level_acceleration_structures.data());
+
+        command_buffer->end_debug_utils_label();
+    }
+
+    stress_report_pass_tick_counts[3] = tick_count_now();
+
+    // Update Top Level Acceleration Structure Pass
+    if (acceleration_structure_update_required)
+    {
+        command_buffer->begin_debug_utils_label("Update Top Level Acceleration Structure Pass");
+
+        // only the host memory of the instance upload buffer is written by the worker pool
+        assert(this->m_scene_instance_count == this->m_scene_instances.size());
+
+        draw_top_level_acceleration_structure_task_data top_level_acceleration_structure_task_user_data;
+        top_level_acceleration_structure_task_user_data.m_scene_instances = this->m_scene_instances.data();
+        top_level_acceleration_structure_task_user_data.m_scene_instance_count = this->m_scene_instance_count;
+        top_level_acceleration_structure_task_user_data.m_top_level_acceleration_structure_instance_upload_buffer = this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index];
+
+        this->m_draw_worker_pool.parallel_for((this->m_scene_instance_count + draw_task_chunk_instance_count - 1U) / draw_task_chunk_instance_count, draw_top_level_acceleration_structure_task_main, &top_level_acceleration_structure_task_user_data);
+
+        command_buffer->update_top_level_acceleration_structure(this->m_scene_top_level_acceleration_structure, this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index], this->m_scene_top_level_acceleration_structure_update_scratch_buffer);
+
+        command_buffer->update_top_level_acceleration_structure_store(this->m_scene_top_level_acceleration_structure);
+
+        command_buffer->end_debug_utils_label();
+
+        this->m_acceleration_structure_animation_frame_index = frame_packet->m_animation_frame_index;
+    }
+
+    stress_report_pass_tick_counts[4] = tick_count_now();
+
+    // GBuffer Pass
+    {
+        brx_storage_image const *storage_images[] = {
+            this->m_gbuffer_depth_image,
+            this->m_gbuffer_normal_image};
+
+        BRX_COMPUTE_PASS_STORAGE_IMAGE_LOAD_OPERATION const storage_image_load_operations[] = {
+            BRX_COMPUTE_PASS_STORAGE_IMAGE_LOAD_OPERATION_DONT_CARE,
+            BRX_COMPUTE_PASS_STORAGE_IMAGE_LOAD_OPERATION_DONT_CARE};
+        static_assert(sizeof(storage_images) / sizeof(storage_images[0]) == sizeof(storage_image_load_operations) / sizeof(storage_image_load_operations[0]), "");
+
+        BRX_COMPUTE_PASS_STORAGE_IMAGE_STORE_OPERATION const storage_image_store_operations[] = {
+            BRX_COMPUTE_PASS_STORAGE_IMAGE_STORE_OPERATION_FLUSH_FOR_SAMPLED_IMAGE,
+            BRX_COMPUTE_PASS_STORAGE_IMAGE_STORE_OPERATION_FLUSH_FOR_SAMPLED_IMAGE};
+        static_assert(sizeof(storage_images) / sizeof(storage_images[0]) == sizeof(storage_image_store_operations) / sizeof(storage_image_store_operations[0]), "");
+
+        command_buffer->begin_debug_utils_label("GBuffer Pass");
+
+        command_buffer->compute_pass_load(0U, NULL, NULL, sizeof(storage_images) / sizeof(storage_images[0]), storage_images, storage_image_load_operations);
+
+        command_buffer->bind_compute_pipeline(this->m_gbuffer_pipeline);
+
+        brx_descriptor_set *const descritor_sets[] = {
+            this->m_gbuffer_pipeline_none_update_descriptor_set,
+            this->m_gbuffer_pipeline_none_update_bindless_buffer_descriptor_set,
+            this->m_gbuffer_pipeline_none_update_bindless_texture_descriptor_set};
+        uint32_t const dynamic_offsets[] = {
+            tbb_align_up(static_cast<uint32_t>(sizeof(common_none_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * frame_throttling_index};
+        command_buffer->bind_compute_descriptor_sets(this->m_gbuffer_pipeline_layout, sizeof(descritor_sets) / sizeof(descritor_sets[0]), descritor_sets, sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0]), dynamic_offsets);
+
+        command_buffer->dispatch(this->m_intermediate_width, this->m_intermediate_height, 1U);
+
+        command_buffer->compute_pass_store(0U, NULL, NULL, sizeof(storage_images) / sizeof(storage_images[0]), storage_images, storage_image_store_operations);
+
+        command_buffer->end_debug_utils_label();
+    }
+
+    stress_report_pass_tick_counts[5] = tick_count_now();
+
+    // Ambient Occlusion Pass
+    {
+        brx_storage_image const *storage_images[] = {
+            this->m_ambient_occlusion_image};
+
+        BRX_COMPUTE_PASS_STORAGE_IMAGE_LOAD_OPERATION const storage_image_load_operations[] = {
+            BRX_COMPUTE_PASS_STORAGE_IMAGE_LOAD_OPERATION_DONT_CARE};
+        static_assert(sizeof(storage_images) / sizeof(storage_images[0]) == sizeof(storage_image_load_operations) / sizeof(storage_image_load_operations[0]), "");
+
+        BRX_COMPUTE_PASS_STORAGE_IMAGE_STORE_OPERATION const storage_image_store_operations[] = {
+            BRX_COMPUTE_PASS_STORAGE_IMAGE_STORE_OPERATION_FLUSH_FOR_SAMPLED_IMAGE};
+        static_assert(sizeof(storage_images) / sizeof(storage_images[0]) == sizeof(storage_image_store_operations) / sizeof(storage_image_store_operations[0]), "");
+
+        command_buffer->begin_debug_utils_label("Ambient Occlusion Pass");
+
+        command_buffer->compute_pass_load(0U, NULL, NULL, sizeof(storage_images) / sizeof(storage_images[0]), storage_images, storage_image_load_operations);
+
+        command_buffer->bind_compute_pipeline(this->m_ambient_occlusion_pipeline);
+
+        brx_descriptor_set *const descritor_sets[] = {
+            this->m_ambient_occlusion_pipeline_none_update_descriptor_set};
+        uint32_t const dynamic_offsets[] = {
+            tbb_align_up(static_cast<uint32_t>(sizeof(common_none_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * frame_throttling_index};
+        command_buffer->bind_compute_descriptor_sets(this->m_ambient_occlusion_pipeline_layout, sizeof(descritor_sets) / sizeof(descritor_sets[0]), descritor_sets, sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0]), dynamic_offsets);
+
+        command_buffer->dispatch(this->m_intermediate_width, this->m_intermediate_height, 1U);
+
+        command_buffer->compute_pass_store(0U, NULL, NULL, sizeof(storage_images) / sizeof(storage_images[0]), storage_images, storage_image_store_operations);
+
+        command_buffer->end_debug_utils_label();
+    }
+
+    stress_report_pass_tick_counts[STRESS_REPORT_PASS_COUNT] = tick_count_now();
+
+    assert(allocation_counter_get_thread_allocation_count() == steady_state_allocation_count);
+
+#ifndef NDEBUG
+    // the lists used by the draw are NOT reallocated in the steady state
+    {
+        void const *draw_list_datas[DEMO_DRAW_LIST_COUNT];
+        size_t draw_list_capacities[DEMO_DRAW_LIST_COUNT];
+        this->get_draw_list_storage(draw_list_datas, draw_list_capacities);
+
+        for (uint32_t draw_list_index = 0U; draw_list_index < DEMO_DRAW_LIST_COUNT; ++draw_list_index)
         {
-            device->destroy_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set);
+            assert(this->m_draw_list_datas[draw_list_index] == draw_list_datas[draw_list_index]);
+            assert(this->m_draw_list_capacities[draw_list_index] == draw_list_capacities[draw_list_index]);
+        }
+    }
+#endif
 
-            device->destroy_descriptor_set_layout(this->m_ambient_occlusion_pipeline_none_update_descriptor_set_layout);
+    // Stress Report
+    if (this->m_stress_report_enabled)
+    {
+        for (uint32_t stress_report_pass_index = 0U; stress_report_pass_index < STRESS_REPORT_PASS_COUNT; ++stress_report_pass_index)
+        {
+            this->m_stress_report_pass_tick_counts[stress_report_pass_index] += (stress_report_pass_tick_counts[stress_report_pass_index + 1U] - stress_report_pass_tick_counts[stress_report_pass_index]);
         }
-    }
 
-    // Uniform Buffer
-    {
-        device->destroy_uniform_upload_buffer(this->m_common_gbuffer_pipeline_ambient_occlusion_pipeline_none_update_uniform_buffer);
+        this->m_stress_report_interval_time += frame_packet->m_interval_time;
 
-        device->destroy_uniform_upload_buffer(this->m_gbuffer_pipeline_none_update_instance_information_uniform_buffer);
+        ++this->m_stress_report_frame_count;
 
-        for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+        if (this->m_stress_report_frame_count >= stress_report_frame_count)
         {
-            Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+            double const milliseconds_per_tick_count_per_frame = 1000.0 / (static_cast<double>(tick_count_per_second()) * static_cast<double>(this->m_stress_report_frame_count));
 
-            for (size_t instance_index = 0U; instance_index < scene_mesh.m_instances.size(); ++instance_index)
+            printf("Stress Report: %u copies, %u instances, %u geometries, frame %.3f ms", static_cast<unsigned>(this->m_stress_replication_count), static_cast<unsigned>(this->m_scene_instance_count), static_cast<unsigned>(this->m_scene_geometry_count), 1000.0 * this->m_stress_report_interval_time / static_cast<double>(this->m_stress_report_frame_count));
+
+            for (uint32_t stress_report_pass_index = 0U; stress_report_pass_index < STRESS_REPORT_PASS_COUNT; ++stress_report_pass_index)
             {
-                Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[instance_index];
+                printf(", %s %.3f ms", stress_report_pass_names[stress_report_pass_index], static_cast<double>(this->m_stress_report_pass_tick_counts[stress_report_pass_index]) * milliseconds_per_tick_count_per_frame);
 
-                if (!scene_mesh.m_skinned)
-                {
-                    assert(NULL == scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_uniform_buffer);
-                }
-                else
-                {
-                    device->destroy_uniform_upload_buffer(scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_uniform_buffer);
-                }
+                this->m_stress_report_pass_tick_counts[stress_report_pass_index] = 0U;
             }
+
+            printf("\n");
+
+            this->m_stress_report_frame_count = 0U;
+            this->m_stress_report_interval_time = 0.0;
         }
     }
+}
 
-    // Sampler
+uint32_t Demo::allocate_bindless_buffers(brx_device *device, uint32_t count, brx_read_only_storage_buffer const *const *read_only_storage_buffers)
+{
+    uint32_t base;
+    if (!this->m_bindless_buffer_allocator.allocate(count, &base))
     {
-        device->destroy_sampler(this->m_sampler);
+        return UINT32_MAX;
     }
 
-    // Place Holder Buffer
+    // the slot is NOT used by any frame in flight
+    device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_bindless_buffer_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_READ_ONLY_STORAGE_BUFFER, base, count, NULL, NULL, read_only_storage_buffers, NULL, NULL, NULL, NULL, NULL);
+
+    return base;
+}
+
+uint32_t Demo::allocate_bindless_textures(brx_device *device, uint32_t count, brx_sampled_image const *const *sampled_images)
+{
+    uint32_t base;
+    if (!this->m_bindless_texture_allocator.allocate(count, &base))
     {
-        device->destroy_storage_asset_buffer(this->m_place_holder_buffer);
+        return UINT32_MAX;
     }
 
-    // Place Holder Texture
+    // the slot is NOT used by any frame in flight
+    device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_bindless_texture_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_SAMPLED_IMAGE, base, count, NULL, NULL, NULL, NULL, sampled_images, NULL, NULL, NULL);
+
+    return base;
+}
+
+void Demo::prepare_texture_streaming(brx_device *device)
+{
+    uint32_t prepared_count = this->m_texture_streaming_thread_context.m_prepared_count;
+
+    while (prepared_count < this->m_streaming_textures.size())
     {
-        device->destroy_sampled_asset_image(this->m_place_holder_texture);
+        Demo_Streaming_Texture &streaming_texture = this->m_streaming_textures[prepared_count];
+
+        assert(NULL == streaming_texture.m_staging_upload_buffer);
+
+        if (streaming_texture.m_staging_upload_size > this->m_texture_streaming_staging_upload_ring.get_size())
+        {
+            // the texture can never fit in the ring
+            streaming_texture.m_staging_upload_buffer = device->create_staging_upload_buffer(streaming_texture.m_staging_upload_size);
+            streaming_texture.m_staging_upload_buffer_offset = 0U;
+            streaming_texture.m_staging_upload_ring_region_size = 0U;
+            streaming_texture.m_staging_upload_buffer_host_memory_range_base = streaming_texture.m_staging_upload_buffer->get_host_memory_range_base();
+        }
+        else if (this->m_texture_streaming_staging_upload_ring.allocate(streaming_texture.m_staging_upload_size, &streaming_texture.m_staging_upload_buffer_offset, &streaming_texture.m_staging_upload_buffer_host_memory_range_base, &streaming_texture.m_staging_upload_ring_region_size))
+        {
+            streaming_texture.m_staging_upload_buffer = this->m_texture_streaming_staging_upload_ring.get_staging_upload_buffer();
+        }
+        else
+        {
+            // retry after the oldest batch has been retired
+            break;
+        }
+
+        ++prepared_count;
     }
 
-    // Asset
+    if (prepared_count != this->m_texture_streaming_thread_context.m_prepared_count)
     {
-        for (size_t scene_texture_index = 0U; scene_texture_index < this->m_scene_textures.size(); ++scene_texture_index)
         {
-            brx_sampled_asset_image *const material_texture = this->m_scene_textures[scene_texture_index];
-
-            assert(NULL != material_texture);
-            device->destroy_sampled_asset_image(material_texture);
+            std::unique_lock<std::mutex> lock(this->m_texture_streaming_thread_context.m_mutex);
+            this->m_texture_streaming_thread_context.m_prepared_count = prepared_count;
         }
+        this->m_texture_streaming_thread_context.m_condition_variable.notify_one();
+    }
+}
 
-        for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
-        {
-            Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+void Demo::update_texture_streaming(brx_device *device, uint32_t frame_throttling_index)
+{
+    if (NULL == this->m_texture_streaming_fence)
+    {
+        // the streaming has finished
+        return;
+    }
 
-            for (size_t subset_index = 0U; subset_index < scene_mesh.m_subsets.size(); ++subset_index)
-            {
-                Demo_Mesh_Subset &scene_mesh_subset = scene_mesh.m_subsets[subset_index];
+    uint32_t const streaming_texture_count = static_cast<uint32_t>(this->m_streaming_textures.size());
 
-                device->destroy_storage_asset_buffer(scene_mesh_subset.m_vertex_position_buffer);
+    // retire the batch
+    // the batch is submitted before the frame of the same frame throttling index, and the fence of the batch has almost certainly been signaled when the fence of that frame has been waited
+    if ((this->m_texture_streaming_retired_count < this->m_texture_streaming_submitted_count) && (frame_throttling_index == this->m_texture_streaming_submitted_frame_throttling_index))
+    {
+        device->wait_for_fence(this->m_texture_streaming_fence);
 
-                device->destroy_storage_asset_buffer(scene_mesh_subset.m_vertex_varying_buffer);
+        uint32_t const retired_texture_count = this->m_texture_streaming_submitted_count - this->m_texture_streaming_retired_count;
 
-                if (!scene_mesh.m_skinned)
-                {
-                    assert(NULL == scene_mesh_subset.m_vertex_joint_buffer);
-                }
-                else
-                {
-                    device->destroy_storage_asset_buffer(scene_mesh_subset.m_vertex_joint_buffer);
-                }
+        assert(retired_texture_count <= this->m_texture_streaming_retired_sampled_images.capacity());
+        mcrt_vector<brx_sampled_image const *> &material_sampled_images = this->m_texture_streaming_retired_sampled_images;
+        material_sampled_images.resize(static_cast<size_t>(retired_texture_count));
+        for (uint32_t streaming_texture_index = this->m_texture_streaming_retired_count; streaming_texture_index < this->m_texture_streaming_submitted_count; ++streaming_texture_index)
+        {
+            Demo_Streaming_Texture &streaming_texture = this->m_streaming_textures[streaming_texture_index];
 
-                device->destroy_storage_asset_buffer(scene_mesh_subset.m_index_buffer);
+            // the regions of the staging upload ring are freed in the same order as they are allocated
+            free_streaming_texture_staging_upload_memory(device, &this->m_texture_streaming_staging_upload_ring, &streaming_texture);
 
-                device->destroy_storage_asset_buffer(scene_mesh_subset.m_information_buffer);
-            }
+            // the place holder texture is kept if the image data has failed to be decoded
+            material_sampled_images[streaming_texture_index - this->m_texture_streaming_retired_count] = streaming_texture.m_decoded ? streaming_texture.m_image->get_sampled_image() : this->m_place_holder_texture->get_sampled_image();
+        }
 
-            if (!scene_mesh.m_skinned)
-            {
-                device->destroy_compacted_bottom_level_acceleration_structure(scene_mesh.m_compacted_bottom_level_acceleration_structure);
+        // replace the place holder texture
+        if (UINT32_MAX != this->m_scene_texture_bindless_base_index)
+        {
+            device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_bindless_texture_descriptor_set, 0U, BRX_DESCRIPTOR_TYPE_SAMPLED_IMAGE, this->m_scene_texture_bindless_base_index + this->m_texture_streaming_retired_count, retired_texture_count, NULL, NULL, NULL, NULL, material_sampled_images.data(), NULL, NULL, NULL);
+        }
 
-                for (size_t instance_index = 0U; instance_index < scene_mesh.m_instances.size(); ++instance_index)
-                {
-                    Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[instance_index];
+        this->m_texture_streaming_retired_count = this->m_texture_streaming_submitted_count;
+    }
 
-                    assert(scene_mesh_instance.m_skinned_subsets.empty());
+    // allocate the staging memory from the space freed by the retired batch
+    this->prepare_texture_streaming(device);
 
-                    assert(NULL == scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+    // submit the next batch
+    // the number of the decoded textures is only increased by the streaming thread
+    uint32_t const decoded_count = this->m_texture_streaming_thread_context.m_decoded_count.load(std::memory_order_acquire);
+    if ((this->m_texture_streaming_retired_count == this->m_texture_streaming_submitted_count) && (this->m_texture_streaming_submitted_count < decoded_count))
+    {
+        uint32_t const submitted_count = std::min(decoded_count, this->m_texture_streaming_submitted_count + texture_streaming_batch_texture_count);
 
-                    assert(NULL == scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer);
-                }
-            }
-            else
-            {
-                assert(NULL == scene_mesh.m_compacted_bottom_level_acceleration_structure);
+        device->reset_upload_command_buffer(this->m_texture_streaming_upload_command_buffer);
 
-                for (size_t instance_index = 0U; instance_index < scene_mesh.m_instances.size(); ++instance_index)
-                {
-                    Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[instance_index];
+        device->reset_graphics_command_buffer(this->m_texture_streaming_graphics_command_buffer);
 
-                    for (size_t subset_index = 0U; subset_index < scene_mesh.m_subsets.size(); ++subset_index)
-                    {
-                        Demo_Mesh_Skinned_Subset &scene_mesh_skinned_subset = scene_mesh_instance.m_skinned_subsets[subset_index];
+        this->m_texture_streaming_upload_command_buffer->begin();
 
-                        device->destroy_storage_intermediate_buffer(scene_mesh_skinned_subset.m_skinned_vertex_position_buffer);
+        this->m_texture_streaming_graphics_command_buffer->begin();
 
-                        device->destroy_storage_intermediate_buffer(scene_mesh_skinned_subset.m_skinned_vertex_varying_buffer);
-                    }
+        mcrt_vector<brx_sampled_asset_image const *> &uploaded_sampled_asset_images = this->m_texture_streaming_uploaded_sampled_asset_images;
+        mcrt_vector<uint32_t> &uploaded_destination_mip_levels = this->m_texture_streaming_uploaded_destination_mip_levels;
+        uploaded_sampled_asset_images.clear();
+        uploaded_destination_mip_levels.clear();
+        for (uint32_t streaming_texture_index = this->m_texture_streaming_submitted_count; streaming_texture_index < submitted_count; ++streaming_texture_index)
+        {
+            Demo_Streaming_Texture &streaming_texture = this->m_streaming_textures[streaming_texture_index];
 
-                    device->destroy_intermediate_bottom_level_acceleration_structure(scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+            // the image data has been decoded into the staging upload buffer
+            streaming_texture.m_input_stream_factory->destory_instance(streaming_texture.m_input_stream);
+            streaming_texture.m_input_stream = NULL;
 
-                    device->destroy_scratch_buffer(scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer);
-                }
+            // the image is NOT uploaded (and is never bound) if the image data has failed to be decoded
+            if (!streaming_texture.m_decoded)
+            {
+                printf("Texture Streaming: fail to decode the texture %u, and the place holder texture is used\n", static_cast<unsigned int>(streaming_texture_index));
+                continue;
             }
-        }
-    }
 
-    // Top Level Acceleration Structure
-    {
-        device->destroy_top_level_acceleration_structure(this->m_scene_top_level_acceleration_structure);
+            // the skipped mips have been dropped from the header, and only the resident mips are in the staging memory
+            for (uint32_t mip_level = 0U; mip_level < streaming_texture.m_header.mip_levels; ++mip_level)
+            {
+                this->m_texture_streaming_upload_command_buffer->upload_from_staging_upload_buffer_to_sampled_asset_image(streaming_texture.m_image, streaming_texture.m_header.format, streaming_texture.m_header.width, streaming_texture.m_header.height, mip_level, streaming_texture.m_staging_upload_buffer, streaming_texture.m_staging_upload_buffer_offset + streaming_texture.m_subresource_memcpy_dests[mip_level].staging_upload_buffer_offset, streaming_texture.m_subresource_memcpy_dests[mip_level].output_row_pitch, streaming_texture.m_subresource_memcpy_dests[mip_level].output_row_count);
 
-        for (uint32_t frame_throttling_index = 0U; frame_throttling_index < FRAME_THROTTLING_COUNT; ++frame_throttling_index)
-        {
-            device->destroy_top_level_acceleration_structure_instance_upload_buffer(this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index]);
+                uploaded_sampled_asset_images.push_back(streaming_texture.m_image);
+
+                uploaded_destination_mip_levels.push_back(mip_level);
+            }
         }
 
-        device->destroy_scratch_buffer(this->m_scene_top_level_acceleration_structure_update_scratch_buffer);
-    }
+        assert(uploaded_sampled_asset_images.size() == uploaded_destination_mip_levels.size());
+        assert(uploaded_sampled_asset_images.size() <= uploaded_sampled_asset_images.capacity());
 
-    // Render Pass and Pipeline
-    {
-        device->destroy_compute_pipeline(this->m_ambient_occlusion_pipeline);
+        // release
+        this->m_texture_streaming_upload_command_buffer->release(0U, NULL, static_cast<uint32_t>(uploaded_sampled_asset_images.size()), uploaded_sampled_asset_images.data(), uploaded_destination_mip_levels.data(), 0U, NULL);
 
-        device->destroy_pipeline_layout(this->m_ambient_occlusion_pipeline_layout);
+        // acquire
+        this->m_texture_streaming_graphics_command_buffer->acquire(0U, NULL, static_cast<uint32_t>(uploaded_sampled_asset_images.size()), uploaded_sampled_asset_images.data(), uploaded_destination_mip_levels.data(), 0U, NULL);
 
-        device->destroy_compute_pipeline(this->m_gbuffer_pipeline);
+        this->m_texture_streaming_upload_command_buffer->end();
 
-        device->destroy_pipeline_layout(this->m_gbuffer_pipeline_layout);
+        this->m_texture_streaming_graphics_command_buffer->end();
 
-        device->destroy_compute_pipeline(this->m_skin_pipeline);
+        this->m_texture_streaming_upload_queue->submit_and_signal(this->m_texture_streaming_upload_command_buffer);
 
-        device->destroy_pipeline_layout(this->m_skin_pipeline_layout);
+        device->reset_fence(this->m_texture_streaming_fence);
+
+        this->m_texture_streaming_graphics_queue->wait_and_submit(this->m_texture_streaming_upload_command_buffer, this->m_texture_streaming_graphics_command_buffer, this->m_texture_streaming_fence);
+
+        this->m_texture_streaming_submitted_count = submitted_count;
+        this->m_texture_streaming_submitted_frame_throttling_index = frame_throttling_index;
+    }
+
+    if (streaming_texture_count == this->m_texture_streaming_retired_count)
+    {
+        this->destroy_texture_streaming(device);
     }
 }
 
-void Demo::on_swap_chain_attach(brx_device *device, uint32_t swap_chain_image_width, uint32_t swap_chain_image_height)
+void Demo::destroy_texture_streaming(brx_device *device)
 {
-    assert(0U == this->m_intermediate_width);
-    assert(0U == this->m_intermediate_height);
+    if (NULL == this->m_texture_streaming_fence)
+    {
+        assert(this->m_streaming_textures.empty());
+        assert(NULL == this->m_input_stream_factory);
+        return;
+    }
 
-    assert(NULL == this->m_gbuffer_depth_image);
-    assert(NULL == this->m_gbuffer_normal_image);
-    assert(NULL == this->m_ambient_occlusion_image);
+    // the streaming thread exits after all textures have been decoded or the streaming thread is stopped
+    {
+        std::unique_lock<std::mutex> lock(this->m_texture_streaming_thread_context.m_mutex);
+        this->m_texture_streaming_thread_context.m_stop = true;
+    }
+    this->m_texture_streaming_thread_context.m_condition_variable.notify_one();
 
-    this->m_intermediate_width = swap_chain_image_width;
-    this->m_intermediate_height = swap_chain_image_height;
+    this->m_texture_streaming_thread.join();
 
-    // Intermediate Images
-    this->m_gbuffer_depth_image = device->create_storage_image(BRX_STORAGE_IMAGE_FORMAT_R32_UINT, this->m_intermediate_width, this->m_intermediate_height, true);
-    this->m_gbuffer_normal_image = device->create_storage_image(BRX_STORAGE_IMAGE_FORMAT_R32_UINT, this->m_intermediate_width, this->m_intermediate_height, true);
-    this->m_ambient_occlusion_image = device->create_storage_image(BRX_STORAGE_IMAGE_FORMAT_R16_SFLOAT, this->m_intermediate_width, this->m_intermediate_height, true);
+    this->m_texture_streaming_thread_context.m_decode_worker_pool.destroy();
 
-    // Descriptor
+    // the fence is signaled when there is no batch in flight (since it is created signaled)
+    device->wait_for_fence(this->m_texture_streaming_fence);
+
+    for (uint32_t streaming_texture_index = this->m_texture_streaming_submitted_count; streaming_texture_index < this->m_streaming_textures.size(); ++streaming_texture_index)
     {
-        // GBuffer Pipeline
-        {
-            // The VkDescriptorSetLayout should still be valid when perform write update on VkDescriptorSet
-            assert(NULL != this->m_gbuffer_pipeline_none_update_descriptor_set_layout);
-            {
-                brx_storage_image const *const storage_images[] = {
-                    this->m_gbuffer_depth_image,
-                    this->m_gbuffer_normal_image};
-                device->write_descriptor_set(this->m_gbuffer_pipeline_none_update_descriptor_set, 4U, BRX_DESCRIPTOR_TYPE_STORAGE_IMAGE, 0U, sizeof(storage_images) / sizeof(storage_images[0]), NULL, NULL, NULL, NULL, NULL, &storage_images[0], NULL, NULL);
-            }
-        }
+        Demo_Streaming_Texture &streaming_texture = this->m_streaming_textures[streaming_texture_index];
 
-        // Ambient Occlusion Pipeline
-        {
-            // The VkDescriptorSetLayout should still be valid when perform write update on VkDescriptorSet
-            assert(NULL != this->m_ambient_occlusion_pipeline_none_update_descriptor_set_layout);
-            {
-                brx_sampled_image const *const sampled_images[] = {
-                    this->m_gbuffer_depth_image->get_sampled_image(),
-                    this->m_gbuffer_normal_image->get_sampled_image()};
-                device->write_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set, 2U, BRX_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 0U, sizeof(sampled_images) / sizeof(sampled_images[0]), NULL, NULL, NULL, NULL, sampled_images, NULL, NULL, NULL);
-            }
-            {
-                brx_storage_image const *const storage_images[] = {
-                    this->m_ambient_occlusion_image};
-                device->write_descriptor_set(this->m_ambient_occlusion_pipeline_none_update_descriptor_set, 3U, BRX_DESCRIPTOR_TYPE_STORAGE_IMAGE, 0U, sizeof(storage_images) / sizeof(storage_images[0]), NULL, NULL, NULL, NULL, NULL, &storage_images[0], NULL, NULL);
-            }
-        }
+        streaming_texture.m_input_stream_factory->destory_instance(streaming_texture.m_input_stream);
+        streaming_texture.m_input_stream = NULL;
     }
 
-    // Camera
-    g_camera.SetProjParams(g_camera.GetFOV(), static_cast<float>(this->m_intermediate_width) / static_cast<float>(this->m_intermediate_height), g_camera.GetNearClip(), g_camera.GetFarClip());
-}
+    for (uint32_t streaming_texture_index = this->m_texture_streaming_retired_count; streaming_texture_index < this->m_texture_streaming_thread_context.m_prepared_count; ++streaming_texture_index)
+    {
+        free_streaming_texture_staging_upload_memory(device, &this->m_texture_streaming_staging_upload_ring, &this->m_streaming_textures[streaming_texture_index]);
+    }
 
-brx_sampled_image const *Demo::get_sampled_image_for_present()
-{
-    return this->m_ambient_occlusion_image->get_sampled_image();
-}
+    this->m_texture_streaming_staging_upload_ring.destroy(device);
 
-void Demo::on_swap_chain_dettach(brx_device *device)
-{
-    device->destroy_storage_image(this->m_gbuffer_depth_image);
-    device->destroy_storage_image(this->m_gbuffer_normal_image);
-    device->destroy_storage_image(this->m_ambient_occlusion_image);
+    this->m_streaming_textures.clear();
+    this->m_streaming_textures.shrink_to_fit();
+    this->m_texture_streaming_retired_sampled_images.clear();
+    this->m_texture_streaming_retired_sampled_images.shrink_to_fit();
+    this->m_texture_streaming_uploaded_sampled_asset_images.clear();
+    this->m_texture_streaming_uploaded_sampled_asset_images.shrink_to_fit();
+    this->m_texture_streaming_uploaded_destination_mip_levels.clear();
+    this->m_texture_streaming_uploaded_destination_mip_levels.shrink_to_fit();
+    this->m_texture_streaming_thread_context.m_streaming_texture_count = 0U;
+    this->m_texture_streaming_thread_context.m_streaming_textures = NULL;
 
-    this->m_gbuffer_depth_image = NULL;
-    this->m_gbuffer_normal_image = NULL;
-    this->m_ambient_occlusion_image = NULL;
+    device->destroy_fence(this->m_texture_streaming_fence);
+    this->m_texture_streaming_fence = NULL;
 
-    this->m_intermediate_width = 0U;
-    this->m_intermediate_height = 0U;
-}
+    device->destroy_upload_command_buffer(this->m_texture_streaming_upload_command_buffer);
+    this->m_texture_streaming_upload_command_buffer = NULL;
 
-void Demo::draw(brx_graphics_command_buffer *command_buffer, float interval_time, uint32_t frame_throttling_index)
-{
-    // Update Uniform Buffer
-    uint32_t scene_instance_count;
-    uint32_t scene_geometry_count;
-    {
-        // Skin Pipeline - Per Mesh Instance Update
-        {
-            this->m_animation_time += interval_time;
+    device->destroy_graphics_command_buffer(this->m_texture_streaming_graphics_command_buffer);
+    this->m_texture_streaming_graphics_command_buffer = NULL;
 
-            size_t animetion_frame_index = static_cast<size_t>(animation_frame_rate * this->m_animation_time);
+    device->destroy_upload_queue(this->m_texture_streaming_upload_queue);
+    this->m_texture_streaming_upload_queue = NULL;
 
-            for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
-            {
-                Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+    device->destroy_graphics_queue(this->m_texture_streaming_graphics_queue);
+    this->m_texture_streaming_graphics_queue = NULL;
 
-                if (scene_mesh.m_skinned)
-                {
-                    for (size_t instance_index = 0U; instance_index < scene_mesh.m_instances.size(); ++instance_index)
-                    {
-                        Demo_Mesh_Instance const &scene_mesh_instance = scene_mesh.m_instances[instance_index];
+    if (this->m_use_mapped_file_input_stream_factory)
+    {
+        this->m_mapped_file_input_stream_factory.destroy();
+    }
+    else
+    {
+        import_asset_destroy_memory_input_stream_factory(this->m_input_stream_factory);
+    }
+    this->m_input_stream_factory = NULL;
 
-                        skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding *const skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding_destination = reinterpret_cast<skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding *>(reinterpret_cast<uintptr_t>(scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_uniform_buffer->get_host_memory_range_base()) + tbb_align_up(static_cast<uint32_t>(sizeof(skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * frame_throttling_index);
+    if (this->m_use_cooked_texture_input_stream_factory)
+    {
+        this->m_cooked_texture_input_stream_factory.destroy();
+    }
+}
 
-                        scene_animation_pose const &pose = scene_mesh_instance.m_animation_skeleton.get_pose(animetion_frame_index);
+#ifndef NDEBUG
+void Demo::get_draw_list_storage(void const *out_datas[DEMO_DRAW_LIST_COUNT], size_t out_capacities[DEMO_DRAW_LIST_COUNT]) const
+{
+    out_datas[0] = this->m_skinned_mesh_instances.data();
+    out_capacities[0] = this->m_skinned_mesh_instances.capacity();
 
-                        assert(pose.get_joint_count() <= MAX_JOINT_COUNT);
+    out_datas[1] = this->m_scene_instances.data();
+    out_capacities[1] = this->m_scene_instances.capacity();
 
-                        for (uint32_t joint_index = 0U; joint_index < pose.get_joint_count(); ++joint_index)
-                        {
-                            unit_dual_quaternion_from_rigid_transform(&skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding_destination->g_dual_quaternions[2 * joint_index], pose.get_quaternion(joint_index), pose.get_translation(joint_index));
-                        }
-                    }
-                }
-            }
-        }
+    out_datas[2] = this->m_skin_pass_storage_buffers.data();
+    out_capacities[2] = this->m_skin_pass_storage_buffers.capacity();
 
-        // Common - None Update (update frequency denotes the updating of the resource bindings)
-        {
-            common_none_update_set_uniform_buffer_binding *const common_none_update_set_uniform_buffer_binding_destination = reinterpret_cast<common_none_update_set_uniform_buffer_binding *>(reinterpret_cast<uintptr_t>(this->m_common_gbuffer_pipeline_ambient_occlusion_pipeline_none_update_uniform_buffer->get_host_memory_range_base()) + tbb_align_up(static_cast<uint32_t>(sizeof(common_none_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * frame_throttling_index);
+    out_datas[3] = this->m_skin_pass_storage_buffer_load_operations.data();
+    out_capacities[3] = this->m_skin_pass_storage_buffer_load_operations.capacity();
 
-            g_camera.FrameMove(interval_time);
+    out_datas[4] = this->m_skin_pass_storage_buffer_store_operations.data();
+    out_capacities[4] = this->m_skin_pass_storage_buffer_store_operations.capacity();
 
-            DirectX::XMMATRIX view_transform = g_camera.GetViewMatrix();
-            DirectX::XMMATRIX projection_transform = g_camera.GetProjMatrix();
+    out_datas[5] = this->m_skin_pass_dispatches.data();
+    out_capacities[5] = this->m_skin_pass_dispatches.capacity();
 
-            DirectX::XMStoreFloat4x4(&common_none_update_set_uniform_buffer_binding_destination->g_view_transform, view_transform);
-            DirectX::XMStoreFloat4x4(&common_none_update_set_uniform_buffer_binding_destination->g_projection_transform, projection_transform);
-            DirectX::XMStoreFloat4x4(&common_none_update_set_uniform_buffer_binding_destination->g_inverse_view_transform, DirectX::XMMatrixInverse(NULL, view_transform));
-            DirectX::XMStoreFloat4x4(&common_none_update_set_uniform_buffer_binding_destination->g_inverse_projection_transform, DirectX::XMMatrixInverse(NULL, projection_transform));
+    out_datas[6] = this->m_update_intermediate_bottom_level_acceleration_structures.data();
+    out_capacities[6] = this->m_update_intermediate_bottom_level_acceleration_structures.capacity();
 
-            common_none_update_set_uniform_buffer_binding_destination->g_screen_width = static_cast<float>(this->m_intermediate_width);
-            common_none_update_set_uniform_buffer_binding_destination->g_screen_height = static_cast<float>(this->m_intermediate_height);
+    out_datas[7] = this->m_update_intermediate_bottom_level_acceleration_structure_geometry_vertex_position_buffers.data();
+    out_capacities[7] = this->m_update_intermediate_bottom_level_acceleration_structure_geometry_vertex_position_buffers.capacity();
+}
+#endif
 
-            common_none_update_set_uniform_buffer_binding_destination->g_ambient_occlusion_max_distance = 2.5F;
-            common_none_update_set_uniform_buffer_binding_destination->g_ambient_occlusion_sample_count = 128.0F;
-        }
+static inline uint32_t tbb_align_up(uint32_t value, uint32_t alignment)
+{
+    //
+    //  Copyright (c) 2005-2019 Intel Corporation
+    //
+    //  Licensed under the Apache License, Version 2.0 (the "License");
+    //  you may not use this file except in compliance with the License.
+    //  You may obtain a copy of the License at
+    //
+    //      http://www.apache.org/licenses/LICENSE-2.0
+    //
+    //  Unless required by applicable law or agreed to in writing, software
+    //  distributed under the License is distributed on an "AS IS" BASIS,
+    //  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    //  See the License for the specific language governing permissions and
+    //  limitations under the License.
+    //
+
+    // [alignUp](https://github.com/oneapi-src/oneTBB/blob/tbb_2019/src/tbbmalloc/shared_utils.h#L42)
+
+    assert(alignment != static_cast<uint32_t>(0));
 
-        // GBuffer Pipeline - None Update
-        {
-            gbuffer_pipeline_none_update_set_instance_information_uniform_buffer_binding *const gbuffer_pipeline_none_update_set_instance_information_uniform_buffer_binding_destination = reinterpret_cast<gbuffer_pipeline_none_update_set_instance_information_uniform_buffer_binding *>(reinterpret_cast<uintptr_t>(this->m_gbuffer_pipeline_none_update_instance_information_uniform_buffer->get_host_memory_range_base()) + tbb_align_up(static_cast<uint32_t>(sizeof(gbuffer_pipeline_none_update_set_instance_information_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * frame_throttling_index);
+    // power-of-2 alignment
+    assert((alignment & (alignment - static_cast<uint32_t>(1))) == static_cast<uint32_t>(0));
 
-            uint32_t scene_instance_index = 0U;
-            uint32_t scene_geometry_index = 0U;
-            for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
-            {
-                Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+    return (((value - static_cast<uint32_t>(1)) | (alignment - static_cast<uint32_t>(1))) + static_cast<uint32_t>(1));
+}
 
-                if (!scene_mesh.m_skinned)
-                {
-                    for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                    {
-                        gbuffer_pipeline_none_update_set_instance_information_uniform_buffer_binding_destination->g_instance_information[scene_instance_index].m_global_geometry_index_offset = scene_geometry_index;
+static inline uint32_t pack_r16g16_uint(uint32_t x, uint32_t y)
+{
+    // the bindless indices are limited to 16 bits (MAX_MESH_SUBSET_BUFFER_COUNT and MAX_MESH_SUBSET_TEXTURE_COUNT)
+    assert(x <= 0XFFFFU);
+    assert(y <= 0XFFFFU);
 
-                        ++scene_instance_index;
-                    }
+    return ((x & 0XFFFFU) | ((y & 0XFFFFU) << 16U));
+}
 
-                    uint32_t const mesh_geometry_count = static_cast<uint32_t>(scene_mesh.m_subsets.size());
-                    scene_geometry_index += mesh_geometry_count;
-                }
-                else
-                {
-                    for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                    {
-                        Demo_Mesh_Instance const &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+static inline brx_sampled_asset_image *find_scene_texture(mcrt_unordered_map<mcrt_string, brx_sampled_asset_image *> const &mapped_textures, mcrt_string const &scene_asset_file_name, mcrt_string const &image_uri)
+{
+    mcrt_string image_asset_file_name_source;
+    mcrt_string image_asset_file_name_dds;
+    mcrt_string image_asset_file_name_pvr;
+    texture_cook_get_image_asset_file_names(scene_asset_file_name, image_uri, &image_asset_file_name_source, &image_asset_file_name_dds, &image_asset_file_name_pvr);
 
-                        assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
+    mcrt_unordered_map<mcrt_string, brx_sampled_asset_image *>::const_iterator found;
+    if (mapped_textures.end() != (found = mapped_textures.find(image_asset_file_name_dds)) || mapped_textures.end() != (found = mapped_textures.find(image_asset_file_name_pvr)) || mapped_textures.end() != (found = mapped_textures.find(image_asset_file_name_source)))
+    {
+        assert(NULL != found->second);
+        return found->second;
+    }
+    else
+    {
+        return NULL;
+    }
+}
 
-                        gbuffer_pipeline_none_update_set_instance_information_uniform_buffer_binding_destination->g_instance_information[scene_instance_index].m_global_geometry_index_offset = scene_geometry_index;
+static inline void find_scene_mesh_textures(mcrt_unordered_map<mcrt_string, brx_sampled_asset_image *> const &mapped_textures, mcrt_string const &scene_asset_file_name, scene_cache_mesh const &mesh, mcrt_vector<brx_sampled_asset_image *> &out_textures)
+{
+    // the same image may be referenced by the different URIs (from the different files), and thus the resolved images are compared rather than the URIs
+    out_textures.resize(SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT * mesh.m_subsets.size());
 
-                        ++scene_instance_index;
+    for (size_t subset_index = 0U; subset_index < mesh.m_subsets.size(); ++subset_index)
+    {
+        for (uint32_t texture_index = 0U; texture_index < SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT; ++texture_index)
+        {
+            mcrt_string const &image_uri = mesh.m_subsets[subset_index].m_texture_image_uris[texture_index];
 
-                        uint32_t const mesh_geometry_count = static_cast<uint32_t>(scene_mesh_instance.m_skinned_subsets.size());
-                        scene_geometry_index += mesh_geometry_count;
-                    }
-                }
-            }
-            assert(scene_instance_index <= MAX_INSTANCE_COUNT);
-            assert(scene_geometry_index <= MAX_GEOMETRY_COUNT);
-            scene_instance_count = scene_instance_index;
-            scene_geometry_count = scene_geometry_index;
+            out_textures[SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT * subset_index + texture_index] = (!image_uri.empty()) ? find_scene_texture(mapped_textures, scene_asset_file_name, image_uri) : NULL;
         }
     }
+}
 
-    // Skin Pass
+static inline uint64_t compute_scene_mesh_content_hash(scene_cache_mesh const &mesh, mcrt_vector<brx_sampled_asset_image *> const &textures)
+{
+    assert((SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT * mesh.m_subsets.size()) == textures.size());
+
+    uint64_t content_hash = SCENE_CACHE_HASH_INITIAL_VALUE;
+
+    uint32_t const subset_count = static_cast<uint32_t>(mesh.m_subsets.size());
+    content_hash = scene_cache_hash(content_hash, &subset_count, sizeof(subset_count));
+
+    for (size_t subset_index = 0U; subset_index < mesh.m_subsets.size(); ++subset_index)
     {
-        mcrt_vector<brx_storage_buffer const *> skin_pipeline_buffers;
-        mcrt_vector<brx_descriptor_set *> skin_pipeline_descriptor_sets;
-        mcrt_vector<uint32_t> skin_pipeline_vertex_counts;
+        scene_cache_mesh_subset const &subset = mesh.m_subsets[subset_index];
 
-        for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+        uint32_t const subset_header[3] = {subset.m_vertex_count, subset.m_index_count, subset.m_index_type_uint16 ? 1U : 0U};
+        content_hash = scene_cache_hash(content_hash, subset_header, sizeof(subset_header));
+
+        for (uint32_t buffer_index = 0U; buffer_index < SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT; ++buffer_index)
         {
-            Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+            content_hash = scene_cache_hash(content_hash, &subset.m_buffer_sizes[buffer_index], sizeof(subset.m_buffer_sizes[buffer_index]));
 
-            if (scene_mesh.m_skinned)
+            if (NULL != subset.m_buffers[buffer_index])
             {
-                for (size_t instance_index = 0U; instance_index < scene_mesh.m_instances.size(); ++instance_index)
-                {
-                    Demo_Mesh_Instance const &scene_mesh_instance = scene_mesh.m_instances[instance_index];
-
-                    assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
+                content_hash = scene_cache_hash(content_hash, subset.m_buffers[buffer_index], subset.m_buffer_sizes[buffer_index]);
+            }
+        }
+    }
 
-                    for (size_t subset_index = 0U; subset_index < scene_mesh_instance.m_skinned_subsets.size(); ++subset_index)
-                    {
-                        Demo_Mesh_Subset const &scene_mesh_subset = scene_mesh.m_subsets[subset_index];
+    // the images are only compared within the same process
+    content_hash = scene_cache_hash(content_hash, textures.data(), sizeof(brx_sampled_asset_image *) * textures.size());
 
-                        Demo_Mesh_Skinned_Subset const &scene_mesh_skinned_subset = scene_mesh_instance.m_skinned_subsets[subset_index];
+    return content_hash;
+}
 
-                        skin_pipeline_buffers.push_back(scene_mesh_skinned_subset.m_skinned_vertex_position_buffer->get_storage_buffer());
-                        skin_pipeline_buffers.push_back(scene_mesh_skinned_subset.m_skinned_vertex_varying_buffer->get_storage_buffer());
+static inline bool is_scene_mesh_content_equal(scene_cache_mesh const &mesh_a, mcrt_vector<brx_sampled_asset_image *> const &textures_a, scene_cache_mesh const &mesh_b, mcrt_vector<brx_sampled_asset_image *> const &textures_b)
+{
+    if ((mesh_a.m_skinned != mesh_b.m_skinned) || (mesh_a.m_subsets.size() != mesh_b.m_subsets.size()) || (textures_a != textures_b))
+    {
+        return false;
+    }
 
-                        skin_pipeline_descriptor_sets.push_back(scene_mesh_instance.m_skin_pipeline_per_mesh_instance_update_descriptor_set);
-                        skin_pipeline_descriptor_sets.push_back(scene_mesh_skinned_subset.m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set);
+    for (size_t subset_index = 0U; subset_index < mesh_a.m_subsets.size(); ++subset_index)
+    {
+        scene_cache_mesh_subset const &subset_a = mesh_a.m_subsets[subset_index];
+        scene_cache_mesh_subset const &subset_b = mesh_b.m_subsets[subset_index];
 
-                        skin_pipeline_vertex_counts.push_back(scene_mesh_subset.m_vertex_count);
-                    }
-                }
-            }
+        if ((subset_a.m_vertex_count != subset_b.m_vertex_count) || (subset_a.m_index_count != subset_b.m_index_count) || (subset_a.m_index_type_uint16 != subset_b.m_index_type_uint16))
+        {
+            return false;
         }
-        assert(skin_pipeline_buffers.size() == 2U * skin_pipeline_vertex_counts.size());
-        assert(skin_pipeline_descriptor_sets.size() == 2U * skin_pipeline_vertex_counts.size());
-
-        size_t const mesh_skinned_subset_count = skin_pipeline_vertex_counts.size();
 
-        if (mesh_skinned_subset_count > 0U)
+        for (uint32_t buffer_index = 0U; buffer_index < SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT; ++buffer_index)
         {
-            command_buffer->begin_debug_utils_label("Skin Pass");
+            if ((subset_a.m_buffer_sizes[buffer_index] != subset_b.m_buffer_sizes[buffer_index]) || ((NULL != subset_a.m_buffers[buffer_index]) != (NULL != subset_b.m_buffers[buffer_index])))
+            {
+                return false;
+            }
 
-            mcrt_vector<BRX_COMPUTE_PASS_STORAGE_BUFFER_LOAD_OPERATION> skinned_buffer_load_operations(skin_pipeline_buffers.size(), BRX_COMPUTE_PASS_STORAGE_BUFFER_LOAD_OPERATION_DONT_CARE);
-            command_buffer->compute_pass_load(static_cast<uint32_t>(skin_pipeline_buffers.size()), skin_pipeline_buffers.data(), skinned_buffer_load_operations.data(), 0U, NULL, NULL);
+            if ((NULL != subset_a.m_buffers[buffer_index]) && (0 != std::memcmp(subset_a.m_buffers[buffer_index], subset_b.m_buffers[buffer_index], subset_a.m_buffer_sizes[buffer_index])))
+            {
+                return false;
+            }
+        }
+    }
 
-            command_buffer->bind_compute_pipeline(this->m_skin_pipeline);
+    return true;
+}
 
-            for (size_t subset_index = 0U; subset_index < mesh_skinned_subset_count; ++subset_index)
-            {
-                brx_descriptor_set *const descritor_sets[] = {
-                    skin_pipeline_descriptor_sets[2U * subset_index],
-                    skin_pipeline_descriptor_sets[2U * subset_index + 1U]};
+static void scene_asset_import_task_main(uint32_t file_name_index, void *user_data)
+{
+    scene_asset_import_task_data const *const task_data = static_cast<scene_asset_import_task_data const *>(user_data);
 
-                uint32_t const dynamic_offsets[] = {
-                    tbb_align_up(static_cast<uint32_t>(sizeof(skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * frame_throttling_index};
+    mcrt_string const &file_name = (*task_data->m_file_names)[file_name_index];
 
-                command_buffer->bind_compute_descriptor_sets(this->m_skin_pipeline_layout, sizeof(descritor_sets) / sizeof(descritor_sets[0]), descritor_sets, sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0]), dynamic_offsets);
+    scene_asset_import_result &result = task_data->m_results[file_name_index];
 
-                uint32_t const vertex_count = skin_pipeline_vertex_counts[subset_index];
+    // the scene cache is only available when the assets are read from the files
+    result.m_scene_cache_source_hash = (NULL != task_data->m_mapped_file_input_stream_factory) ? scene_cook_compute_source_hash(task_data->m_mapped_file_input_stream_factory, file_name) : 0U;
 
-                uint32_t const group_count_x = (vertex_count <= MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION) ? vertex_count : MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION;
-                uint32_t const group_count_y = (vertex_count + MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION - 1U) / MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION;
-                assert(group_count_x <= MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION);
-                assert(group_count_y <= MAX_SKIN_COMPUTE_DISPATCH_THREAD_GROUPS_PER_DIMENSION);
+    result.m_scene_cache_hit = (NULL != task_data->m_mapped_file_input_stream_factory) && scene_cache_read(task_data->m_scene_cache_directory, file_name.c_str(), result.m_scene_cache_source_hash, &result.m_scene_cache_file, result.m_cooked_mesh_data);
 
-                command_buffer->dispatch(group_count_x, group_count_y, 1U);
-            }
+    result.m_scene_loaded = result.m_scene_cache_hit;
+
+    if (!result.m_scene_cache_hit)
+    {
+        // no input stream is shared between the tasks: each task creates its own memory input stream factory, while the mapped file input stream factory is shared (the files are mapped under the lock)
+        import_asset_input_stream_factory *const input_stream_factory = (NULL != task_data->m_mapped_file_input_stream_factory) ? task_data->m_mapped_file_input_stream_factory->get_input_stream_factory() : import_asset_init_memory_input_stream_factory();
 
-            mcrt_vector<BRX_COMPUTE_PASS_STORAGE_BUFFER_STORE_OPERATION> skinned_buffer_store_operations(skin_pipeline_buffers.size(), BRX_COMPUTE_PASS_STORAGE_BUFFER_STORE_OPERATION_FLUSH_FOR_READ_ONLY_STORAGE_BUFFER_AND_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BUFFER);
-            command_buffer->compute_pass_store(static_cast<uint32_t>(skin_pipeline_buffers.size()), skin_pipeline_buffers.data(), skinned_buffer_store_operations.data(), 0U, NULL, NULL);
+        import_uncached_scene_asset(file_name, input_stream_factory, &result);
 
-            command_buffer->end_debug_utils_label();
+        if (NULL == task_data->m_mapped_file_input_stream_factory)
+        {
+            import_asset_destroy_memory_input_stream_factory(input_stream_factory);
         }
     }
+}
 
-    // Update Bottom Level Acceleration Structure Pass
-    {
-        command_buffer->begin_debug_utils_label("Update Bottom Level Acceleration Structure Pass");
+static void import_uncached_scene_asset(mcrt_string const &file_name, import_asset_input_stream_factory *input_stream_factory, scene_asset_import_result *inout_result)
+{
+    assert(!inout_result->m_scene_cache_hit);
 
-        mcrt_vector<brx_intermediate_bottom_level_acceleration_structure *> update_intermediate_bottom_level_acceleration_structures;
+    if (import_gltf_scene_asset(inout_result->m_mesh_data, animation_frame_rate, input_stream_factory, file_name.c_str()))
+    {
+        // the mesh subsets are cooked by the "scene_cook_mesh_subset_task_main"
+        inout_result->m_cooked_mesh_data.resize(inout_result->m_mesh_data.size());
 
-        uint32_t intermediate_bottom_level_acceleration_structure_index = 0U;
-        for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+        for (size_t mesh_index = 0U; mesh_index < inout_result->m_mesh_data.size(); ++mesh_index)
         {
-            Demo_Mesh &scene_mesh = this->m_scene_meshes[mesh_index];
+            scene_mesh_data const &in_mesh_data = inout_result->m_mesh_data[mesh_index];
 
-            if (!scene_mesh.m_skinned)
-            {
-                for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                {
-                    Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+            scene_cache_mesh &out_cooked_mesh_data = inout_result->m_cooked_mesh_data[mesh_index];
 
-                    assert(scene_mesh_instance.m_skinned_subsets.empty());
+            out_cooked_mesh_data.m_skinned = in_mesh_data.m_skinned;
 
-                    assert(NULL == scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+            out_cooked_mesh_data.m_subsets.resize(in_mesh_data.m_subsets.size());
 
-                    assert(NULL == scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer);
-                }
-            }
-            else
-            {
-                for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                {
-                    Demo_Mesh_Instance &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+            out_cooked_mesh_data.m_instance_model_transforms.resize(in_mesh_data.m_instances.size());
 
-                    assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
+            for (size_t instance_index = 0U; instance_index < in_mesh_data.m_instances.size(); ++instance_index)
+            {
+                out_cooked_mesh_data.m_instance_model_transforms[instance_index] = in_mesh_data.m_instances[instance_index].m_model_transform;
+            }
+        }
 
-                    mcrt_vector<brx_acceleration_structure_build_input_read_only_buffer const *> bottom_level_acceleration_structure_geometry_vertex_position_buffers(scene_mesh_instance.m_skinned_subsets.size());
+        inout_result->m_scene_loaded = true;
+    }
+}
 
-                    for (size_t mesh_subset_index = 0U; mesh_subset_index < scene_mesh_instance.m_skinned_subsets.size(); ++mesh_subset_index)
-                    {
-                        Demo_Mesh_Skinned_Subset const &scene_mesh_skin_subset = scene_mesh_instance.m_skinned_subsets[mesh_subset_index];
+static void scene_cache_write_task_main(uint32_t file_name_index, void *user_data)
+{
+    scene_asset_import_task_data const *const task_data = static_cast<scene_asset_import_task_data const *>(user_data);
 
-                        bottom_level_acceleration_structure_geometry_vertex_position_buffers[mesh_subset_index] = scene_mesh_skin_subset.m_skinned_vertex_position_buffer->get_acceleration_structure_build_input_read_only_buffer();
-                    }
+    mcrt_string const &file_name = (*task_data->m_file_names)[file_name_index];
 
-                    command_buffer->update_intermediate_bottom_level_acceleration_structure(scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure, bottom_level_acceleration_structure_geometry_vertex_position_buffers.data(), scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer);
-                    update_intermediate_bottom_level_acceleration_structures.push_back(scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+    scene_asset_import_result const &result = task_data->m_results[file_name_index];
 
-                    ++intermediate_bottom_level_acceleration_structure_index;
-                }
+    if ((NULL != task_data->m_mapped_file_input_stream_factory) && result.m_scene_loaded && (!result.m_scene_cache_hit))
+    {
+        // the skinned scenes are NOT cached (see "scene_cache_write"), and are imported from the glTF again at every launch
+        bool scene_cacheable = true;
+        for (size_t mesh_index = 0U; mesh_index < result.m_cooked_mesh_data.size(); ++mesh_index)
+        {
+            if (result.m_cooked_mesh_data[mesh_index].m_skinned)
+            {
+                scene_cacheable = false;
+                break;
             }
         }
-        assert(update_intermediate_bottom_level_acceleration_structures.size() == intermediate_bottom_level_acceleration_structure_index);
-
-        command_buffer->update_intermediate_bottom_level_acceleration_structure_store(static_cast<uint32_t>(update_intermediate_bottom_level_acceleration_structures.size()), update_intermediate_bottom_level_acceleration_structures.data());
 
-        command_buffer->end_debug_utils_label();
+        if (scene_cacheable)
+        {
+            // the scene is imported again at the next launch if the scene cache fails to be written
+            scene_cache_write(task_data->m_scene_cache_directory, file_name.c_str(), result.m_scene_cache_source_hash, result.m_cooked_mesh_data);
+        }
     }
+}
 
-    // Update Top Level Acceleration Structure Pass
-    {
-        command_buffer->begin_debug_utils_label("Update Top Level Acceleration Structure Pass");
+static void image_asset_import_task_main(uint32_t image_asset_import_task_index, void *user_data)
+{
+    Demo_Streaming_Texture *const task = static_cast<Demo_Streaming_Texture *>(user_data) + image_asset_import_task_index;
 
-        uint32_t scene_instance_index = 0U;
-        uint32_t scene_geometry_index = 0U;
-        for (size_t mesh_index = 0U; mesh_index < this->m_scene_meshes.size(); ++mesh_index)
+    // the failure is NOT fatal, and the texture is skipped by "update_texture_streaming"
+    task->m_decoded = task->m_pfn_import_image_asset_data_from_input_stream(task->m_input_stream, &task->m_header, task->m_data_offset, task->m_staging_upload_buffer_host_memory_range_base, task->m_header.mip_levels, &task->m_subresource_memcpy_dests[0]);
+}
+
+static void texture_streaming_thread_main(Demo_Texture_Streaming_Thread_Context *context)
+{
+    uint32_t decoded_count = 0U;
+
+    while (decoded_count < context->m_streaming_texture_count)
+    {
+        uint32_t prepared_count;
         {
-            Demo_Mesh const &scene_mesh = this->m_scene_meshes[mesh_index];
+            std::unique_lock<std::mutex> lock(context->m_mutex);
 
-            if (!scene_mesh.m_skinned)
+            // wait for the render thread to allocate the staging memory
+            while ((!context->m_stop) && (context->m_prepared_count == decoded_count))
             {
-                for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                {
-                    Demo_Mesh_Instance const &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
-
-                    assert(NULL == scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure);
+                context->m_condition_variable.wait(lock);
+            }
 
-                    BRX_TOP_LEVEL_ACCELERATION_STRUCTURE_INSTANCE top_level_acceleration_structure_instance = {
-                        {},
-                        scene_instance_index,
-                        0XFFU,
-                        true,
-                        false,
-                        false,
-                        false,
-                        scene_mesh.m_compacted_bottom_level_acceleration_structure->get_bottom_level_acceleration_structure()};
+            if (context->m_stop)
+            {
+                break;
+            }
 
-                    DirectX::XMStoreFloat3x4(reinterpret_cast<DirectX::XMFLOAT3X4 *>(&top_level_acceleration_structure_instance.transform_matrix), DirectX::XMLoadFloat4x4(&scene_mesh_instance.m_model_transform));
+            prepared_count = context->m_prepared_count;
+        }
 
-                    this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index]->write_instance(scene_instance_index, &top_level_acceleration_structure_instance);
+        // the textures are decoded in order, and the batch is published after all textures of the batch have been decoded
+        uint32_t const batch_end = std::min(prepared_count, decoded_count + texture_streaming_batch_texture_count);
 
-                    ++scene_instance_index;
-                }
+        context->m_decode_worker_pool.parallel_for(batch_end - decoded_count, image_asset_import_task_main, context->m_streaming_textures + decoded_count);
 
-                uint32_t const mesh_geometry_count = static_cast<uint32_t>(scene_mesh.m_subsets.size());
-                scene_geometry_index += mesh_geometry_count;
-            }
-            else
-            {
-                assert(NULL == scene_mesh.m_compacted_bottom_level_acceleration_structure);
+        decoded_count = batch_end;
 
-                for (size_t mesh_instance_index = 0U; mesh_instance_index < scene_mesh.m_instances.size(); ++mesh_instance_index)
-                {
-                    Demo_Mesh_Instance const &scene_mesh_instance = scene_mesh.m_instances[mesh_instance_index];
+        context->m_decoded_count.store(decoded_count, std::memory_order_release);
+    }
+}
 
-                    assert(scene_mesh.m_subsets.size() == scene_mesh_instance.m_skinned_subsets.size());
+static inline void free_streaming_texture_staging_upload_memory(brx_device *device, staging_upload_ring *staging_upload_ring, Demo_Streaming_Texture *streaming_texture)
+{
+    assert(NULL != streaming_texture->m_staging_upload_buffer);
 
-                    BRX_TOP_LEVEL_ACCELERATION_STRUCTURE_INSTANCE top_level_acceleration_structure_instance = {
-                        {},
-                        scene_instance_index,
-                        0XFFU,
-                        true,
-                        false,
-                        false,
-                        false,
-                        scene_mesh_instance.m_intermediate_bottom_level_acceleration_structure->get_bottom_level_acceleration_structure()};
+    if (0U != streaming_texture->m_staging_upload_ring_region_size)
+    {
+        staging_upload_ring->free(streaming_texture->m_staging_upload_ring_region_size);
+    }
+    else
+    {
+        device->destroy_staging_upload_buffer(streaming_texture->m_staging_upload_buffer);
+    }
 
-                    DirectX::XMStoreFloat3x4(reinterpret_cast<DirectX::XMFLOAT3X4 *>(&top_level_acceleration_structure_instance.transform_matrix), DirectX::XMLoadFloat4x4(&scene_mesh_instance.m_model_transform));
+    streaming_texture->m_staging_upload_buffer = NULL;
+    streaming_texture->m_staging_upload_buffer_offset = 0U;
+    streaming_texture->m_staging_upload_ring_region_size = 0U;
+    streaming_texture->m_staging_upload_buffer_host_memory_range_base = NULL;
+}
 
-                    this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index]->write_instance(scene_instance_index, &top_level_acceleration_structure_instance);
+static inline uint64_t apply_texture_memory_budget(uint64_t texture_memory_budget, mcrt_vector<Demo_Streaming_Texture> &inout_streaming_textures)
+{
+    // the size of the mip is approximated by the size of the subresource in the staging upload buffer
+    uint64_t texture_memory_size = 0U;
+    for (size_t streaming_texture_index = 0U; streaming_texture_index < inout_streaming_textures.size(); ++streaming_texture_index)
+    {
+        Demo_Streaming_Texture const &streaming_texture = inout_streaming_textures[streaming_texture_index];
 
-                    ++scene_instance_index;
+        assert(0U == streaming_texture.m_skipped_mip_level_count);
 
-                    uint32_t const mesh_geometry_count = static_cast<uint32_t>(scene_mesh_instance.m_skinned_subsets.size());
-                    scene_geometry_index += mesh_geometry_count;
-                }
-            }
+        for (uint32_t mip_level = 0U; mip_level < streaming_texture.m_header.mip_levels; ++mip_level)
+        {
+            texture_memory_size += static_cast<uint64_t>(streaming_texture.m_subresource_memcpy_dests[mip_level].output_row_pitch) * static_cast<uint64_t>(streaming_texture.m_subresource_memcpy_dests[mip_level].output_row_count);
         }
-        assert(scene_instance_count == scene_instance_index);
-        assert(scene_geometry_count == scene_geometry_index);
-
-        command_buffer->update_top_level_acceleration_structure(this->m_scene_top_level_acceleration_structure, this->m_scene_top_level_acceleration_structure_instance_upload_buffers[frame_throttling_index], this->m_scene_top_level_acceleration_structure_update_scratch_buffer);
-
-        command_buffer->update_top_level_acceleration_structure_store(this->m_scene_top_level_acceleration_structure);
+    }
 
-        command_buffer->end_debug_utils_label();
+    if (0U == texture_memory_budget)
+    {
+        return texture_memory_size;
     }
 
-    // GBuffer Pass
+    // the most detailed mip of the largest texture is dropped first, and the least detailed mip of each texture is always resident
+    while (texture_memory_size > texture_memory_budget)
     {
-        brx_storage_image const *storage_images[] = {
-            this->m_gbuffer_depth_image,
-            this->m_gbuffer_normal_image};
+        size_t largest_streaming_texture_index = static_cast<size_t>(-1);
+        uint64_t largest_mip_size = 0U;
+        for (size_t streaming_texture_index = 0U; streaming_texture_index < inout_streaming_textures.size(); ++streaming_texture_index)
+        {
+            Demo_Streaming_Texture const &streaming_texture = inout_streaming_textures[streaming_texture_index];
 
-        BRX_COMPUTE_PASS_STORAGE_IMAGE_LOAD_OPERATION const storage_image_load_operations[] = {
-            BRX_COMPUTE_PASS_STORAGE_IMAGE_LOAD_OPERATION_DONT_CARE,
-            BRX_COMPUTE_PASS_STORAGE_IMAGE_LOAD_OPERATION_DONT_CARE};
-        static_assert(sizeof(storage_images) / sizeof(storage_images[0]) == sizeof(storage_image_load_operations) / sizeof(storage_image_load_operations[0]), "");
+            // the width and the height of the most detailed mip of the block compressed image should be multiples of the block size (4) (which is required by the D3D12)
+            // only the R8G8B8A8 (transcoded from the PNG) is NOT block compressed
+            uint32_t const next_skipped_mip_level_count = streaming_texture.m_skipped_mip_level_count + 1U;
+            bool const block_compressed = (BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_UNORM != streaming_texture.m_header.format) && (BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SRGB != streaming_texture.m_header.format);
+            bool const next_most_detailed_mip_aligned = (!block_compressed) || ((0U == (std::max(1U, streaming_texture.m_header.width >> next_skipped_mip_level_count) & 3U)) && (0U == (std::max(1U, streaming_texture.m_header.height >> next_skipped_mip_level_count) & 3U)));
 
-        BRX_COMPUTE_PASS_STORAGE_IMAGE_STORE_OPERATION const storage_image_store_operations[] = {
-            BRX_COMPUTE_PASS_STORAGE_IMAGE_STORE_OPERATION_FLUSH_FOR_SAMPLED_IMAGE,
-            BRX_COMPUTE_PASS_STORAGE_IMAGE_STORE_OPERATION_FLUSH_FOR_SAMPLED_IMAGE};
-        static_assert(sizeof(storage_images) / sizeof(storage_images[0]) == sizeof(storage_image_store_operations) / sizeof(storage_image_store_operations[0]), "");
+            if ((next_skipped_mip_level_count < streaming_texture.m_header.mip_levels) && next_most_detailed_mip_aligned)
+            {
+                BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const &most_detailed_mip = streaming_texture.m_subresource_memcpy_dests[streaming_texture.m_skipped_mip_level_count];
 
-        command_buffer->begin_debug_utils_label("GBuffer Pass");
+                uint64_t const mip_size = static_cast<uint64_t>(most_detailed_mip.output_row_pitch) * static_cast<uint64_t>(most_detailed_mip.output_row_count);
 
-        command_buffer->compute_pass_load(0U, NULL, NULL, sizeof(storage_images) / sizeof(storage_images[0]), storage_images, storage_image_load_operations);
+                if (mip_size > largest_mip_size)
+                {
+                    largest_streaming_texture_index = streaming_texture_index;
+                    largest_mip_size = mip_size;
+                }
+            }
+        }
 
-        command_buffer->bind_compute_pipeline(this->m_gbuffer_pipeline);
+        if (static_cast<size_t>(-1) == largest_streaming_texture_index)
+        {
+            // the budget is too small even for the least detailed mips
+            break;
+        }
 
-        brx_descriptor_set *const descritor_sets[] = {
-            this->m_gbuffer_pipeline_none_update_descriptor_set,
-            this->m_gbuffer_pipeline_none_update_bindless_buffer_descriptor_set,
-            this->m_gbuffer_pipeline_none_update_bindless_texture_descriptor_set};
-        uint32_t const dynamic_offsets[] = {
-            tbb_align_up(static_cast<uint32_t>(sizeof(common_none_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * frame_throttling_index,
-            tbb_align_up(static_cast<uint32_t>(sizeof(gbuffer_pipeline_none_update_set_instance_information_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * frame_throttling_index};
-        command_buffer->bind_compute_descriptor_sets(this->m_gbuffer_pipeline_layout, sizeof(descritor_sets) / sizeof(descritor_sets[0]), descritor_sets, sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0]), dynamic_offsets);
+        ++inout_streaming_textures[largest_streaming_texture_index].m_skipped_mip_level_count;
+        texture_memory_size -= largest_mip_size;
+    }
 
-        command_buffer->dispatch(this->m_intermediate_width, this->m_intermediate_height, 1U);
+    return texture_memory_size;
+}
 
-        command_buffer->compute_pass_store(0U, NULL, NULL, sizeof(storage_images) / sizeof(storage_images[0]), storage_images, storage_image_store_operations);
+static inline void drop_skipped_streaming_texture_mips(uint32_t staging_upload_buffer_offset_alignment, uint32_t staging_upload_buffer_row_pitch_alignment, Demo_Streaming_Texture *inout_streaming_texture)
+{
+    uint32_t const skipped_mip_level_count = inout_streaming_texture->m_skipped_mip_level_count;
+    assert(skipped_mip_level_count < inout_streaming_texture->m_header.mip_levels);
 
-        command_buffer->end_debug_utils_label();
+    if (0U == skipped_mip_level_count)
+    {
+        return;
     }
 
-    // Ambient Occlusion Pass
+    // the mips of the DDS and the PVR are tightly packed from the most detailed mip, and the decoder starts from the first resident mip
+    // the PNG is always decoded from the beginning, and the transcoder skips the mips which are more detailed than the header
+    if (texture_transcode_png_image_asset_data_from_input_stream != inout_streaming_texture->m_pfn_import_image_asset_data_from_input_stream)
     {
-        brx_storage_image const *storage_images[] = {
-            this->m_ambient_occlusion_image};
+        for (uint32_t mip_level = 0U; mip_level < skipped_mip_level_count; ++mip_level)
+        {
+            BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const &skipped_mip = inout_streaming_texture->m_subresource_memcpy_dests[mip_level];
 
-        BRX_COMPUTE_PASS_STORAGE_IMAGE_LOAD_OPERATION const storage_image_load_operations[] = {
-            BRX_COMPUTE_PASS_STORAGE_IMAGE_LOAD_OPERATION_DONT_CARE};
-        static_assert(sizeof(storage_images) / sizeof(storage_images[0]) == sizeof(storage_image_load_operations) / sizeof(storage_image_load_operations[0]), "");
+            inout_streaming_texture->m_data_offset += static_cast<size_t>(skipped_mip.output_row_size) * static_cast<size_t>(skipped_mip.output_row_count) * static_cast<size_t>(skipped_mip.output_slice_count);
+        }
+    }
 
-        BRX_COMPUTE_PASS_STORAGE_IMAGE_STORE_OPERATION const storage_image_store_operations[] = {
-            BRX_COMPUTE_PASS_STORAGE_IMAGE_STORE_OPERATION_FLUSH_FOR_SAMPLED_IMAGE};
-        static_assert(sizeof(storage_images) / sizeof(storage_images[0]) == sizeof(storage_image_store_operations) / sizeof(storage_image_store_operations[0]), "");
+    inout_streaming_texture->m_header.width = std::max(1U, inout_streaming_texture->m_header.width >> skipped_mip_level_count);
+    inout_streaming_texture->m_header.height = std::max(1U, inout_streaming_texture->m_header.height >> skipped_mip_level_count);
+    inout_streaming_texture->m_header.mip_levels -= skipped_mip_level_count;
 
-        command_buffer->begin_debug_utils_label("Ambient Occlusion Pass");
+    uint32_t const subresource_count = inout_streaming_texture->m_header.mip_levels;
+    inout_streaming_texture->m_subresource_memcpy_dests.resize(subresource_count);
 
-        command_buffer->compute_pass_load(0U, NULL, NULL, sizeof(storage_images) / sizeof(storage_images[0]), storage_images, storage_image_load_operations);
+    // the staging memory has NOT been allocated yet
+    assert(NULL == inout_streaming_texture->m_staging_upload_buffer);
+    inout_streaming_texture->m_staging_upload_size = brx_sampled_asset_image_import_calculate_subresource_memcpy_dests(inout_streaming_texture->m_header.format, inout_streaming_texture->m_header.width, inout_streaming_texture->m_header.height, 1U, inout_streaming_texture->m_header.mip_levels, 1U, 0U, staging_upload_buffer_offset_alignment, staging_upload_buffer_row_pitch_alignment, subresource_count, &inout_streaming_texture->m_subresource_memcpy_dests[0]);
+}
 
-        command_buffer->bind_compute_pipeline(this->m_ambient_occlusion_pipeline);
+static void draw_skin_task_main(uint32_t chunk_index, void *user_data)
+{
+    draw_skin_task_data const *const task_data = static_cast<draw_skin_task_data const *>(user_data);
 
-        brx_descriptor_set *const descritor_sets[] = {
-            this->m_ambient_occlusion_pipeline_none_update_descriptor_set};
-        uint32_t const dynamic_offsets[] = {
-            tbb_align_up(static_cast<uint32_t>(sizeof(common_none_update_set_uniform_buffer_binding)), this->m_uniform_upload_buffer_offset_alignment) * frame_throttling_index};
-        command_buffer->bind_compute_descriptor_sets(this->m_ambient_occlusion_pipeline_layout, sizeof(descritor_sets) / sizeof(descritor_sets[0]), descritor_sets, sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0]), dynamic_offsets);
+#ifndef NDEBUG
+    // the same as the render thread, no heap memory is allocated by the draw tasks on the worker threads
+    uint64_t const steady_state_allocation_count = allocation_counter_get_thread_allocation_count();
+#endif
 
-        command_buffer->dispatch(this->m_intermediate_width, this->m_intermediate_height, 1U);
+    uint32_t const chunk_begin = draw_task_chunk_instance_count * chunk_index;
+    uint32_t const chunk_end = std::min(chunk_begin + draw_task_chunk_instance_count, task_data->m_skinned_mesh_instance_count);
+    assert(chunk_begin < chunk_end);
 
-        command_buffer->compute_pass_store(0U, NULL, NULL, sizeof(storage_images) / sizeof(storage_images[0]), storage_images, storage_image_store_operations);
+    for (uint32_t skinned_mesh_instance_index = chunk_begin; skinned_mesh_instance_index < chunk_end; ++skinned_mesh_instance_index)
+    {
+        Demo_Mesh_Instance const *const scene_mesh_instance = task_data->m_skinned_mesh_instances[skinned_mesh_instance_index];
 
-        command_buffer->end_debug_utils_label();
+        scene_animation_pose const &pose = scene_mesh_instance->m_animation_skeleton.get_pose(task_data->m_animation_frame_index + scene_mesh_instance->m_animation_frame_offset);
+
+        assert(pose.get_joint_count() == scene_mesh_instance->m_skin_pipeline_per_mesh_instance_update_joint_count);
+
+        skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding *const skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding_destination = reinterpret_cast<skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding *>(reinterpret_cast<uintptr_t>(task_data->m_skin_pipeline_per_mesh_instance_update_uniform_buffer_host_memory_range_base) + scene_mesh_instance->m_skin_pipeline_per_mesh_instance_update_dynamic_offset);
+
+        for (uint32_t joint_index = 0U; joint_index < scene_mesh_instance->m_skin_pipeline_per_mesh_instance_update_joint_count; ++joint_index)
+        {
+            unit_dual_quaternion_from_rigid_transform(&skin_pipeline_per_mesh_instance_update_set_uniform_buffer_binding_destination->g_dual_quaternions[2 * joint_index], pose.get_quaternion(joint_index), pose.get_translation(joint_index));
+        }
     }
+
+    assert(allocation_counter_get_thread_allocation_count() == steady_state_allocation_count);
 }
 
-static inline uint32_t tbb_align_up(uint32_t value, uint32_t alignment)
+static void draw_top_level_acceleration_structure_task_main(uint32_t chunk_index, void *user_data)
 {
-    //
-    //  Copyright (c) 2005-2019 Intel Corporation
-    //
-    //  Licensed under the Apache License, Version 2.0 (the "License");
-    //  you may not use this file except in compliance with the License.
-    //  You may obtain a copy of the License at
-    //
-    //      http://www.apache.org/licenses/LICENSE-2.0
-    //
-    //  Unless required by applicable law or agreed to in writing, software
-    //  distributed under the License is distributed on an "AS IS" BASIS,
-    //  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-    //  See the License for the specific language governing permissions and
-    //  limitations under the License.
-    //
+    draw_top_level_acceleration_structure_task_data const *const task_data = static_cast<draw_top_level_acceleration_structure_task_data const *>(user_data);
 
-    // [alignUp](https://github.com/oneapi-src/oneTBB/blob/tbb_2019/src/tbbmalloc/shared_utils.h#L42)
+#ifndef NDEBUG
+    uint64_t const steady_state_allocation_count = allocation_counter_get_thread_allocation_count();
+#endif
 
-    assert(alignment != static_cast<uint32_t>(0));
+    uint32_t const chunk_begin = draw_task_chunk_instance_count * chunk_index;
+    uint32_t const chunk_end = std::min(chunk_begin + draw_task_chunk_instance_count, task_data->m_scene_instance_count);
+    assert(chunk_begin < chunk_end);
 
-    // power-of-2 alignment
-    assert((alignment & (alignment - static_cast<uint32_t>(1))) == static_cast<uint32_t>(0));
+    for (uint32_t scene_instance_index = chunk_begin; scene_instance_index < chunk_end; ++scene_instance_index)
+    {
+        Demo_Mesh const *const scene_mesh = task_data->m_scene_instances[scene_instance_index].m_mesh;
+        Demo_Mesh_Instance const *const scene_mesh_instance = task_data->m_scene_instances[scene_instance_index].m_mesh_instance;
+
+        BRX_TOP_LEVEL_ACCELERATION_STRUCTURE_INSTANCE top_level_acceleration_structure_instance = {
+            {},
+            scene_instance_index,
+            0XFFU,
+            true,
+            false,
+            false,
+            false,
+            (!scene_mesh->m_skinned) ? scene_mesh->m_compacted_bottom_level_acceleration_structure->get_bottom_level_acceleration_structure() : scene_mesh_instance->m_intermediate_bottom_level_acceleration_structure->get_bottom_level_acceleration_structure()};
+
+        DirectX::XMStoreFloat3x4(reinterpret_cast<DirectX::XMFLOAT3X4 *>(&top_level_acceleration_structure_instance.transform_matrix), DirectX::XMLoadFloat4x4(&scene_mesh_instance->m_model_transform));
+
+        task_data->m_top_level_acceleration_structure_instance_upload_buffer->write_instance(scene_instance_index, &top_level_acceleration_structure_instance);
+    }
 
-    return (((value - static_cast<uint32_t>(1)) | (alignment - static_cast<uint32_t>(1))) + static_cast<uint32_t>(1));
+    assert(allocation_counter_get_thread_allocation_count() == steady_state_allocation_count);
 }
@@ -18,9 +18,19 @@
 #ifndef _DEMO_H_
 #define _DEMO_H_ 1
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "support/frame_throttling.h"
+#include "support/bindless_descriptor_allocator.h"
+#include "support/mapped_file_input_stream_factory.h"
+#include "support/staging_upload_allocator.h"
+#include "support/worker_pool.h"
 #include "../thirdparty/Brioche/include/brx_device.h"
 #include "../thirdparty/Import-Asset/include/import_scene_asset.h"
+#include "../thirdparty/Import-Asset/include/import_image_asset.h"
+#include "../thirdparty/Import-Asset/include/import_asset_input_stream.h"
 
 // TLAS - Scene
 // Instance - Mesh Instance
@@ -38,9 +48,11 @@ struct Demo_Mesh_Instance
 {
 	DirectX::XMFLOAT4X4 m_model_transform;
 	scene_animation_skeleton m_animation_skeleton;
+	// the replicated instances (by the stress mode) start at the different frames of the animation
+	uint32_t m_animation_frame_offset;
 	mcrt_vector<Demo_Mesh_Skinned_Subset> m_skinned_subsets;
-	brx_uniform_upload_buffer *m_skin_pipeline_per_mesh_instance_update_uniform_buffer;
-	brx_descriptor_set *m_skin_pipeline_per_mesh_instance_update_descriptor_set;
+	uint32_t m_skin_pipeline_per_mesh_instance_update_joint_count;
+	uint32_t m_skin_pipeline_per_mesh_instance_update_dynamic_offset;
 	brx_intermediate_bottom_level_acceleration_structure *m_intermediate_bottom_level_acceleration_structure;
 	brx_scratch_buffer *m_intermediate_bottom_level_acceleration_structure_update_scratch_buffer;
 };
@@ -51,10 +63,15 @@ struct Demo_Mesh_Subset
 	uint32_t m_index_count;
 	BRX_GRAPHICS_PIPELINE_INDEX_TYPE m_index_type;
 	brx_storage_asset_buffer *m_vertex_position_buffer;
+	// the float vertex positions used to build the bottom level acceleration structure when the vertex position buffer is quantized (destroyed after the build)
+	brx_storage_asset_buffer *m_acceleration_structure_build_input_vertex_position_buffer;
+	// the vertex varying buffer is only created for the skinned mesh subsets (as the input of the skin pipeline), and the vertex varying of the static mesh subsets is sub-allocated from the geometry pool buffer
 	brx_storage_asset_buffer *m_vertex_varying_buffer;
+	uint32_t m_vertex_varying_geometry_pool_offset;
 	brx_storage_asset_buffer *m_vertex_joint_buffer;
 	brx_storage_asset_buffer *m_index_buffer;
-	brx_storage_asset_buffer *m_information_buffer;
+	// the information is always sub-allocated from the geometry pool buffer
+	uint32_t m_information_geometry_pool_offset;
 	brx_sampled_asset_image *m_normal_texture;
 	brx_sampled_asset_image *m_emissive_texture;
 	brx_sampled_asset_image *m_base_color_texture;
@@ -69,6 +86,78 @@ struct Demo_Mesh
 	brx_compacted_bottom_level_acceleration_structure *m_compacted_bottom_level_acceleration_structure;
 };
 
+// the staging memory is allocated on the render thread, the image data is decoded into the staging memory on the streaming thread, and uploaded on the upload queue several frames later
+struct Demo_Streaming_Texture
+{
+	// the factory which has created the input stream (the cooked textures are read from another directory than the other assets)
+	import_asset_input_stream_factory *m_input_stream_factory;
+	import_asset_input_stream *m_input_stream;
+	bool (*m_pfn_import_image_asset_data_from_input_stream)(import_asset_input_stream *, IMPORT_ASSET_IMAGE_HEADER const *, size_t, void *, size_t, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *);
+	IMPORT_ASSET_IMAGE_HEADER m_header;
+	size_t m_data_offset;
+	mcrt_vector<BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST> m_subresource_memcpy_dests;
+	uint32_t m_staging_upload_size;
+	// suballocated from the staging upload ring, or a dedicated staging upload buffer (when the region size is zero) if the texture is larger than the ring
+	brx_staging_upload_buffer *m_staging_upload_buffer;
+	uint32_t m_staging_upload_buffer_offset;
+	uint32_t m_staging_upload_ring_region_size;
+	void *m_staging_upload_buffer_host_memory_range_base;
+	// the most detailed mips are NOT resident when the scene textures exceed the memory budget, and the mip "i" of the image is the mip "i + skipped mip level count" of the asset
+	// after the skipped mips have been dropped, the header, the data offset and the memcpy destinations only describe the resident mips
+	uint32_t m_skipped_mip_level_count;
+	brx_sampled_asset_image *m_image;
+	// written by the streaming thread before the decoded count is published
+	// "false" when the image data fails to be decoded (e.g. the corrupted PNG), and the place holder texture is kept in the bindless slot
+	bool m_decoded;
+};
+
+// produced by the simulation (the input and the animation), and consumed by the draw (which may be one frame behind on the render thread)
+// the model transforms of the instances are NOT changed after the loading, and thus are NOT included
+struct Demo_Frame_Packet
+{
+	float m_interval_time;
+	DirectX::XMFLOAT4X4 m_view_transform;
+	size_t m_animation_frame_index;
+};
+
+// the instance "i" of the top level acceleration structure
+struct Demo_Scene_Instance
+{
+	Demo_Mesh const *m_mesh;
+	Demo_Mesh_Instance const *m_mesh_instance;
+};
+
+// the dispatch of the skin pass for one skinned subset of one skinned instance
+struct Demo_Skin_Pass_Dispatch
+{
+	Demo_Mesh_Instance const *m_mesh_instance;
+	brx_descriptor_set *m_skin_pipeline_per_mesh_skinned_subset_update_descriptor_set;
+	uint32_t m_group_count_x;
+	uint32_t m_group_count_y;
+};
+
+// shared by the render thread and the streaming thread
+struct Demo_Texture_Streaming_Thread_Context
+{
+	uint32_t m_streaming_texture_count;
+	Demo_Streaming_Texture *m_streaming_textures;
+	std::mutex m_mutex;
+	std::condition_variable m_condition_variable;
+	// [0, prepared count) has been allocated the staging memory (only written by the render thread with the mutex locked)
+	uint32_t m_prepared_count;
+	bool m_stop;
+	// [0, decoded count) has been decoded (only written by the streaming thread)
+	std::atomic_uint32_t m_decoded_count;
+	// the textures of each batch are decoded in parallel (only used by the streaming thread)
+	worker_pool m_decode_worker_pool;
+};
+
+// update uniform buffer, skin, update bottom level acceleration structure, update top level acceleration structure, gbuffer, ambient occlusion
+static constexpr uint32_t const DEMO_STRESS_REPORT_PASS_COUNT = 6U;
+
+// skinned mesh instances, scene instances, skin pass storage buffers, skin pass load operations, skin pass store operations, skin pass dispatches, update intermediate bottom level acceleration structures, update geometry vertex position buffers
+static constexpr uint32_t const DEMO_DRAW_LIST_COUNT = 8U;
+
 class Demo
 {
 	brx_pipeline_layout *m_skin_pipeline_layout;
@@ -84,20 +173,63 @@ class Demo
 	brx_sampled_asset_image *m_place_holder_texture;
 
 	mcrt_vector<Demo_Mesh> m_scene_meshes;
+	// the vertex and index buffers which are used as the inputs of the acceleration structure build can NOT be sub-allocated (since the geometry of the acceleration structure has no offset)
+	brx_storage_asset_buffer *m_geometry_pool_buffer;
 	mcrt_vector<brx_sampled_asset_image *> m_scene_textures;
 
+	// the input streams of the streaming textures are read until the streaming has finished
+	bool m_use_mapped_file_input_stream_factory;
+	mapped_file_input_stream_factory m_mapped_file_input_stream_factory;
+	import_asset_input_stream_factory *m_input_stream_factory;
+	// the textures cooked by the cooker, which are NOT available when the assets embedded in the executable are used
+	bool m_use_cooked_texture_input_stream_factory;
+	mapped_file_input_stream_factory m_cooked_texture_input_stream_factory;
+
+	// the bindless slot of the scene texture "i" is "base + i", which is written with the place holder texture until the upload of the scene texture has completed
+	// UINT32_MAX when the scene textures do NOT fit in the bindless texture slots (the place holder is used instead)
+	// the streaming textures (and the command buffers) are released after all scene textures have been uploaded
+	uint32_t m_scene_texture_bindless_base_index;
+	mcrt_vector<Demo_Streaming_Texture> m_streaming_textures;
+	std::thread m_texture_streaming_thread;
+	Demo_Texture_Streaming_Thread_Context m_texture_streaming_thread_context;
+	// the staging memory of the streaming textures is bounded by the size of the ring
+	staging_upload_ring m_texture_streaming_staging_upload_ring;
+	// [retired count, submitted count) is being uploaded
+	uint32_t m_texture_streaming_submitted_count;
+	uint32_t m_texture_streaming_retired_count;
+	uint32_t m_texture_streaming_submitted_frame_throttling_index;
+	brx_upload_command_buffer *m_texture_streaming_upload_command_buffer;
+	brx_graphics_command_buffer *m_texture_streaming_graphics_command_buffer;
+	brx_upload_queue *m_texture_streaming_upload_queue;
+	brx_graphics_queue *m_texture_streaming_graphics_queue;
+	brx_fence *m_texture_streaming_fence;
+	// the lists of the batch are reserved when the streaming starts, and are NOT reallocated by "update_texture_streaming"
+	mcrt_vector<brx_sampled_image const *> m_texture_streaming_retired_sampled_images;
+	mcrt_vector<brx_sampled_asset_image const *> m_texture_streaming_uploaded_sampled_asset_images;
+	mcrt_vector<uint32_t> m_texture_streaming_uploaded_destination_mip_levels;
+
 	brx_top_level_acceleration_structure *m_scene_top_level_acceleration_structure;
 	brx_top_level_acceleration_structure_instance_upload_buffer *m_scene_top_level_acceleration_structure_instance_upload_buffers[FRAME_THROTTLING_COUNT];
 	brx_scratch_buffer *m_scene_top_level_acceleration_structure_update_scratch_buffer;
 
 	uint32_t m_uniform_upload_buffer_offset_alignment;
 	brx_uniform_upload_buffer *m_common_gbuffer_pipeline_ambient_occlusion_pipeline_none_update_uniform_buffer;
-	brx_uniform_upload_buffer *m_gbuffer_pipeline_none_update_instance_information_uniform_buffer;
+	// the joint palettes of all skinned instances are linearly allocated from the region of the current frame
+	uint32_t m_skin_pipeline_per_mesh_instance_update_uniform_buffer_frame_size;
+	brx_uniform_upload_buffer *m_skin_pipeline_per_mesh_instance_update_uniform_buffer;
+	brx_descriptor_set *m_skin_pipeline_per_mesh_instance_update_descriptor_set;
+
+	uint32_t m_scene_instance_count;
+	uint32_t m_scene_geometry_count;
+	brx_storage_asset_buffer *m_scene_instance_information_buffer;
+	brx_storage_asset_buffer *m_scene_geometry_information_buffer;
 
 	brx_descriptor_set_layout *m_gbuffer_pipeline_none_update_descriptor_set_layout;
 	brx_descriptor_set *m_gbuffer_pipeline_none_update_descriptor_set;
 	brx_descriptor_set *m_gbuffer_pipeline_none_update_bindless_buffer_descriptor_set;
 	brx_descriptor_set *m_gbuffer_pipeline_none_update_bindless_texture_descriptor_set;
+	bindless_descriptor_allocator m_bindless_buffer_allocator;
+	bindless_descriptor_allocator m_bindless_texture_allocator;
 	brx_descriptor_set_layout *m_ambient_occlusion_pipeline_none_update_descriptor_set_layout;
 	brx_descriptor_set *m_ambient_occlusion_pipeline_none_update_descriptor_set;
 
@@ -107,8 +239,54 @@ class Demo
 	brx_storage_image *m_gbuffer_normal_image;
 	brx_storage_image *m_ambient_occlusion_image;
 
+	// only used by the simulation
 	float m_animation_time;
 
+	// the animation frame of the skinned vertices and the acceleration structures
+	size_t m_acceleration_structure_animation_frame_index;
+
+	// the joint palettes and the instances of the top level acceleration structure are written by the worker pool in chunks
+	// the command buffer is still recorded on the render thread (in the same order), since there is no secondary command buffer in the device abstraction
+	worker_pool m_draw_worker_pool;
+	mcrt_vector<Demo_Mesh_Instance *> m_skinned_mesh_instances;
+	mcrt_vector<Demo_Scene_Instance> m_scene_instances;
+
+	// the lists used by the draw are built once after the loading (since the scene is NOT changed), and no heap memory is allocated by the draw in the steady state
+	// checked in the debug build: the "operator new" is counted on the render thread and in the draw tasks on the worker threads, and the storage of the lists (allocated by the McRT-Malloc which is NOT counted) is compared with the storage recorded after the loading
+	mcrt_vector<brx_storage_buffer const *> m_skin_pass_storage_buffers;
+	mcrt_vector<BRX_COMPUTE_PASS_STORAGE_BUFFER_LOAD_OPERATION> m_skin_pass_storage_buffer_load_operations;
+	mcrt_vector<BRX_COMPUTE_PASS_STORAGE_BUFFER_STORE_OPERATION> m_skin_pass_storage_buffer_store_operations;
+	mcrt_vector<Demo_Skin_Pass_Dispatch> m_skin_pass_dispatches;
+	mcrt_vector<brx_intermediate_bottom_level_acceleration_structure *> m_update_intermediate_bottom_level_acceleration_structures;
+	mcrt_vector<brx_acceleration_structure_build_input_read_only_buffer const *> m_update_intermediate_bottom_level_acceleration_structure_geometry_vertex_position_buffers;
+#ifndef NDEBUG
+	void const *m_draw_list_datas[DEMO_DRAW_LIST_COUNT];
+	size_t m_draw_list_capacities[DEMO_DRAW_LIST_COUNT];
+#endif
+
+	// the stress mode replicates the loaded scenes on a grid, and reports the cost of each pass against the instance count
+	uint32_t m_stress_replication_count;
+	bool m_stress_report_enabled;
+	uint32_t m_stress_report_frame_count;
+	double m_stress_report_interval_time;
+	uint64_t m_stress_report_pass_tick_counts[DEMO_STRESS_REPORT_PASS_COUNT];
+
+	// UINT32_MAX when there are NOT enough bindless slots (nothing is written)
+	uint32_t allocate_bindless_buffers(brx_device *device, uint32_t count, brx_read_only_storage_buffer const *const *read_only_storage_buffers);
+
+	// UINT32_MAX when there are NOT enough bindless slots (nothing is written)
+	uint32_t allocate_bindless_textures(brx_device *device, uint32_t count, brx_sampled_image const *const *sampled_images);
+
+	void prepare_texture_streaming(brx_device *device);
+
+	void update_texture_streaming(brx_device *device, uint32_t frame_throttling_index);
+
+	void destroy_texture_streaming(brx_device *device);
+
+#ifndef NDEBUG
+	void get_draw_list_storage(void const *out_datas[DEMO_DRAW_LIST_COUNT], size_t out_capacities[DEMO_DRAW_LIST_COUNT]) const;
+#endif
+
 public:
 	Demo();
 
@@ -122,7 +300,10 @@ public:
 
 	void on_swap_chain_dettach(brx_device *device);
 
-	void draw(brx_graphics_command_buffer *command_buffer, float interval_time, uint32_t frame_throttling_index);
+	// the camera (except for the projection which depends on the swap chain) and the animation are only updated by the simulation
+	void simulate(float interval_time, Demo_Frame_Packet *out_frame_packet);
+
+	void draw(brx_device *device, brx_graphics_command_buffer *command_buffer, Demo_Frame_Packet const *frame_packet, uint32_t frame_throttling_index);
 };
 
 #endif
@@ -0,0 +1,73 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "allocation_counter.h"
+#include <new>
+#include <stdlib.h>
+
+#ifndef NDEBUG
+static thread_local uint64_t g_thread_allocation_count = 0U;
+#endif
+
+extern uint64_t allocation_counter_get_thread_allocation_count()
+{
+#ifndef NDEBUG
+    return g_thread_allocation_count;
+#else
+    return 0U;
+#endif
+}
+
+#ifndef NDEBUG
+// the default array forms forward to these
+
+void *operator new(size_t size)
+{
+    ++g_thread_allocation_count;
+
+    // the "operator new" should NOT return NULL (and the exceptions may be disabled)
+    void *const pointer = malloc((size > 0U) ? size : 1U);
+    if (NULL == pointer)
+    {
+        abort();
+    }
+
+    return pointer;
+}
+
+void *operator new(size_t size, std::nothrow_t const &) noexcept
+{
+    ++g_thread_allocation_count;
+
+    return malloc((size > 0U) ? size : 1U);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void *pointer, std::nothrow_t const &) noexcept
+{
+    free(pointer);
+}
+#endif
@@ -0,0 +1,28 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _ALLOCATION_COUNTER_H_
+#define _ALLOCATION_COUNTER_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The number of the allocations by the global "operator new" on the calling thread, which is only counted in the debug build (and is always zero in the release build).
+// The memory allocated by the McRT-Malloc (e.g. the "mcrt_vector") does NOT go through the "operator new", and is NOT counted.
+extern uint64_t allocation_counter_get_thread_allocation_count();
+
+#endif
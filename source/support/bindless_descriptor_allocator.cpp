@@ -0,0 +1,64 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "bindless_descriptor_allocator.h"
+#include <assert.h>
+
+bindless_descriptor_allocator::bindless_descriptor_allocator() : m_capacity(0U), m_allocated_count(0U)
+{
+}
+
+void bindless_descriptor_allocator::init(uint32_t capacity)
+{
+    assert(0U == this->m_capacity);
+    assert(0U == this->m_allocated_count);
+
+    this->m_capacity = capacity;
+    this->m_allocated_count = 0U;
+}
+
+bool bindless_descriptor_allocator::allocate(uint32_t count, uint32_t *out_base)
+{
+    assert(count > 0U);
+    assert(NULL != out_base);
+
+    if (count > (this->m_capacity - this->m_allocated_count))
+    {
+        return false;
+    }
+
+    (*out_base) = this->m_allocated_count;
+    this->m_allocated_count += count;
+
+    return true;
+}
+
+uint32_t bindless_descriptor_allocator::get_capacity() const
+{
+    return this->m_capacity;
+}
+
+uint32_t bindless_descriptor_allocator::get_allocated_count() const
+{
+    return this->m_allocated_count;
+}
+
+void bindless_descriptor_allocator::destroy()
+{
+    this->m_capacity = 0U;
+    this->m_allocated_count = 0U;
+}
@@ -0,0 +1,48 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _BINDLESS_DESCRIPTOR_ALLOCATOR_H_
+#define _BINDLESS_DESCRIPTOR_ALLOCATOR_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Allocates contiguous ranges of slots in a bindless descriptor array by bumping a counter.
+// The slots are allocated for the lifetime of the descriptor set (nothing is unloaded at runtime), and they are NOT freed individually.
+// The capacity is fixed by the array size which the shaders declare, and the descriptor set is NOT grown.
+// The slots are only tracked here, and the caller is responsible for writing the descriptors.
+class bindless_descriptor_allocator
+{
+	uint32_t m_capacity;
+	uint32_t m_allocated_count;
+
+public:
+	bindless_descriptor_allocator();
+
+	void init(uint32_t capacity);
+
+	// "false" when the slots which are left are NOT enough
+	bool allocate(uint32_t count, uint32_t *out_base);
+
+	uint32_t get_capacity() const;
+
+	uint32_t get_allocated_count() const;
+
+	void destroy();
+};
+
+#endif
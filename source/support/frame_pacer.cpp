@@ -0,0 +1,81 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "frame_pacer.h"
+#include "tick_count.h"
+#include <chrono>
+#include <thread>
+#include <assert.h>
+
+// the error of the sleep is usually less than this time
+static constexpr uint32_t const frame_pacer_spin_microseconds = 1000U;
+
+frame_pacer::frame_pacer() : m_frame_period_tick_count(0U), m_spin_tick_count(0U), m_next_frame_tick_count(0U)
+{
+}
+
+void frame_pacer::init(uint32_t target_frame_rate)
+{
+    uint64_t const tick_count_per_second_value = tick_count_per_second();
+
+    this->m_frame_period_tick_count = (0U != target_frame_rate) ? (tick_count_per_second_value / static_cast<uint64_t>(target_frame_rate)) : 0U;
+    this->m_spin_tick_count = (tick_count_per_second_value * static_cast<uint64_t>(frame_pacer_spin_microseconds)) / 1000000U;
+    this->m_next_frame_tick_count = tick_count_now();
+}
+
+uint64_t frame_pacer::get_sleep_tick_count() const
+{
+    if (0U == this->m_frame_period_tick_count)
+    {
+        return 0U;
+    }
+
+    uint64_t const tick_count_current = tick_count_now();
+
+    return (this->m_next_frame_tick_count > (tick_count_current + this->m_spin_tick_count)) ? (this->m_next_frame_tick_count - (tick_count_current + this->m_spin_tick_count)) : 0U;
+}
+
+void frame_pacer::wait_for_next_frame()
+{
+    if (0U == this->m_frame_period_tick_count)
+    {
+        return;
+    }
+
+    double const seconds_per_tick_count = 1.0 / static_cast<double>(tick_count_per_second());
+
+    uint64_t tick_count_current = tick_count_now();
+    while (tick_count_current < this->m_next_frame_tick_count)
+    {
+        uint64_t const remaining_tick_count = this->m_next_frame_tick_count - tick_count_current;
+
+        if (remaining_tick_count > this->m_spin_tick_count)
+        {
+            std::this_thread::sleep_for(std::chrono::duration<double>(static_cast<double>(remaining_tick_count - this->m_spin_tick_count) * seconds_per_tick_count));
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+
+        tick_count_current = tick_count_now();
+    }
+
+    // the frames after a late frame (e.g. a hitch) do NOT catch up by starting in a burst
+    assert(tick_count_current >= this->m_next_frame_tick_count);
+    this->m_next_frame_tick_count = ((tick_count_current - this->m_next_frame_tick_count) < this->m_frame_period_tick_count) ? (this->m_next_frame_tick_count + this->m_frame_period_tick_count) : (tick_count_current + this->m_frame_period_tick_count);
+}
@@ -0,0 +1,43 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _FRAME_PACER_H_
+#define _FRAME_PACER_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The frames are started at the target frame rate (zero means unlimited), and the calling thread sleeps between the frames.
+// The sleep is NOT precise on most platforms, and the last part of the wait is spun (yielding the CPU) to start the frame on time.
+class frame_pacer
+{
+	uint64_t m_frame_period_tick_count;
+	uint64_t m_spin_tick_count;
+	uint64_t m_next_frame_tick_count;
+
+public:
+	frame_pacer();
+
+	void init(uint32_t target_frame_rate);
+
+	// the caller may wait for the other events (e.g. the input) within this time, and should call "wait_for_next_frame" after that
+	uint64_t get_sleep_tick_count() const;
+
+	void wait_for_next_frame();
+};
+
+#endif
@@ -21,6 +21,7 @@
 #include <stdint.h>
 
 // [Pipeline Throttling](https://community.arm.com/arm-community-blogs/b/graphics-gaming-and-vr-blog/posts/the-mali-gpu-an-abstract-machine-part-1---frame-pipelining)
+// the per frame resources are allocated for this number of frames, and the renderer may use fewer frames in flight at runtime (e.g. one for the low latency)
 static uint32_t constexpr const FRAME_THROTTLING_COUNT = 3U;
 
 #endif
\ No newline at end of file
@@ -0,0 +1,125 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "load_arena.h"
+#include <cstddef>
+#include <stdlib.h>
+#include <assert.h>
+
+static inline size_t tbb_align_up(size_t value, size_t alignment);
+
+load_arena::load_arena() : m_chunk_size(0U), m_allocation_count(0U), m_allocation_size(0U)
+{
+}
+
+void load_arena::init(size_t chunk_size)
+{
+    assert(0U == this->m_chunk_size);
+    assert(this->m_chunks.empty());
+    assert(chunk_size > 0U);
+
+    this->m_chunk_size = chunk_size;
+    this->m_allocation_count = 0U;
+    this->m_allocation_size = 0U;
+}
+
+void *load_arena::allocate(size_t size, size_t alignment)
+{
+    assert(this->m_chunk_size > 0U);
+    assert(alignment <= alignof(std::max_align_t));
+
+    // only the last chunk is used for the allocation, and the free space of the previous chunks is wasted
+    size_t offset = (!this->m_chunks.empty()) ? tbb_align_up(this->m_chunks.back().m_allocated_size, alignment) : 0U;
+
+    if (this->m_chunks.empty() || (offset > this->m_chunks.back().m_size) || (size > (this->m_chunks.back().m_size - offset)))
+    {
+        size_t const chunk_size = (size > this->m_chunk_size) ? size : this->m_chunk_size;
+
+        chunk new_chunk;
+        new_chunk.m_base = malloc(chunk_size);
+        assert(NULL != new_chunk.m_base);
+        new_chunk.m_size = chunk_size;
+        new_chunk.m_allocated_size = 0U;
+        this->m_chunks.push_back(new_chunk);
+
+        offset = 0U;
+    }
+
+    chunk &last_chunk = this->m_chunks.back();
+
+    last_chunk.m_allocated_size = offset + size;
+    assert(last_chunk.m_allocated_size <= last_chunk.m_size);
+
+    ++this->m_allocation_count;
+    this->m_allocation_size += size;
+
+    return reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(last_chunk.m_base) + offset);
+}
+
+uint64_t load_arena::get_allocation_count() const
+{
+    return this->m_allocation_count;
+}
+
+uint64_t load_arena::get_allocation_size() const
+{
+    return this->m_allocation_size;
+}
+
+size_t load_arena::get_chunk_count() const
+{
+    return this->m_chunks.size();
+}
+
+void load_arena::destroy()
+{
+    for (size_t chunk_index = 0U; chunk_index < this->m_chunks.size(); ++chunk_index)
+    {
+        free(this->m_chunks[chunk_index].m_base);
+    }
+
+    this->m_chunks.clear();
+    this->m_chunk_size = 0U;
+}
+
+static inline size_t tbb_align_up(size_t value, size_t alignment)
+{
+    //
+    //  Copyright (c) 2005-2019 Intel Corporation
+    //
+    //  Licensed under the Apache License, Version 2.0 (the "License");
+    //  you may not use this file except in compliance with the License.
+    //  You may obtain a copy of the License at
+    //
+    //      http://www.apache.org/licenses/LICENSE-2.0
+    //
+    //  Unless required by applicable law or agreed to in writing, software
+    //  distributed under the License is distributed on an "AS IS" BASIS,
+    //  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    //  See the License for the specific language governing permissions and
+    //  limitations under the License.
+    //
+
+    // [alignUp](https://github.com/oneapi-src/oneTBB/blob/tbb_2019/src/tbbmalloc/shared_utils.h#L42)
+
+    assert(alignment != static_cast<size_t>(0));
+
+    // power-of-2 alignment
+    assert((alignment & (alignment - static_cast<size_t>(1))) == static_cast<size_t>(0));
+
+    return (((value - static_cast<size_t>(1)) | (alignment - static_cast<size_t>(1))) + static_cast<size_t>(1));
+}
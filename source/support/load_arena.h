@@ -0,0 +1,109 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _LOAD_ARENA_H_
+#define _LOAD_ARENA_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_vector.h"
+
+// Bump allocates the temporary memory of the loading from a few large chunks.
+// The allocations larger than the chunk size get a dedicated chunk.
+// Nothing is freed individually, and all chunks are freed together by "destroy" (after the loading has completed).
+// NOT thread safe: only used by the thread which loads the scene.
+class load_arena
+{
+	struct chunk
+	{
+		void *m_base;
+		size_t m_size;
+		size_t m_allocated_size;
+	};
+
+	size_t m_chunk_size;
+	mcrt_vector<chunk> m_chunks;
+	uint64_t m_allocation_count;
+	uint64_t m_allocation_size;
+
+public:
+	load_arena();
+
+	void init(size_t chunk_size);
+
+	// the alignment should NOT be larger than the alignment of the malloc
+	void *allocate(size_t size, size_t alignment);
+
+	// the number and the total size of the allocations since "init" (to be compared with the number of the chunks)
+	uint64_t get_allocation_count() const;
+
+	uint64_t get_allocation_size() const;
+
+	size_t get_chunk_count() const;
+
+	void destroy();
+};
+
+// "deallocate" does nothing, and the memory is reclaimed when the arena is destroyed.
+template <typename T>
+class load_arena_allocator
+{
+	template <typename U>
+	friend class load_arena_allocator;
+
+	load_arena *m_arena;
+
+public:
+	typedef T value_type;
+
+	inline load_arena_allocator(load_arena *arena) : m_arena(arena)
+	{
+	}
+
+	template <typename U>
+	inline load_arena_allocator(load_arena_allocator<U> const &other) : m_arena(other.m_arena)
+	{
+	}
+
+	inline T *allocate(size_t count)
+	{
+		return static_cast<T *>(this->m_arena->allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	inline void deallocate(T *, size_t)
+	{
+	}
+
+	template <typename U>
+	inline bool operator==(load_arena_allocator<U> const &other) const
+	{
+		return (this->m_arena == other.m_arena);
+	}
+
+	template <typename U>
+	inline bool operator!=(load_arena_allocator<U> const &other) const
+	{
+		return (this->m_arena != other.m_arena);
+	}
+};
+
+// constructed with the pointer to the arena, e.g. "load_arena_vector<uint32_t> indices(count, &arena)"
+template <typename T>
+using load_arena_vector = std::vector<T, load_arena_allocator<T>>;
+
+#endif
@@ -340,8 +340,16 @@ static int main_thread_looper_input_queue_callback(int fd, int, void *input_queu
 #else
 
 #include <unistd.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <poll.h>
 #include <xcb/xcb.h>
 #include <stdio.h>
+#include "frame_pacer.h"
+#include "tick_count.h"
+
+// the target frame rate of the main loop (zero or NOT set means unlimited)
+static char const *const target_frame_rate_environment_variable_name = "DEMO_TARGET_FRAME_RATE";
 
 int main(int argc, char *argv[])
 {
@@ -504,6 +512,15 @@ int main(int argc, char *argv[])
         assert(NULL == error_map_window);
     }
 
+    frame_pacer main_loop_frame_pacer;
+    {
+        char const *const target_frame_rate_string = getenv(target_frame_rate_environment_variable_name);
+        main_loop_frame_pacer.init((NULL != target_frame_rate_string) ? static_cast<uint32_t>(strtoul(target_frame_rate_string, NULL, 10)) : 0U);
+    }
+
+    // the frames are simulated on this thread (together with the input), and drawn on the render thread
+    renderer_start_render_thread(g_renderer);
+
     bool quit = false;
     while (!quit)
     {
@@ -577,6 +594,8 @@ int main(int argc, char *argv[])
                     }
 
                     g_camera.HandleKeyDownMessage(mapped_key);
+
+                    renderer_on_input(g_renderer);
                 }
                 break;
                 case XCB_KEY_RELEASE:
@@ -640,6 +659,8 @@ int main(int argc, char *argv[])
                     }
 
                     g_camera.HandleKeyUpMessage(mapped_key);
+
+                    renderer_on_input(g_renderer);
                 }
                 break;
                 case XCB_MOTION_NOTIFY:
@@ -656,6 +677,8 @@ int main(int argc, char *argv[])
                     bool right_button = (0U != (motion_notify->state & XCB_EVENT_MASK_BUTTON_3_MOTION));
 
                     g_camera.HandleMouseMoveMessage(normalized_x, normalized_y, left_button, middle_button, right_button);
+
+                    renderer_on_input(g_renderer);
                 }
                 break;
                 case XCB_CONFIGURE_NOTIFY:
@@ -697,10 +720,27 @@ int main(int argc, char *argv[])
             }
         }
 
-        // Render
+        // Frame Pacing
+        {
+            // the input is processed while waiting for the next frame, so that the latest input is used by the frame
+            int const timeout_milliseconds = static_cast<int>((main_loop_frame_pacer.get_sleep_tick_count() * 1000U) / tick_count_per_second());
+            if ((!quit) && (timeout_milliseconds > 0))
+            {
+                struct pollfd connection_poll_fd = {xcb_get_file_descriptor(connection), POLLIN, 0};
+                int res_poll = poll(&connection_poll_fd, 1U, timeout_milliseconds);
+                assert((res_poll >= 0) || (EINTR == errno));
+                continue;
+            }
+
+            main_loop_frame_pacer.wait_for_next_frame();
+        }
+
+        // Simulate
         renderer_draw(g_renderer);
     }
 
+    renderer_stop_render_thread(g_renderer);
+
     {
         xcb_void_cookie_t cookie_free_colormap = xcb_free_colormap_checked(connection, colormap);
 
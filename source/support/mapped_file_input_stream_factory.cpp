@@ -0,0 +1,371 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "mapped_file_input_stream_factory.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <new>
+#include <assert.h>
+
+#if defined(__GNUC__)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(_MSC_VER)
+#define NOMINMAX 1
+#define WIN32_LEAN_AND_MEAN 1
+#include <sdkddkver.h>
+#include <Windows.h>
+#else
+#error Unknown Compiler
+#endif
+
+// reads the mapped view (the view is owned by the factory)
+class mapped_file_input_stream : public import_asset_input_stream
+{
+	uint8_t const *m_memory_range_base;
+	size_t m_memory_range_size;
+	size_t m_offset;
+
+public:
+	mapped_file_input_stream(void const *memory_range_base, size_t memory_range_size);
+
+	int stat_size(int64_t *size);
+
+	intptr_t read(void *data, size_t size);
+
+	int64_t seek(int64_t offset, int whence);
+};
+
+static inline mcrt_string join_content_root_path(mcrt_string const &content_root, char const *relative_path);
+
+static inline bool is_directory(char const *path);
+
+mapped_file_input_stream_factory::mapped_file_input_stream_factory()
+{
+}
+
+bool mapped_file_input_stream_factory::init(char const *content_root)
+{
+    assert(this->m_content_root.empty());
+    assert(this->m_mapped_files.empty());
+
+    if (!is_directory(content_root))
+    {
+        return false;
+    }
+
+    this->m_content_root = content_root;
+
+    return true;
+}
+
+import_asset_input_stream_factory *mapped_file_input_stream_factory::get_input_stream_factory()
+{
+    assert(!this->m_content_root.empty());
+    return this;
+}
+
+import_asset_input_stream *mapped_file_input_stream_factory::create_instance(char const *file_name)
+{
+    void const *memory_range_base;
+    size_t memory_range_size;
+    if (!this->get_file(file_name, &memory_range_base, &memory_range_size))
+    {
+        return NULL;
+    }
+
+    return new (malloc(sizeof(mapped_file_input_stream))) mapped_file_input_stream(memory_range_base, memory_range_size);
+}
+
+void mapped_file_input_stream_factory::destory_instance(import_asset_input_stream *input_stream)
+{
+    mapped_file_input_stream *const mapped_file_input_stream_instance = static_cast<mapped_file_input_stream *>(input_stream);
+    mapped_file_input_stream_instance->~mapped_file_input_stream();
+    free(mapped_file_input_stream_instance);
+}
+
+bool mapped_file_input_stream_factory::get_file(char const *file_name, void const **out_memory_range_base, size_t *out_memory_range_size)
+{
+    assert(!this->m_content_root.empty());
+
+    mcrt_string const file_name_string(file_name);
+
+    std::lock_guard<std::mutex> lock_guard(this->m_mapped_files_mutex);
+
+    mcrt_unordered_map<mcrt_string, mapped_file>::const_iterator found = this->m_mapped_files.find(file_name_string);
+    if (this->m_mapped_files.end() == found)
+    {
+        mapped_file new_mapped_file;
+        if (!map_file_read_only(join_content_root_path(this->m_content_root, file_name).c_str(), &new_mapped_file))
+        {
+            return false;
+        }
+
+        found = this->m_mapped_files.emplace(file_name_string, new_mapped_file).first;
+    }
+
+    (*out_memory_range_base) = found->second.m_memory_range_base;
+    (*out_memory_range_size) = found->second.m_memory_range_size;
+    return true;
+}
+
+void mapped_file_input_stream_factory::destroy()
+{
+    for (mcrt_unordered_map<mcrt_string, mapped_file>::const_iterator iterator = this->m_mapped_files.begin(); this->m_mapped_files.end() != iterator; ++iterator)
+    {
+        unmap_file(&iterator->second);
+    }
+
+    this->m_mapped_files.clear();
+    this->m_content_root.clear();
+}
+
+mapped_file_input_stream::mapped_file_input_stream(void const *memory_range_base, size_t memory_range_size) : m_memory_range_base(static_cast<uint8_t const *>(memory_range_base)), m_memory_range_size(memory_range_size), m_offset(0U)
+{
+}
+
+int mapped_file_input_stream::stat_size(int64_t *size)
+{
+    (*size) = static_cast<int64_t>(this->m_memory_range_size);
+    return 0;
+}
+
+intptr_t mapped_file_input_stream::read(void *data, size_t size)
+{
+    assert(this->m_offset <= this->m_memory_range_size);
+
+    size_t const read_size = (size < (this->m_memory_range_size - this->m_offset)) ? size : (this->m_memory_range_size - this->m_offset);
+
+    memcpy(data, this->m_memory_range_base + this->m_offset, read_size);
+    this->m_offset += read_size;
+
+    return static_cast<intptr_t>(read_size);
+}
+
+int64_t mapped_file_input_stream::seek(int64_t offset, int whence)
+{
+    int64_t base;
+    switch (whence)
+    {
+    case SEEK_SET:
+    {
+        base = 0;
+    }
+    break;
+    case SEEK_CUR:
+    {
+        base = static_cast<int64_t>(this->m_offset);
+    }
+    break;
+    case SEEK_END:
+    {
+        base = static_cast<int64_t>(this->m_memory_range_size);
+    }
+    break;
+    default:
+    {
+        return -1;
+    }
+    }
+
+    int64_t const new_offset = base + offset;
+    if ((new_offset < 0) || (new_offset > static_cast<int64_t>(this->m_memory_range_size)))
+    {
+        return -1;
+    }
+
+    this->m_offset = static_cast<size_t>(new_offset);
+    return new_offset;
+}
+
+static inline mcrt_string join_content_root_path(mcrt_string const &content_root, char const *relative_path)
+{
+    return ('\0' != relative_path[0]) ? (content_root + '/' + relative_path) : content_root;
+}
+
+#if defined(__GNUC__)
+
+void mapped_file_input_stream_factory::enumerate_directory_files(char const *directory_name, mcrt_vector<directory_file> &out_files) const
+{
+    assert(!this->m_content_root.empty());
+
+    DIR *const dir = opendir(join_content_root_path(this->m_content_root, directory_name).c_str());
+    if (NULL == dir)
+    {
+        return;
+    }
+
+    mcrt_string const relative_directory(directory_name);
+
+    for (struct dirent *entry = readdir(dir); NULL != entry; entry = readdir(dir))
+    {
+        mcrt_string const relative_path = relative_directory.empty() ? mcrt_string(entry->d_name) : (relative_directory + '/' + entry->d_name);
+
+        struct stat path_stat;
+        if ((0 == stat(join_content_root_path(this->m_content_root, relative_path.c_str()).c_str(), &path_stat)) && S_ISREG(path_stat.st_mode))
+        {
+            directory_file file;
+            file.m_file_name = relative_path;
+            file.m_file_size = static_cast<uint64_t>(path_stat.st_size);
+            file.m_modification_time = static_cast<uint64_t>(path_stat.st_mtim.tv_sec) * 1000000000ULL + static_cast<uint64_t>(path_stat.st_mtim.tv_nsec);
+            out_files.push_back(file);
+        }
+    }
+
+    int const result_close_dir = closedir(dir);
+    assert(0 == result_close_dir);
+}
+
+static inline bool is_directory(char const *path)
+{
+    struct stat path_stat;
+    return (0 == stat(path, &path_stat)) && S_ISDIR(path_stat.st_mode);
+}
+
+extern bool map_file_read_only(char const *path, mapped_file *out_mapped_file)
+{
+    int const file_descriptor = open(path, O_RDONLY);
+    if (-1 == file_descriptor)
+    {
+        return false;
+    }
+
+    void *memory_range_base = MAP_FAILED;
+    size_t memory_range_size = 0U;
+    {
+        struct stat file_stat;
+        if ((0 == fstat(file_descriptor, &file_stat)) && (file_stat.st_size > 0))
+        {
+            memory_range_size = static_cast<size_t>(file_stat.st_size);
+            memory_range_base = mmap(NULL, memory_range_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        }
+    }
+
+    // the mapping stays valid after the file descriptor has been closed
+    int const result_close = close(file_descriptor);
+    assert(0 == result_close);
+
+    if (MAP_FAILED == memory_range_base)
+    {
+        return false;
+    }
+
+    out_mapped_file->m_memory_range_base = memory_range_base;
+    out_mapped_file->m_memory_range_size = memory_range_size;
+    return true;
+}
+
+extern void unmap_file(mapped_file const *mapped_file)
+{
+    int const result_munmap = munmap(mapped_file->m_memory_range_base, mapped_file->m_memory_range_size);
+    assert(0 == result_munmap);
+}
+
+#elif defined(_MSC_VER)
+
+void mapped_file_input_stream_factory::enumerate_directory_files(char const *directory_name, mcrt_vector<directory_file> &out_files) const
+{
+    assert(!this->m_content_root.empty());
+
+    mcrt_string const pattern = join_content_root_path(this->m_content_root, directory_name) + "/*";
+
+    WIN32_FIND_DATAA find_data;
+    HANDLE const find_file = FindFirstFileA(pattern.c_str(), &find_data);
+    if (INVALID_HANDLE_VALUE == find_file)
+    {
+        return;
+    }
+
+    mcrt_string const relative_directory(directory_name);
+
+    do
+    {
+        if (0U == (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+        {
+            directory_file file;
+            file.m_file_name = relative_directory.empty() ? mcrt_string(find_data.cFileName) : (relative_directory + '/' + find_data.cFileName);
+            file.m_file_size = (static_cast<uint64_t>(find_data.nFileSizeHigh) << 32U) | static_cast<uint64_t>(find_data.nFileSizeLow);
+            file.m_modification_time = (static_cast<uint64_t>(find_data.ftLastWriteTime.dwHighDateTime) << 32U) | static_cast<uint64_t>(find_data.ftLastWriteTime.dwLowDateTime);
+            out_files.push_back(file);
+        }
+    } while (FALSE != FindNextFileA(find_file, &find_data));
+
+    BOOL const result_find_close = FindClose(find_file);
+    assert(FALSE != result_find_close);
+}
+
+static inline bool is_directory(char const *path)
+{
+    DWORD const file_attributes = GetFileAttributesA(path);
+    return (INVALID_FILE_ATTRIBUTES != file_attributes) && (0U != (file_attributes & FILE_ATTRIBUTE_DIRECTORY));
+}
+
+extern bool map_file_read_only(char const *path, mapped_file *out_mapped_file)
+{
+    HANDLE const file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE == file)
+    {
+        return false;
+    }
+
+    void *memory_range_base = NULL;
+    size_t memory_range_size = 0U;
+    {
+        LARGE_INTEGER file_size;
+        if ((FALSE != GetFileSizeEx(file, &file_size)) && (file_size.QuadPart > 0))
+        {
+            HANDLE const file_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0U, 0U, NULL);
+            if (NULL != file_mapping)
+            {
+                memory_range_size = static_cast<size_t>(file_size.QuadPart);
+                memory_range_base = MapViewOfFile(file_mapping, FILE_MAP_READ, 0U, 0U, 0U);
+
+                // the view stays valid after the file mapping has been closed
+                BOOL const result_close_handle_file_mapping = CloseHandle(file_mapping);
+                assert(FALSE != result_close_handle_file_mapping);
+            }
+        }
+    }
+
+    // the view stays valid after the file has been closed
+    BOOL const result_close_handle_file = CloseHandle(file);
+    assert(FALSE != result_close_handle_file);
+
+    if (NULL == memory_range_base)
+    {
+        return false;
+    }
+
+    out_mapped_file->m_memory_range_base = memory_range_base;
+    out_mapped_file->m_memory_range_size = memory_range_size;
+    return true;
+}
+
+extern void unmap_file(mapped_file const *mapped_file)
+{
+    BOOL const result_unmap_view_of_file = UnmapViewOfFile(mapped_file->m_memory_range_base);
+    assert(FALSE != result_unmap_view_of_file);
+}
+
+#else
+#error Unknown Compiler
+#endif
@@ -0,0 +1,83 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _MAPPED_FILE_INPUT_STREAM_FACTORY_H_
+#define _MAPPED_FILE_INPUT_STREAM_FACTORY_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+#include "../../thirdparty/Import-Asset/include/import_asset_input_stream.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_vector.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_string.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_unordered_map.h"
+
+// the file (and the file mapping) is closed after the view has been mapped, since the view stays valid without them
+struct mapped_file
+{
+	void *m_memory_range_base;
+	size_t m_memory_range_size;
+};
+
+// "false" when the file does not exist or is empty
+extern bool map_file_read_only(char const *path, mapped_file *out_mapped_file);
+
+extern void unmap_file(mapped_file const *mapped_file);
+
+// the modification time is only compared for equality (the unit is platform-specific)
+struct directory_file
+{
+	mcrt_string m_file_name;
+	uint64_t m_file_size;
+	uint64_t m_modification_time;
+};
+
+// Serves the files under the content root by the path relative to the content root (e.g. "the-white-room/the-white-room.gltf").
+// The file is mapped read-only when it is first requested, and the pages are read on demand when the importer reads the input streams (nothing is copied).
+// The mappings are kept until "destroy" is called, and the input streams should NOT be used after that.
+// The input streams may be created (and the files may be requested) on several threads at the same time.
+class mapped_file_input_stream_factory : public import_asset_input_stream_factory
+{
+	mcrt_string m_content_root;
+
+	std::mutex m_mapped_files_mutex;
+	mcrt_unordered_map<mcrt_string, mapped_file> m_mapped_files;
+
+public:
+	mapped_file_input_stream_factory();
+
+	// "false" when the content root is NOT a directory, and the caller should fall back to the embedded assets
+	bool init(char const *content_root);
+
+	import_asset_input_stream_factory *get_input_stream_factory();
+
+	import_asset_input_stream *create_instance(char const *file_name);
+
+	void destory_instance(import_asset_input_stream *input_stream);
+
+	// relative to the content root
+	// "false" when the file does not exist or is empty
+	bool get_file(char const *file_name, void const **out_memory_range_base, size_t *out_memory_range_size);
+
+	// the regular files directly in the directory (NOT recursive), relative to the content root, and the order is NOT deterministic
+	// the files are NOT mapped (only the file system metadata is read)
+	void enumerate_directory_files(char const *directory_name, mcrt_vector<directory_file> &out_files) const;
+
+	void destroy();
+};
+
+#endif
@@ -0,0 +1,179 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "mesh_locality_optimizer.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_vector.h"
+#include <algorithm>
+#include <assert.h>
+
+static inline uint32_t morton_expand_bits_10(uint32_t x);
+
+static constexpr uint32_t const cache_line_size = 64U;
+
+// roughly the L0/L1 cache lines available to one wave
+static constexpr uint32_t const cache_line_count = 32U;
+
+void optimize_mesh_locality(uint32_t vertex_count, float const *vertex_positions, uint32_t vertex_position_stride, uint32_t index_count, uint32_t const *indices, uint32_t *out_indices, uint32_t *out_vertex_remap)
+{
+    assert(0U == (index_count % 3U));
+
+    uint32_t const triangle_count = index_count / 3U;
+
+    auto const get_vertex_position = [vertex_positions, vertex_position_stride](uint32_t vertex_index) -> float const *
+    {
+        return reinterpret_cast<float const *>(reinterpret_cast<uint8_t const *>(vertex_positions) + static_cast<size_t>(vertex_position_stride) * vertex_index);
+    };
+
+    // AABB
+    float aabb_min[3] = {0.0F, 0.0F, 0.0F};
+    float aabb_max[3] = {0.0F, 0.0F, 0.0F};
+    if (vertex_count > 0U)
+    {
+        float const *const vertex_position = get_vertex_position(0U);
+        for (uint32_t component_index = 0U; component_index < 3U; ++component_index)
+        {
+            aabb_min[component_index] = vertex_position[component_index];
+            aabb_max[component_index] = vertex_position[component_index];
+        }
+    }
+
+    for (uint32_t vertex_index = 1U; vertex_index < vertex_count; ++vertex_index)
+    {
+        float const *const vertex_position = get_vertex_position(vertex_index);
+        for (uint32_t component_index = 0U; component_index < 3U; ++component_index)
+        {
+            aabb_min[component_index] = std::min(aabb_min[component_index], vertex_position[component_index]);
+            aabb_max[component_index] = std::max(aabb_max[component_index], vertex_position[component_index]);
+        }
+    }
+
+    // Triangle Order
+    mcrt_vector<uint32_t> triangle_morton_codes(triangle_count);
+    mcrt_vector<uint32_t> triangle_order(triangle_count);
+    for (uint32_t triangle_index = 0U; triangle_index < triangle_count; ++triangle_index)
+    {
+        uint32_t morton_code = 0U;
+        for (uint32_t component_index = 0U; component_index < 3U; ++component_index)
+        {
+            assert(indices[3U * triangle_index] < vertex_count);
+            assert(indices[3U * triangle_index + 1U] < vertex_count);
+            assert(indices[3U * triangle_index + 2U] < vertex_count);
+
+            float const centroid = (get_vertex_position(indices[3U * triangle_index])[component_index] + get_vertex_position(indices[3U * triangle_index + 1U])[component_index] + get_vertex_position(indices[3U * triangle_index + 2U])[component_index]) * (1.0F / 3.0F);
+
+            float const extent = aabb_max[component_index] - aabb_min[component_index];
+
+            float const normalized_centroid = (extent > 0.0F) ? std::min(std::max((centroid - aabb_min[component_index]) / extent, 0.0F), 1.0F) : 0.0F;
+
+            morton_code |= (morton_expand_bits_10(static_cast<uint32_t>(normalized_centroid * 1023.0F)) << component_index);
+        }
+
+        triangle_morton_codes[triangle_index] = morton_code;
+        triangle_order[triangle_index] = triangle_index;
+    }
+
+    // stable to keep the original order of the triangles with the same code
+    std::stable_sort(triangle_order.begin(), triangle_order.end(), [&triangle_morton_codes](uint32_t triangle_index_a, uint32_t triangle_index_b) -> bool
+                     { return triangle_morton_codes[triangle_index_a] < triangle_morton_codes[triangle_index_b]; });
+
+    // Vertex Order
+    static constexpr uint32_t const INVALID_VERTEX_INDEX = static_cast<uint32_t>(~0U);
+
+    mcrt_vector<uint32_t> old_to_new_vertex_indices(vertex_count, INVALID_VERTEX_INDEX);
+    uint32_t new_vertex_count = 0U;
+    for (uint32_t new_triangle_index = 0U; new_triangle_index < triangle_count; ++new_triangle_index)
+    {
+        uint32_t const old_triangle_index = triangle_order[new_triangle_index];
+
+        for (uint32_t triangle_vertex_index = 0U; triangle_vertex_index < 3U; ++triangle_vertex_index)
+        {
+            uint32_t const old_vertex_index = indices[3U * old_triangle_index + triangle_vertex_index];
+
+            if (INVALID_VERTEX_INDEX == old_to_new_vertex_indices[old_vertex_index])
+            {
+                old_to_new_vertex_indices[old_vertex_index] = new_vertex_count;
+                out_vertex_remap[new_vertex_count] = old_vertex_index;
+                ++new_vertex_count;
+            }
+
+            out_indices[3U * new_triangle_index + triangle_vertex_index] = old_to_new_vertex_indices[old_vertex_index];
+        }
+    }
+
+    for (uint32_t old_vertex_index = 0U; old_vertex_index < vertex_count; ++old_vertex_index)
+    {
+        if (INVALID_VERTEX_INDEX == old_to_new_vertex_indices[old_vertex_index])
+        {
+            old_to_new_vertex_indices[old_vertex_index] = new_vertex_count;
+            out_vertex_remap[new_vertex_count] = old_vertex_index;
+            ++new_vertex_count;
+        }
+    }
+
+    assert(vertex_count == new_vertex_count);
+}
+
+float compute_mesh_average_cache_lines_per_triangle(uint32_t index_count, uint32_t const *indices, uint32_t vertex_stride)
+{
+    assert(0U == (index_count % 3U));
+
+    uint32_t const triangle_count = index_count / 3U;
+
+    // the most recently used is at the end
+    mcrt_vector<uint64_t> cache_lines;
+    cache_lines.reserve(cache_line_count);
+
+    uint64_t cache_line_miss_count = 0U;
+    for (uint32_t index_index = 0U; index_index < index_count; ++index_index)
+    {
+        uint64_t const vertex_begin = static_cast<uint64_t>(vertex_stride) * indices[index_index];
+        uint64_t const vertex_end = vertex_begin + vertex_stride;
+
+        for (uint64_t cache_line = (vertex_begin / cache_line_size); cache_line < ((vertex_end + (cache_line_size - 1U)) / cache_line_size); ++cache_line)
+        {
+            auto const found_cache_line = std::find(cache_lines.begin(), cache_lines.end(), cache_line);
+            if (cache_lines.end() != found_cache_line)
+            {
+                cache_lines.erase(found_cache_line);
+            }
+            else
+            {
+                ++cache_line_miss_count;
+
+                if (cache_lines.size() >= cache_line_count)
+                {
+                    cache_lines.erase(cache_lines.begin());
+                }
+            }
+
+            cache_lines.push_back(cache_line);
+        }
+    }
+
+    return (triangle_count > 0U) ? (static_cast<float>(cache_line_miss_count) / static_cast<float>(triangle_count)) : 0.0F;
+}
+
+static inline uint32_t morton_expand_bits_10(uint32_t x)
+{
+    assert(x <= 1023U);
+
+    x = (x | (x << 16U)) & 0X030000FFU;
+    x = (x | (x << 8U)) & 0X0300F00FU;
+    x = (x | (x << 4U)) & 0X030C30C3U;
+    x = (x | (x << 2U)) & 0X09249249U;
+    return x;
+}
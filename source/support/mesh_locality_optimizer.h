@@ -0,0 +1,32 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _MESH_LOCALITY_OPTIMIZER_H_
+#define _MESH_LOCALITY_OPTIMIZER_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Reorders the triangles by the Morton code of the centroids, and then reorders the vertices by the first use.
+// The adjacent triangles (which are likely to be hit by the adjacent rays) reference the adjacent vertices, and fewer cache lines are touched when the vertices are fetched.
+// "out_vertex_remap[new vertex index] = old vertex index", and the vertices which are not referenced by any triangle are placed at the end.
+void optimize_mesh_locality(uint32_t vertex_count, float const *vertex_positions, uint32_t vertex_position_stride, uint32_t index_count, uint32_t const *indices, uint32_t *out_indices, uint32_t *out_vertex_remap);
+
+// Simulates a small LRU cache while the vertices of each triangle are fetched in order, and returns the average number of cache lines missed per triangle.
+float compute_mesh_average_cache_lines_per_triangle(uint32_t index_count, uint32_t const *indices, uint32_t vertex_stride);
+
+#endif
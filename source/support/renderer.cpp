@@ -17,7 +17,13 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <stdio.h>
 #include <assert.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "renderer.h"
@@ -26,12 +32,32 @@
 #include "../../thirdparty/Brioche/include/brx_device.h"
 #include "../demo.h"
 
+// the simulation runs at most this number of frames ahead of the render thread
+static constexpr uint32_t const FRAME_PACKET_QUEUE_CAPACITY = 1U;
+
+// the number of the frames in flight (from one to FRAME_THROTTLING_COUNT), which is FRAME_THROTTLING_COUNT by default
+static char const *const frame_throttling_count_environment_variable_name = "DEMO_FRAME_THROTTLING_COUNT";
+
+// the latency from the input to the present is only measured and reported when this is set to non-zero
+static char const *const input_latency_report_environment_variable_name = "DEMO_INPUT_LATENCY_REPORT";
+
+// the latency from the input to the present is averaged over this number of frames
+static constexpr uint32_t const input_latency_report_frame_count = 256U;
+
+struct renderer_frame_packet
+{
+	Demo_Frame_Packet m_demo_frame_packet;
+	// zero when there is no input
+	uint64_t m_input_tick_count;
+};
+
 class renderer
 {
 	brx_device *m_device;
 
 	brx_graphics_queue *m_graphics_queue;
 
+	uint32_t m_frame_throttling_count;
 	uint32_t m_frame_throttling_index;
 
 	brx_graphics_command_buffer *m_command_buffers[FRAME_THROTTLING_COUNT];
@@ -58,6 +84,37 @@ class renderer
 	double m_tick_count_resolution;
 	uint64_t m_tick_count_previous_frame;
 
+	// only used by the simulation
+	uint64_t m_pending_input_tick_count;
+
+	// only used by the draw
+	bool m_input_latency_report;
+	uint32_t m_input_latency_report_frame_count;
+	uint32_t m_input_latency_sample_count;
+	uint64_t m_input_latency_total_tick_count;
+	uint64_t m_input_latency_max_tick_count;
+
+	// [consumed count, produced count) has been simulated but NOT drawn
+	bool m_render_thread_running;
+	std::thread m_render_thread;
+	std::mutex m_frame_packet_mutex;
+	std::condition_variable m_frame_packet_produced_condition_variable;
+	std::condition_variable m_frame_packet_consumed_condition_variable;
+	renderer_frame_packet m_frame_packets[FRAME_PACKET_QUEUE_CAPACITY];
+	uint32_t m_frame_packet_produced_count;
+	uint32_t m_frame_packet_consumed_count;
+	bool m_render_thread_stop;
+	// the swap chain is only recreated on the render thread
+	std::atomic_bool m_window_resize_requested;
+
+	void resize_swap_chain();
+
+	void simulate(renderer_frame_packet *out_frame_packet);
+
+	void draw_frame(renderer_frame_packet const *frame_packet);
+
+	static void render_thread_main(renderer *renderer);
+
 	void attach_swap_chain();
 
 	void dettach_swap_chain();
@@ -82,9 +139,15 @@ public:
 	void dettach_window();
 
 	void draw();
+
+	void start_render_thread();
+
+	void stop_render_thread();
+
+	void on_input();
 };
 
-renderer::renderer() : m_surface(NULL), m_swap_chain(NULL)
+renderer::renderer() : m_surface(NULL), m_swap_chain(NULL), m_render_thread_running(false), m_frame_packet_produced_count(0U), m_frame_packet_consumed_count(0U), m_render_thread_stop(false), m_window_resize_requested(false)
 {
 }
 
@@ -100,6 +163,8 @@ renderer::~renderer()
 	assert(NULL == this->m_swap_chain);
 
 	assert(NULL == this->m_device);
+
+	assert(!this->m_render_thread_running);
 }
 
 extern renderer *renderer_init(void *wsi_connection)
@@ -136,12 +201,32 @@ extern void renderer_draw(renderer *renderer)
 	renderer->draw();
 }
 
+extern void renderer_start_render_thread(renderer *renderer)
+{
+	renderer->start_render_thread();
+}
+
+extern void renderer_stop_render_thread(renderer *renderer)
+{
+	renderer->stop_render_thread();
+}
+
+extern void renderer_on_input(renderer *renderer)
+{
+	renderer->on_input();
+}
+
 void renderer::init(void *wsi_connection)
 {
 	this->m_device = brx_init_unknown_device(wsi_connection, true);
 
 	this->m_graphics_queue = this->m_device->create_graphics_queue();
 
+	{
+		char const *const frame_throttling_count_string = getenv(frame_throttling_count_environment_variable_name);
+		this->m_frame_throttling_count = (NULL != frame_throttling_count_string) ? std::min(std::max(1U, static_cast<uint32_t>(strtoul(frame_throttling_count_string, NULL, 10))), FRAME_THROTTLING_COUNT) : FRAME_THROTTLING_COUNT;
+	}
+
 	this->m_frame_throttling_index = 0U;
 
 	for (uint32_t frame_throtting_index = 0U; frame_throtting_index < FRAME_THROTTLING_COUNT; ++frame_throtting_index)
@@ -185,6 +270,17 @@ void renderer::init(void *wsi_connection)
 	// Tick Count
 	this->m_tick_count_resolution = (1.0 / static_cast<double>(tick_count_per_second()));
 	this->m_tick_count_previous_frame = tick_count_now();
+
+	// Input Latency
+	this->m_pending_input_tick_count = 0U;
+	{
+		char const *const input_latency_report_string = getenv(input_latency_report_environment_variable_name);
+		this->m_input_latency_report = (NULL != input_latency_report_string) && (0U != strtoul(input_latency_report_string, NULL, 10));
+	}
+	this->m_input_latency_report_frame_count = 0U;
+	this->m_input_latency_sample_count = 0U;
+	this->m_input_latency_total_tick_count = 0U;
+	this->m_input_latency_max_tick_count = 0U;
 }
 
 void renderer::destroy()
@@ -225,6 +321,17 @@ void renderer::attach_window(void *wsi_window)
 }
 
 void renderer::on_window_resize()
+{
+	if (this->m_render_thread_running)
+	{
+		this->m_window_resize_requested.store(true, std::memory_order_relaxed);
+		return;
+	}
+
+	this->resize_swap_chain();
+}
+
+void renderer::resize_swap_chain()
 {
 	for (uint32_t frame_throtting_index = 0U; frame_throtting_index < FRAME_THROTTLING_COUNT; ++frame_throtting_index)
 	{
@@ -348,6 +455,127 @@ void renderer::destroy_swap_chain_render_pass_and_pipeline()
 }
 
 void renderer::draw()
+{
+	if (!this->m_render_thread_running)
+	{
+		renderer_frame_packet frame_packet;
+		this->simulate(&frame_packet);
+		this->draw_frame(&frame_packet);
+		return;
+	}
+
+	// wait for the render thread to consume the oldest frame packet when the queue is full
+	uint32_t frame_packet_index;
+	{
+		std::unique_lock<std::mutex> lock(this->m_frame_packet_mutex);
+		while ((this->m_frame_packet_produced_count - this->m_frame_packet_consumed_count) >= FRAME_PACKET_QUEUE_CAPACITY)
+		{
+			this->m_frame_packet_consumed_condition_variable.wait(lock);
+		}
+
+		frame_packet_index = this->m_frame_packet_produced_count % FRAME_PACKET_QUEUE_CAPACITY;
+	}
+
+	// the slot is NOT read by the render thread until it is published
+	this->simulate(&this->m_frame_packets[frame_packet_index]);
+
+	{
+		std::unique_lock<std::mutex> lock(this->m_frame_packet_mutex);
+		++this->m_frame_packet_produced_count;
+	}
+	this->m_frame_packet_produced_condition_variable.notify_one();
+}
+
+void renderer::start_render_thread()
+{
+	assert(!this->m_render_thread_running);
+
+	this->m_frame_packet_produced_count = 0U;
+	this->m_frame_packet_consumed_count = 0U;
+	this->m_render_thread_stop = false;
+	this->m_window_resize_requested.store(false, std::memory_order_relaxed);
+
+	this->m_render_thread = std::thread(render_thread_main, this);
+	this->m_render_thread_running = true;
+}
+
+void renderer::stop_render_thread()
+{
+	assert(this->m_render_thread_running);
+
+	{
+		std::unique_lock<std::mutex> lock(this->m_frame_packet_mutex);
+		this->m_render_thread_stop = true;
+	}
+	this->m_frame_packet_produced_condition_variable.notify_one();
+
+	this->m_render_thread.join();
+	this->m_render_thread_running = false;
+
+	// the frame packets which have NOT been drawn are dropped
+	this->m_frame_packet_produced_count = 0U;
+	this->m_frame_packet_consumed_count = 0U;
+
+	// the resize which has NOT been handled by the render thread
+	if (this->m_window_resize_requested.exchange(false, std::memory_order_relaxed))
+	{
+		this->resize_swap_chain();
+	}
+}
+
+void renderer::render_thread_main(renderer *renderer)
+{
+	while (true)
+	{
+		// the frame packet is copied out to free the slot for the simulation of the next frame as early as possible
+		renderer_frame_packet frame_packet;
+		{
+			std::unique_lock<std::mutex> lock(renderer->m_frame_packet_mutex);
+			while ((!renderer->m_render_thread_stop) && (renderer->m_frame_packet_produced_count == renderer->m_frame_packet_consumed_count))
+			{
+				renderer->m_frame_packet_produced_condition_variable.wait(lock);
+			}
+
+			if (renderer->m_render_thread_stop)
+			{
+				break;
+			}
+
+			frame_packet = renderer->m_frame_packets[renderer->m_frame_packet_consumed_count % FRAME_PACKET_QUEUE_CAPACITY];
+			++renderer->m_frame_packet_consumed_count;
+		}
+		renderer->m_frame_packet_consumed_condition_variable.notify_one();
+
+		if (renderer->m_window_resize_requested.exchange(false, std::memory_order_relaxed))
+		{
+			renderer->resize_swap_chain();
+		}
+
+		renderer->draw_frame(&frame_packet);
+	}
+}
+
+void renderer::on_input()
+{
+	if (0U == this->m_pending_input_tick_count)
+	{
+		this->m_pending_input_tick_count = tick_count_now();
+	}
+}
+
+void renderer::simulate(renderer_frame_packet *out_frame_packet)
+{
+	uint64_t const tick_count_current_frame = tick_count_now();
+	float const interval_time = static_cast<float>(static_cast<double>(tick_count_current_frame - this->m_tick_count_previous_frame) * this->m_tick_count_resolution);
+	this->m_tick_count_previous_frame = tick_count_current_frame;
+
+	this->m_demo.simulate(interval_time, &out_frame_packet->m_demo_frame_packet);
+
+	out_frame_packet->m_input_tick_count = this->m_pending_input_tick_count;
+	this->m_pending_input_tick_count = 0U;
+}
+
+void renderer::draw_frame(renderer_frame_packet const *frame_packet)
 {
 	if (NULL == this->m_surface)
 	{
@@ -363,13 +591,7 @@ void renderer::draw()
 
 	this->m_command_buffers[this->m_frame_throttling_index]->begin();
 
-	{
-		uint64_t const tick_count_current_frame = tick_count_now();
-		float const interval_time = static_cast<float>(static_cast<double>(tick_count_current_frame - this->m_tick_count_previous_frame) * this->m_tick_count_resolution);
-		this->m_tick_count_previous_frame = tick_count_current_frame;
-
-		this->m_demo.draw(this->m_command_buffers[this->m_frame_throttling_index], interval_time, this->m_frame_throttling_index);
-	}
+	this->m_demo.draw(this->m_device, this->m_command_buffers[this->m_frame_throttling_index], &frame_packet->m_demo_frame_packet, this->m_frame_throttling_index);
 
 	uint32_t swap_chain_image_index = -1;
 	bool acquire_next_image_not_out_of_date = this->m_device->acquire_next_image(this->m_command_buffers[this->m_frame_throttling_index], this->m_swap_chain, &swap_chain_image_index);
@@ -430,6 +652,35 @@ void renderer::draw()
 		// continue this frame
 	}
 
+	// Input Latency
+	if (this->m_input_latency_report)
+	{
+		// the image is queued for the present (the time that the image is displayed is NOT available)
+		if (0U != frame_packet->m_input_tick_count)
+		{
+			uint64_t const input_latency_tick_count = tick_count_now() - frame_packet->m_input_tick_count;
+
+			this->m_input_latency_total_tick_count += input_latency_tick_count;
+			this->m_input_latency_max_tick_count = std::max(this->m_input_latency_max_tick_count, input_latency_tick_count);
+			++this->m_input_latency_sample_count;
+		}
+
+		++this->m_input_latency_report_frame_count;
+
+		if (this->m_input_latency_report_frame_count >= input_latency_report_frame_count)
+		{
+			if (this->m_input_latency_sample_count > 0U)
+			{
+				printf("Input Latency: %u frames in flight, input to present %.3f ms (max %.3f ms)\n", static_cast<unsigned>(this->m_frame_throttling_count), 1000.0 * static_cast<double>(this->m_input_latency_total_tick_count) * this->m_tick_count_resolution / static_cast<double>(this->m_input_latency_sample_count), 1000.0 * static_cast<double>(this->m_input_latency_max_tick_count) * this->m_tick_count_resolution);
+			}
+
+			this->m_input_latency_report_frame_count = 0U;
+			this->m_input_latency_sample_count = 0U;
+			this->m_input_latency_total_tick_count = 0U;
+			this->m_input_latency_max_tick_count = 0U;
+		}
+	}
+
 	++this->m_frame_throttling_index;
-	this->m_frame_throttling_index %= FRAME_THROTTLING_COUNT;
+	this->m_frame_throttling_index %= this->m_frame_throttling_count;
 }
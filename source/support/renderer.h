@@ -23,6 +23,12 @@ extern void renderer_destroy(class renderer *renderer);
 extern void renderer_attach_window(class renderer *renderer, void *wsi_window);
 extern void renderer_on_window_resize(class renderer *renderer);
 extern void renderer_dettach_window(class renderer *renderer);
+// the frame is simulated and drawn on the calling thread, or only simulated (and drawn on the render thread one frame behind) when the render thread is running
 extern void renderer_draw(class renderer *renderer);
+// the window should be attached before the render thread is started, and dettached after the render thread is stopped
+extern void renderer_start_render_thread(class renderer *renderer);
+extern void renderer_stop_render_thread(class renderer *renderer);
+// the latency from the input to the present is measured from the first input after the previous frame was simulated
+extern void renderer_on_input(class renderer *renderer);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,401 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "scene_cache.h"
+#include "scene_cooker.h"
+#include <cstring>
+#include <assert.h>
+#include <stdio.h>
+
+#if defined(__GNUC__)
+#include <sys/types.h>
+#include <sys/stat.h>
+#elif defined(_MSC_VER)
+#include <direct.h>
+#else
+#error Unknown Compiler
+#endif
+
+static constexpr uint32_t const scene_cache_magic = 0X43534450U; // "PDSC"
+
+// should be increased whenever the layout of the uploaded buffers or this file format is changed
+static constexpr uint32_t const scene_cache_version = 2U;
+
+static constexpr uint32_t const scene_cache_buffer_alignment = 16U;
+
+struct scene_cache_header
+{
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint64_t m_source_hash;
+    uint32_t m_mesh_count;
+    uint32_t _unused_padding_1;
+};
+
+struct scene_cache_mesh_header
+{
+    uint32_t m_skinned;
+    uint32_t m_subset_count;
+    uint32_t m_instance_count;
+    uint32_t _unused_padding_1;
+};
+
+struct scene_cache_mesh_subset_header
+{
+    uint32_t m_vertex_count;
+    uint32_t m_index_count;
+    uint32_t m_index_type_uint16;
+    uint32_t m_buffer_sizes[SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT];
+    uint32_t m_texture_image_uri_lengths[SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT];
+    uint32_t _unused_padding_1;
+};
+
+static inline mcrt_string scene_cache_file_path(char const *cache_directory, char const *cache_file_name);
+
+static inline void scene_cache_append(mcrt_vector<uint8_t> &cache_data, void const *data, size_t size);
+
+static inline void scene_cache_append_padding(mcrt_vector<uint8_t> &cache_data);
+
+extern uint64_t scene_cache_hash(uint64_t hash, void const *data, size_t size)
+{
+    uint8_t const *const bytes = static_cast<uint8_t const *>(data);
+
+    for (size_t byte_index = 0U; byte_index < size; ++byte_index)
+    {
+        hash ^= static_cast<uint64_t>(bytes[byte_index]);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+extern bool scene_cache_write(char const *cache_directory, char const *cache_file_name, uint64_t source_hash, mcrt_vector<scene_cache_mesh> const &meshes)
+{
+    mcrt_vector<uint8_t> cache_data;
+
+    scene_cache_header const header = {scene_cache_magic, scene_cache_version, source_hash, static_cast<uint32_t>(meshes.size()), 0U};
+    scene_cache_append(cache_data, &header, sizeof(scene_cache_header));
+
+    for (size_t mesh_index = 0U; mesh_index < meshes.size(); ++mesh_index)
+    {
+        scene_cache_mesh const &mesh = meshes[mesh_index];
+
+        if (mesh.m_skinned)
+        {
+            return false;
+        }
+
+        scene_cache_mesh_header const mesh_header = {0U, static_cast<uint32_t>(mesh.m_subsets.size()), static_cast<uint32_t>(mesh.m_instance_model_transforms.size()), 0U};
+        scene_cache_append(cache_data, &mesh_header, sizeof(scene_cache_mesh_header));
+
+        scene_cache_append(cache_data, mesh.m_instance_model_transforms.data(), sizeof(DirectX::XMFLOAT4X4) * mesh.m_instance_model_transforms.size());
+
+        for (size_t subset_index = 0U; subset_index < mesh.m_subsets.size(); ++subset_index)
+        {
+            scene_cache_mesh_subset const &subset = mesh.m_subsets[subset_index];
+
+            scene_cache_mesh_subset_header subset_header;
+            subset_header.m_vertex_count = subset.m_vertex_count;
+            subset_header.m_index_count = subset.m_index_count;
+            subset_header.m_index_type_uint16 = subset.m_index_type_uint16 ? 1U : 0U;
+            for (uint32_t buffer_index = 0U; buffer_index < SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT; ++buffer_index)
+            {
+                assert((NULL != subset.m_buffers[buffer_index]) || (0U == subset.m_buffer_sizes[buffer_index]));
+                subset_header.m_buffer_sizes[buffer_index] = (NULL != subset.m_buffers[buffer_index]) ? subset.m_buffer_sizes[buffer_index] : 0U;
+            }
+            for (uint32_t texture_index = 0U; texture_index < SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT; ++texture_index)
+            {
+                subset_header.m_texture_image_uri_lengths[texture_index] = static_cast<uint32_t>(subset.m_texture_image_uris[texture_index].size());
+            }
+            subset_header._unused_padding_1 = 0U;
+            scene_cache_append(cache_data, &subset_header, sizeof(scene_cache_mesh_subset_header));
+
+            for (uint32_t texture_index = 0U; texture_index < SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT; ++texture_index)
+            {
+                scene_cache_append(cache_data, subset.m_texture_image_uris[texture_index].data(), subset.m_texture_image_uris[texture_index].size());
+            }
+
+            // the buffers are aligned to make sure that the memcpy into the staging buffers is fast
+            for (uint32_t buffer_index = 0U; buffer_index < SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT; ++buffer_index)
+            {
+                if (subset_header.m_buffer_sizes[buffer_index] > 0U)
+                {
+                    scene_cache_append_padding(cache_data);
+                    scene_cache_append(cache_data, subset.m_buffers[buffer_index], subset_header.m_buffer_sizes[buffer_index]);
+                }
+            }
+
+            scene_cache_append_padding(cache_data);
+        }
+    }
+
+#if defined(__GNUC__)
+    mkdir(cache_directory, 0777);
+#elif defined(_MSC_VER)
+    _mkdir(cache_directory);
+#else
+#error Unknown Compiler
+#endif
+
+    mcrt_string const path = scene_cache_file_path(cache_directory, cache_file_name);
+
+    // written to the temporary file at first to make sure that the partially written cache file is never read
+    mcrt_string const temporary_path = path + ".tmp";
+
+    FILE *const file = fopen(temporary_path.c_str(), "wb");
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    size_t const written_size = fwrite(cache_data.data(), 1U, cache_data.size(), file);
+
+    int const result_fclose = fclose(file);
+
+    if ((cache_data.size() != written_size) || (0 != result_fclose))
+    {
+        remove(temporary_path.c_str());
+        return false;
+    }
+
+    // "rename" fails on Windows if the destination exists
+    remove(path.c_str());
+
+    if (0 != rename(temporary_path.c_str(), path.c_str()))
+    {
+        remove(temporary_path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+extern bool scene_cache_read(char const *cache_directory, char const *cache_file_name, uint64_t source_hash, mapped_file *out_cache_file, mcrt_vector<scene_cache_mesh> &out_meshes)
+{
+    mcrt_string const path = scene_cache_file_path(cache_directory, cache_file_name);
+
+    mapped_file cache_file;
+    if (!map_file_read_only(path.c_str(), &cache_file))
+    {
+        return false;
+    }
+
+    uint8_t const *const cache_data = static_cast<uint8_t const *>(cache_file.m_memory_range_base);
+    size_t const cache_data_size = cache_file.m_memory_range_size;
+    size_t cache_data_offset = 0U;
+
+    // the cache file may be truncated or corrupted, and every read is validated
+    auto const read = [cache_data, cache_data_size, &cache_data_offset](size_t size) -> uint8_t const *
+    {
+        if ((cache_data_offset > cache_data_size) || (size > (cache_data_size - cache_data_offset)))
+        {
+            return NULL;
+        }
+
+        uint8_t const *const data = cache_data + cache_data_offset;
+        cache_data_offset += size;
+        return data;
+    };
+
+    auto const skip_padding = [&cache_data_offset]()
+    {
+        cache_data_offset = (cache_data_offset + (scene_cache_buffer_alignment - 1U)) & (~static_cast<size_t>(scene_cache_buffer_alignment - 1U));
+    };
+
+    bool valid = false;
+    out_meshes.clear();
+    {
+        scene_cache_header header;
+        uint8_t const *const header_data = read(sizeof(scene_cache_header));
+        if (NULL != header_data)
+        {
+            std::memcpy(&header, header_data, sizeof(scene_cache_header));
+            valid = (scene_cache_magic == header.m_magic) && (scene_cache_version == header.m_version) && (source_hash == header.m_source_hash);
+        }
+
+        // the counts are validated against the remaining size before anything is allocated
+        if (valid && ((static_cast<size_t>(header.m_mesh_count) * sizeof(scene_cache_mesh_header)) > (cache_data_size - cache_data_offset)))
+        {
+            valid = false;
+        }
+
+        if (valid)
+        {
+            out_meshes.resize(header.m_mesh_count);
+        }
+
+        for (uint32_t mesh_index = 0U; valid && (mesh_index < header.m_mesh_count); ++mesh_index)
+        {
+            scene_cache_mesh &mesh = out_meshes[mesh_index];
+
+            scene_cache_mesh_header mesh_header;
+            uint8_t const *const mesh_header_data = read(sizeof(scene_cache_mesh_header));
+            if (NULL == mesh_header_data)
+            {
+                valid = false;
+                break;
+            }
+            std::memcpy(&mesh_header, mesh_header_data, sizeof(scene_cache_mesh_header));
+
+            // the skinned meshes are never written
+            mesh.m_skinned = (0U != mesh_header.m_skinned);
+            if (mesh.m_skinned)
+            {
+                valid = false;
+                break;
+            }
+
+            uint8_t const *const instance_model_transforms_data = read(sizeof(DirectX::XMFLOAT4X4) * static_cast<size_t>(mesh_header.m_instance_count));
+            if (NULL == instance_model_transforms_data)
+            {
+                valid = false;
+                break;
+            }
+            mesh.m_instance_model_transforms.resize(mesh_header.m_instance_count);
+            std::memcpy(mesh.m_instance_model_transforms.data(), instance_model_transforms_data, sizeof(DirectX::XMFLOAT4X4) * static_cast<size_t>(mesh_header.m_instance_count));
+
+            if ((static_cast<size_t>(mesh_header.m_subset_count) * sizeof(scene_cache_mesh_subset_header)) > (cache_data_size - cache_data_offset))
+            {
+                valid = false;
+                break;
+            }
+
+            mesh.m_subsets.resize(mesh_header.m_subset_count);
+            for (uint32_t subset_index = 0U; subset_index < mesh_header.m_subset_count; ++subset_index)
+            {
+                scene_cache_mesh_subset &subset = mesh.m_subsets[subset_index];
+
+                scene_cache_mesh_subset_header subset_header;
+                uint8_t const *const subset_header_data = read(sizeof(scene_cache_mesh_subset_header));
+                if (NULL == subset_header_data)
+                {
+                    valid = false;
+                    break;
+                }
+                std::memcpy(&subset_header, subset_header_data, sizeof(scene_cache_mesh_subset_header));
+
+                subset.m_vertex_count = subset_header.m_vertex_count;
+                subset.m_index_count = subset_header.m_index_count;
+                subset.m_index_type_uint16 = (0U != subset_header.m_index_type_uint16);
+
+                // the buffer sizes should match the counts (the cooked buffers are uploaded and built into the acceleration structures without any further check)
+                {
+                    size_t expected_buffer_sizes[SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT];
+                    scene_cook_get_mesh_subset_buffer_sizes(false, subset.m_vertex_count, subset.m_index_count, subset.m_index_type_uint16, expected_buffer_sizes);
+
+                    if (0U != (subset.m_index_count % 3U))
+                    {
+                        valid = false;
+                        break;
+                    }
+
+                    for (uint32_t buffer_index = 0U; buffer_index < SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT; ++buffer_index)
+                    {
+                        if (expected_buffer_sizes[buffer_index] != static_cast<size_t>(subset_header.m_buffer_sizes[buffer_index]))
+                        {
+                            valid = false;
+                            break;
+                        }
+                    }
+
+                    if (!valid)
+                    {
+                        break;
+                    }
+                }
+
+                for (uint32_t texture_index = 0U; valid && (texture_index < SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT); ++texture_index)
+                {
+                    uint8_t const *const texture_image_uri_data = read(subset_header.m_texture_image_uri_lengths[texture_index]);
+                    if (NULL == texture_image_uri_data)
+                    {
+                        valid = false;
+                        break;
+                    }
+                    subset.m_texture_image_uris[texture_index].assign(reinterpret_cast<char const *>(texture_image_uri_data), subset_header.m_texture_image_uri_lengths[texture_index]);
+                }
+
+                for (uint32_t buffer_index = 0U; valid && (buffer_index < SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT); ++buffer_index)
+                {
+                    subset.m_buffer_sizes[buffer_index] = subset_header.m_buffer_sizes[buffer_index];
+
+                    if (subset_header.m_buffer_sizes[buffer_index] > 0U)
+                    {
+                        skip_padding();
+                        subset.m_buffers[buffer_index] = read(subset_header.m_buffer_sizes[buffer_index]);
+                        if (NULL == subset.m_buffers[buffer_index])
+                        {
+                            valid = false;
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        subset.m_buffers[buffer_index] = NULL;
+                    }
+                }
+
+                skip_padding();
+
+                if (!valid)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (!valid)
+    {
+        out_meshes.clear();
+        unmap_file(&cache_file);
+        return false;
+    }
+
+    (*out_cache_file) = cache_file;
+    return true;
+}
+
+static inline mcrt_string scene_cache_file_path(char const *cache_directory, char const *cache_file_name)
+{
+    // the directories of the source asset are flattened to make sure that only the cache directory is created
+    mcrt_string flattened_cache_file_name(cache_file_name);
+    for (size_t character_index = 0U; character_index < flattened_cache_file_name.size(); ++character_index)
+    {
+        if (('/' == flattened_cache_file_name[character_index]) || ('\\' == flattened_cache_file_name[character_index]))
+        {
+            flattened_cache_file_name[character_index] = '_';
+        }
+    }
+
+    return mcrt_string(cache_directory) + '/' + flattened_cache_file_name + ".scene-cache";
+}
+
+static inline void scene_cache_append(mcrt_vector<uint8_t> &cache_data, void const *data, size_t size)
+{
+    if (size > 0U)
+    {
+        uint8_t const *const bytes = static_cast<uint8_t const *>(data);
+        cache_data.insert(cache_data.end(), bytes, bytes + size);
+    }
+}
+
+static inline void scene_cache_append_padding(mcrt_vector<uint8_t> &cache_data)
+{
+    size_t const padded_size = (cache_data.size() + (scene_cache_buffer_alignment - 1U)) & (~static_cast<size_t>(scene_cache_buffer_alignment - 1U));
+    cache_data.resize(padded_size, 0U);
+}
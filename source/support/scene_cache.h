@@ -0,0 +1,76 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _SCENE_CACHE_H_
+#define _SCENE_CACHE_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+#include <DirectXMath.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#include "mapped_file_input_stream_factory.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_vector.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_string.h"
+
+// vertex position, acceleration structure build input vertex position, vertex varying, vertex joint, index, information
+static constexpr uint32_t const SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT = 6U;
+
+// normal, emissive, base color, metallic roughness
+static constexpr uint32_t const SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT = 4U;
+
+// The mesh subset in the layout which is uploaded to the GPU.
+struct scene_cache_mesh_subset
+{
+	uint32_t m_vertex_count;
+	uint32_t m_index_count;
+	bool m_index_type_uint16;
+	// NULL when the buffer is not used
+	// point to either the buffer storages (when cooked from the source asset) or the mapped cache file
+	void const *m_buffers[SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT];
+	uint32_t m_buffer_sizes[SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT];
+	mcrt_vector<uint8_t> m_buffer_storages[SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT];
+	// empty when the texture is not used
+	mcrt_string m_texture_image_uris[SCENE_CACHE_MESH_SUBSET_TEXTURE_COUNT];
+};
+
+struct scene_cache_mesh
+{
+	bool m_skinned;
+	mcrt_vector<scene_cache_mesh_subset> m_subsets;
+	mcrt_vector<DirectX::XMFLOAT4X4> m_instance_model_transforms;
+};
+
+// FNV-1a
+static constexpr uint64_t const SCENE_CACHE_HASH_INITIAL_VALUE = 14695981039346656037ULL;
+
+extern uint64_t scene_cache_hash(uint64_t hash, void const *data, size_t size);
+
+// The skinned meshes are NOT supported, and "false" is returned for a scene which contains any skinned mesh.
+// The pose table is NOT serialized, since the "scene_animation_skeleton" can only be created by the glTF import, and the skinned scenes are always imported from the source asset at startup.
+extern bool scene_cache_write(char const *cache_directory, char const *cache_file_name, uint64_t source_hash, mcrt_vector<scene_cache_mesh> const &meshes);
+
+// "false" when the cache file does not exist or the source hash does not match, and the caller should import the source asset.
+// The buffers point to the mapped cache file, and the cache file should NOT be unmapped until the buffers are no longer used.
+extern bool scene_cache_read(char const *cache_directory, char const *cache_file_name, uint64_t source_hash, mapped_file *out_cache_file, mcrt_vector<scene_cache_mesh> &out_meshes);
+
+#endif
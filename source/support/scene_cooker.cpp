@@ -0,0 +1,321 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "scene_cooker.h"
+#include "mesh_locality_optimizer.h"
+#include "vertex_packing.h"
+#include <algorithm>
+#include <cstring>
+#include <assert.h>
+#include "../../shaders/common_asset_constant.sli"
+
+static inline bool compare_directory_file_name(directory_file const &file_a, directory_file const &file_b);
+
+static inline void quantize_vertex_positions(uint32_t vertex_count, scene_mesh_vertex_position_binding const *vertex_positions, uint32_t const *vertex_remap, DirectX::XMFLOAT3 *out_center, DirectX::XMFLOAT3 *out_extent, mesh_subset_vertex_quantized_position_binding_T *out_quantized_vertex_positions, scene_mesh_vertex_position_binding *out_dequantized_vertex_positions);
+
+static void cook_mesh_subset(bool skinned, scene_mesh_subset_data const &in_subset_data, scene_cache_mesh_subset *out_cooked_mesh_subset, double *inout_total_cache_lines_before_locality_optimization, double *inout_total_cache_lines_after_locality_optimization, uint64_t *inout_total_triangle_count);
+
+extern void scene_cook_mesh_subset_task_main(uint32_t task_index, void *user_data)
+{
+    scene_cook_mesh_subset_task *const task = static_cast<scene_cook_mesh_subset_task *>(user_data) + task_index;
+
+    cook_mesh_subset(task->m_skinned, (*task->m_subset_data), task->m_cooked_subset, &task->m_cache_lines_before_locality_optimization, &task->m_cache_lines_after_locality_optimization, &task->m_triangle_count);
+
+    // the imported vertices and indices are no longer used once they have been packed (the peak memory usage at load time is reduced since the other tasks are still running)
+    mcrt_vector<scene_mesh_vertex_position_binding>().swap(task->m_subset_data->m_vertex_position_binding);
+    mcrt_vector<scene_mesh_vertex_varying_binding>().swap(task->m_subset_data->m_vertex_varying_binding);
+    mcrt_vector<scene_mesh_vertex_joint_binding>().swap(task->m_subset_data->m_vertex_joint_binding);
+    mcrt_vector<uint32_t>().swap(task->m_subset_data->m_indices);
+}
+
+static inline void quantize_vertex_positions(uint32_t vertex_count, scene_mesh_vertex_position_binding const *vertex_positions, uint32_t const *vertex_remap, DirectX::XMFLOAT3 *out_center, DirectX::XMFLOAT3 *out_extent, mesh_subset_vertex_quantized_position_binding_T *out_quantized_vertex_positions, scene_mesh_vertex_position_binding *out_dequantized_vertex_positions)
+{
+    assert(vertex_count > 0U);
+
+    // the vertex "i" of the output is the vertex "vertex_remap[i]" of the input (the identity when "vertex_remap" is NULL)
+    DirectX::XMVECTOR aabb_min = DirectX::XMLoadFloat3(&vertex_positions[0].m_position);
+    DirectX::XMVECTOR aabb_max = aabb_min;
+    for (uint32_t vertex_index = 1U; vertex_index < vertex_count; ++vertex_index)
+    {
+        DirectX::XMVECTOR const vertex_position = DirectX::XMLoadFloat3(&vertex_positions[vertex_index].m_position);
+        aabb_min = DirectX::XMVectorMin(aabb_min, vertex_position);
+        aabb_max = DirectX::XMVectorMax(aabb_max, vertex_position);
+    }
+
+    DirectX::XMVECTOR const center = DirectX::XMVectorScale(DirectX::XMVectorAdd(aabb_min, aabb_max), 0.5F);
+    DirectX::XMVECTOR const extent = DirectX::XMVectorScale(DirectX::XMVectorSubtract(aabb_max, aabb_min), 0.5F);
+    DirectX::XMStoreFloat3(out_center, center);
+    DirectX::XMStoreFloat3(out_extent, extent);
+
+    // the degenerated axis (extent is zero) is always quantized to zero
+    DirectX::XMFLOAT3 inverse_extent;
+    inverse_extent.x = (out_extent->x > 0.0F) ? (1.0F / out_extent->x) : 0.0F;
+    inverse_extent.y = (out_extent->y > 0.0F) ? (1.0F / out_extent->y) : 0.0F;
+    inverse_extent.z = (out_extent->z > 0.0F) ? (1.0F / out_extent->z) : 0.0F;
+
+    vertex_packing_quantize_positions(vertex_count, vertex_positions, vertex_remap, (*out_center), (*out_extent), inverse_extent, out_quantized_vertex_positions, out_dequantized_vertex_positions);
+}
+
+static void cook_mesh_subset(bool skinned, scene_mesh_subset_data const &in_subset_data, scene_cache_mesh_subset *out_cooked_mesh_subset, double *inout_total_cache_lines_before_locality_optimization, double *inout_total_cache_lines_after_locality_optimization, uint64_t *inout_total_triangle_count)
+{
+    uint32_t const vertex_count = static_cast<uint32_t>(in_subset_data.m_vertex_position_binding.size());
+
+    uint32_t const index_count = static_cast<uint32_t>(in_subset_data.m_indices.size());
+
+    bool const index_type_uint16 = (in_subset_data.m_max_index <= static_cast<uint32_t>(UINT16_MAX));
+
+    assert(vertex_count == in_subset_data.m_vertex_varying_binding.size());
+
+    assert((!skinned) || (vertex_count == in_subset_data.m_vertex_joint_binding.size()));
+
+    bool const quantize_vertex_position = (!skinned) && SCENE_COOK_ENABLE_STATIC_MESH_VERTEX_POSITION_QUANTIZATION;
+
+    uint32_t const vertex_position_buffer_stride = (!quantize_vertex_position) ? sizeof(scene_mesh_vertex_position_binding) : sizeof(mesh_subset_vertex_quantized_position_binding_T);
+
+    size_t cooked_buffer_sizes[SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT];
+    scene_cook_get_mesh_subset_buffer_sizes(skinned, vertex_count, index_count, index_type_uint16, cooked_buffer_sizes);
+
+    // the sizes of the packed buffers are known in advance, and each buffer is written exactly once into its final storage (rather than packed into the temporary vectors and copied)
+    out_cooked_mesh_subset->m_vertex_count = vertex_count;
+    out_cooked_mesh_subset->m_index_count = index_count;
+    out_cooked_mesh_subset->m_index_type_uint16 = index_type_uint16;
+
+    for (uint32_t mesh_subset_asset_buffer_index = 0U; mesh_subset_asset_buffer_index < SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT; ++mesh_subset_asset_buffer_index)
+    {
+        if (cooked_buffer_sizes[mesh_subset_asset_buffer_index] > 0U)
+        {
+            out_cooked_mesh_subset->m_buffer_storages[mesh_subset_asset_buffer_index].resize(cooked_buffer_sizes[mesh_subset_asset_buffer_index]);
+
+            out_cooked_mesh_subset->m_buffers[mesh_subset_asset_buffer_index] = out_cooked_mesh_subset->m_buffer_storages[mesh_subset_asset_buffer_index].data();
+
+            out_cooked_mesh_subset->m_buffer_sizes[mesh_subset_asset_buffer_index] = static_cast<uint32_t>(cooked_buffer_sizes[mesh_subset_asset_buffer_index]);
+        }
+        else
+        {
+            out_cooked_mesh_subset->m_buffers[mesh_subset_asset_buffer_index] = NULL;
+
+            out_cooked_mesh_subset->m_buffer_sizes[mesh_subset_asset_buffer_index] = 0U;
+        }
+    }
+
+    void *const cooked_buffers[SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT] = {
+        out_cooked_mesh_subset->m_buffer_storages[0].data(),
+        out_cooked_mesh_subset->m_buffer_storages[1].data(),
+        out_cooked_mesh_subset->m_buffer_storages[2].data(),
+        out_cooked_mesh_subset->m_buffer_storages[3].data(),
+        out_cooked_mesh_subset->m_buffer_storages[4].data(),
+        out_cooked_mesh_subset->m_buffer_storages[5].data()};
+
+    // the 32-bit indices are written directly into the index buffer, and only the narrowed indices need the temporary 32-bit indices
+    mcrt_vector<uint32_t> vertex_remap;
+    mcrt_vector<uint32_t> optimized_uint32_indices;
+    uint32_t const *indices;
+    if (SCENE_COOK_ENABLE_MESH_LOCALITY_OPTIMIZATION)
+    {
+        vertex_remap.resize(vertex_count);
+
+        uint32_t *optimized_indices;
+        if (index_type_uint16)
+        {
+            optimized_uint32_indices.resize(index_count);
+            optimized_indices = optimized_uint32_indices.data();
+        }
+        else
+        {
+            optimized_indices = static_cast<uint32_t *>(cooked_buffers[4]);
+        }
+
+        optimize_mesh_locality(vertex_count, &in_subset_data.m_vertex_position_binding[0].m_position.x, sizeof(scene_mesh_vertex_position_binding), index_count, in_subset_data.m_indices.data(), optimized_indices, vertex_remap.data());
+
+        uint32_t const triangle_count = index_count / 3U;
+
+        (*inout_total_cache_lines_before_locality_optimization) += static_cast<double>(compute_mesh_average_cache_lines_per_triangle(index_count, in_subset_data.m_indices.data(), vertex_position_buffer_stride) + compute_mesh_average_cache_lines_per_triangle(index_count, in_subset_data.m_indices.data(), sizeof(scene_mesh_vertex_varying_binding))) * triangle_count;
+
+        (*inout_total_cache_lines_after_locality_optimization) += static_cast<double>(compute_mesh_average_cache_lines_per_triangle(index_count, optimized_indices, vertex_position_buffer_stride) + compute_mesh_average_cache_lines_per_triangle(index_count, optimized_indices, sizeof(scene_mesh_vertex_varying_binding))) * triangle_count;
+
+        (*inout_total_triangle_count) += triangle_count;
+
+        indices = optimized_indices;
+    }
+    else
+    {
+        indices = in_subset_data.m_indices.data();
+
+        if (!index_type_uint16)
+        {
+            std::memcpy(cooked_buffers[4], indices, sizeof(uint32_t) * index_count);
+        }
+    }
+
+    if (index_type_uint16)
+    {
+        vertex_packing_narrow_indices(index_count, indices, static_cast<uint16_t *>(cooked_buffers[4]));
+    }
+
+    uint32_t const *const source_vertex_remap = (!SCENE_COOK_ENABLE_MESH_LOCALITY_OPTIMIZATION) ? NULL : vertex_remap.data();
+
+    DirectX::XMFLOAT3 vertex_position_quantization_center(0.0F, 0.0F, 0.0F);
+    DirectX::XMFLOAT3 vertex_position_quantization_extent(0.0F, 0.0F, 0.0F);
+    if (quantize_vertex_position)
+    {
+        // the bottom level acceleration structure is built from the dequantized positions to make sure that the ray hits exactly the same triangle which is reconstructed in the shader
+        quantize_vertex_positions(vertex_count, in_subset_data.m_vertex_position_binding.data(), source_vertex_remap, &vertex_position_quantization_center, &vertex_position_quantization_extent, static_cast<mesh_subset_vertex_quantized_position_binding_T *>(cooked_buffers[0]), static_cast<scene_mesh_vertex_position_binding *>(cooked_buffers[1]));
+    }
+
+    {
+        scene_mesh_vertex_position_binding *const vertex_positions = (!quantize_vertex_position) ? static_cast<scene_mesh_vertex_position_binding *>(cooked_buffers[0]) : NULL;
+        scene_mesh_vertex_varying_binding *const vertex_varyings = static_cast<scene_mesh_vertex_varying_binding *>(cooked_buffers[2]);
+        scene_mesh_vertex_joint_binding *const vertex_joints = (!skinned) ? NULL : static_cast<scene_mesh_vertex_joint_binding *>(cooked_buffers[3]);
+
+        for (uint32_t vertex_index = 0U; vertex_index < vertex_count; ++vertex_index)
+        {
+            uint32_t const source_vertex_index = (NULL != source_vertex_remap) ? source_vertex_remap[vertex_index] : vertex_index;
+
+            if (NULL != vertex_positions)
+            {
+                vertex_positions[vertex_index] = in_subset_data.m_vertex_position_binding[source_vertex_index];
+            }
+
+            vertex_varyings[vertex_index] = in_subset_data.m_vertex_varying_binding[source_vertex_index];
+
+            if (NULL != vertex_joints)
+            {
+                vertex_joints[vertex_index] = in_subset_data.m_vertex_joint_binding[source_vertex_index];
+            }
+        }
+    }
+
+    mesh_subset_information_storage_buffer_T mesh_subset_information_storage_buffer_T_source;
+    {
+        mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags = 0U;
+        if (index_type_uint16)
+        {
+            mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags |= Buffer_Flag_Index_Type_UInt16;
+        }
+        if (quantize_vertex_position)
+        {
+            mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags |= Buffer_Flag_Vertex_Position_Quantized;
+        }
+        if (!in_subset_data.m_normal_texture_image_uri.empty())
+        {
+            mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags |= Texture_Flag_Enable_Normal_Texture;
+        }
+        if (!in_subset_data.m_emissive_texture_image_uri.empty())
+        {
+            mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags |= Texture_Flag_Enable_Emissive_Texture;
+        }
+        if (!in_subset_data.m_base_color_texture_image_uri.empty())
+        {
+            mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags |= Texture_Flag_Enable_Base_Colorl_Texture;
+        }
+        if (!in_subset_data.m_metallic_roughness_texture_image_uri.empty())
+        {
+            mesh_subset_information_storage_buffer_T_source.m_buffer_texture_flags |= Texture_Flag_Enable_Metallic_Roughness_Texture;
+        }
+        mesh_subset_information_storage_buffer_T_source.m_normal_texture_scale = in_subset_data.m_normal_texture_scale;
+        mesh_subset_information_storage_buffer_T_source.m_emissive_factor_x = in_subset_data.m_emissive_factor.x;
+        mesh_subset_information_storage_buffer_T_source.m_emissive_factor_y = in_subset_data.m_emissive_factor.y;
+        mesh_subset_information_storage_buffer_T_source.m_emissive_factor_z = in_subset_data.m_emissive_factor.z;
+        mesh_subset_information_storage_buffer_T_source.m_base_color_factor_x = in_subset_data.m_base_color_factor.x;
+        mesh_subset_information_storage_buffer_T_source.m_base_color_factor_y = in_subset_data.m_base_color_factor.y;
+        mesh_subset_information_storage_buffer_T_source.m_base_color_factor_z = in_subset_data.m_base_color_factor.z;
+        mesh_subset_information_storage_buffer_T_source.m_metallic_factor = in_subset_data.m_metallic_factor;
+        mesh_subset_information_storage_buffer_T_source.m_roughness_factor = in_subset_data.m_roughness_factor;
+        mesh_subset_information_storage_buffer_T_source.m_vertex_position_quantization_center_x = vertex_position_quantization_center.x;
+        mesh_subset_information_storage_buffer_T_source.m_vertex_position_quantization_center_y = vertex_position_quantization_center.y;
+        mesh_subset_information_storage_buffer_T_source.m_vertex_position_quantization_center_z = vertex_position_quantization_center.z;
+        mesh_subset_information_storage_buffer_T_source.m_vertex_position_quantization_extent_x = vertex_position_quantization_extent.x;
+        mesh_subset_information_storage_buffer_T_source.m_vertex_position_quantization_extent_y = vertex_position_quantization_extent.y;
+        mesh_subset_information_storage_buffer_T_source.m_vertex_position_quantization_extent_z = vertex_position_quantization_extent.z;
+    }
+
+    std::memcpy(cooked_buffers[5], &mesh_subset_information_storage_buffer_T_source, sizeof(mesh_subset_information_storage_buffer_T));
+
+    out_cooked_mesh_subset->m_texture_image_uris[0] = in_subset_data.m_normal_texture_image_uri;
+    out_cooked_mesh_subset->m_texture_image_uris[1] = in_subset_data.m_emissive_texture_image_uri;
+    out_cooked_mesh_subset->m_texture_image_uris[2] = in_subset_data.m_base_color_texture_image_uri;
+    out_cooked_mesh_subset->m_texture_image_uris[3] = in_subset_data.m_metallic_roughness_texture_image_uri;
+}
+
+extern void scene_cook_get_mesh_subset_buffer_sizes(bool skinned, uint32_t vertex_count, uint32_t index_count, bool index_type_uint16, size_t out_buffer_sizes[SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT])
+{
+    bool const quantize_vertex_position = (!skinned) && SCENE_COOK_ENABLE_STATIC_MESH_VERTEX_POSITION_QUANTIZATION;
+
+    size_t const vertex_position_buffer_stride = (!quantize_vertex_position) ? sizeof(scene_mesh_vertex_position_binding) : sizeof(mesh_subset_vertex_quantized_position_binding_T);
+
+    out_buffer_sizes[0] = vertex_position_buffer_stride * vertex_count;
+    out_buffer_sizes[1] = (!quantize_vertex_position) ? 0U : (sizeof(scene_mesh_vertex_position_binding) * vertex_count);
+    out_buffer_sizes[2] = sizeof(scene_mesh_vertex_varying_binding) * vertex_count;
+    out_buffer_sizes[3] = (!skinned) ? 0U : (sizeof(scene_mesh_vertex_joint_binding) * vertex_count);
+    out_buffer_sizes[4] = (index_type_uint16) ? (sizeof(uint16_t) * index_count) : (sizeof(uint32_t) * index_count);
+    out_buffer_sizes[5] = sizeof(mesh_subset_information_storage_buffer_T);
+}
+
+extern uint64_t scene_cook_compute_source_hash(mapped_file_input_stream_factory *mapped_file_input_stream_factory, mcrt_string const &file_name)
+{
+    uint64_t source_hash = SCENE_CACHE_HASH_INITIAL_VALUE;
+
+    // the cache is invalidated when the options of the cooking are changed
+    uint8_t const cook_options[2] = {SCENE_COOK_ENABLE_STATIC_MESH_VERTEX_POSITION_QUANTIZATION ? static_cast<uint8_t>(1U) : static_cast<uint8_t>(0U), SCENE_COOK_ENABLE_MESH_LOCALITY_OPTIMIZATION ? static_cast<uint8_t>(1U) : static_cast<uint8_t>(0U)};
+    source_hash = scene_cache_hash(source_hash, cook_options, sizeof(cook_options));
+
+    // the glTF and the buffers (which are assumed to be the ".bin" files in the same directory)
+    mcrt_string directory_name;
+    {
+        size_t dir_name_pos = file_name.find_last_of("/\\");
+        if (mcrt_string::npos != dir_name_pos)
+        {
+            directory_name = file_name.substr(0U, dir_name_pos);
+        }
+    }
+
+    mcrt_vector<directory_file> directory_files;
+    mapped_file_input_stream_factory->enumerate_directory_files(directory_name.c_str(), directory_files);
+
+    mcrt_vector<directory_file> source_files;
+    for (size_t directory_file_index = 0U; directory_file_index < directory_files.size(); ++directory_file_index)
+    {
+        mcrt_string const &current_file_name = directory_files[directory_file_index].m_file_name;
+
+        bool const is_buffer_file = (current_file_name.size() > 4U) && (0 == current_file_name.compare(current_file_name.size() - 4U, 4U, ".bin"));
+
+        if ((current_file_name == file_name) || is_buffer_file)
+        {
+            source_files.push_back(directory_files[directory_file_index]);
+        }
+    }
+
+    // the order of the enumerated files is NOT deterministic
+    std::sort(source_files.begin(), source_files.end(), compare_directory_file_name);
+
+    for (size_t source_file_index = 0U; source_file_index < source_files.size(); ++source_file_index)
+    {
+        directory_file const &source_file = source_files[source_file_index];
+
+        source_hash = scene_cache_hash(source_hash, source_file.m_file_name.c_str(), source_file.m_file_name.size() + 1U);
+        source_hash = scene_cache_hash(source_hash, &source_file.m_file_size, sizeof(source_file.m_file_size));
+        source_hash = scene_cache_hash(source_hash, &source_file.m_modification_time, sizeof(source_file.m_modification_time));
+    }
+
+    return source_hash;
+}
+
+static inline bool compare_directory_file_name(directory_file const &file_a, directory_file const &file_b)
+{
+    return file_a.m_file_name < file_b.m_file_name;
+}
+
@@ -0,0 +1,57 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _SCENE_COOKER_H_
+#define _SCENE_COOKER_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include "scene_cache.h"
+#include "mapped_file_input_stream_factory.h"
+#include "../../thirdparty/Import-Asset/include/import_scene_asset.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_string.h"
+
+// store the vertex positions of the static meshes as 16-bit SNORM relative to the AABB of the mesh subset
+static constexpr bool const SCENE_COOK_ENABLE_STATIC_MESH_VERTEX_POSITION_QUANTIZATION = true;
+
+// reorder the triangles and vertices of each mesh subset to reduce the cache lines touched by the vertex fetch of the hit shading
+static constexpr bool const SCENE_COOK_ENABLE_MESH_LOCALITY_OPTIMIZATION = true;
+
+// The imported mesh subset is converted into the layout which is uploaded to the GPU (the narrowed indices, the packed vertices, the quantized positions and the information block).
+// The same cooking is used by the demo at load time and by the offline cooker, and both write the same scene cache.
+// Each packed buffer is written once into the storage of the cooked mesh subset, and the vertices and indices of the imported mesh subset are released when the task is done.
+struct scene_cook_mesh_subset_task
+{
+	bool m_skinned;
+	scene_mesh_subset_data *m_subset_data;
+	scene_cache_mesh_subset *m_cooked_subset;
+	double m_cache_lines_before_locality_optimization;
+	double m_cache_lines_after_locality_optimization;
+	uint64_t m_triangle_count;
+};
+
+// "user_data" points to the array of the tasks (to be used by "worker_pool_parallel_for").
+extern void scene_cook_mesh_subset_task_main(uint32_t task_index, void *user_data);
+
+// The sizes of the buffers which are written by the cooking (zero when the buffer is not used), which are also used to validate the scene cache.
+extern void scene_cook_get_mesh_subset_buffer_sizes(bool skinned, uint32_t vertex_count, uint32_t index_count, bool index_type_uint16, size_t out_buffer_sizes[SCENE_CACHE_MESH_SUBSET_BUFFER_COUNT]);
+
+// The hash of the names, the sizes and the modification times of the glTF and the buffers, and of the cooking options, which is stored in the scene cache to detect the stale cache.
+// The contents are NOT read, since this is computed on every launch.
+extern uint64_t scene_cook_compute_source_hash(mapped_file_input_stream_factory *mapped_file_input_stream_factory, mcrt_string const &file_name);
+
+#endif
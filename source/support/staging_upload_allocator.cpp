@@ -0,0 +1,188 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "staging_upload_allocator.h"
+#include <assert.h>
+
+static inline uint32_t tbb_align_up(uint32_t value, uint32_t alignment);
+
+staging_upload_arena::staging_upload_arena() : m_chunk_size(0U), m_offset_alignment(1U)
+{
+}
+
+void staging_upload_arena::init(brx_device *device, uint32_t chunk_size)
+{
+    assert(0U == this->m_chunk_size);
+    assert(this->m_chunks.empty());
+    assert(chunk_size > 0U);
+
+    this->m_chunk_size = chunk_size;
+    this->m_offset_alignment = device->get_staging_upload_buffer_offset_alignment();
+}
+
+void staging_upload_arena::allocate(brx_device *device, uint32_t size, brx_staging_upload_buffer **out_staging_upload_buffer, uint32_t *out_offset, void **out_host_memory)
+{
+    assert(this->m_chunk_size > 0U);
+    assert(size > 0U);
+
+    // only the last chunk is used for the allocation, and the free space of the previous chunks is wasted
+    uint32_t offset = (!this->m_chunks.empty()) ? tbb_align_up(this->m_chunks.back().m_allocated_size, this->m_offset_alignment) : 0U;
+
+    if (this->m_chunks.empty() || (offset > this->m_chunks.back().m_size) || (size > (this->m_chunks.back().m_size - offset)))
+    {
+        uint32_t const chunk_size = (size > this->m_chunk_size) ? size : this->m_chunk_size;
+
+        chunk new_chunk;
+        new_chunk.m_staging_upload_buffer = device->create_staging_upload_buffer(chunk_size);
+        new_chunk.m_host_memory_range_base = new_chunk.m_staging_upload_buffer->get_host_memory_range_base();
+        new_chunk.m_size = chunk_size;
+        new_chunk.m_allocated_size = 0U;
+        this->m_chunks.push_back(new_chunk);
+
+        offset = 0U;
+    }
+
+    chunk &last_chunk = this->m_chunks.back();
+
+    last_chunk.m_allocated_size = offset + size;
+    assert(last_chunk.m_allocated_size <= last_chunk.m_size);
+
+    (*out_staging_upload_buffer) = last_chunk.m_staging_upload_buffer;
+    (*out_offset) = offset;
+    (*out_host_memory) = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(last_chunk.m_host_memory_range_base) + offset);
+}
+
+void staging_upload_arena::destroy(brx_device *device)
+{
+    for (size_t chunk_index = 0U; chunk_index < this->m_chunks.size(); ++chunk_index)
+    {
+        device->destroy_staging_upload_buffer(this->m_chunks[chunk_index].m_staging_upload_buffer);
+    }
+
+    this->m_chunks.clear();
+    this->m_chunk_size = 0U;
+}
+
+staging_upload_ring::staging_upload_ring() : m_staging_upload_buffer(NULL), m_host_memory_range_base(NULL), m_size(0U), m_offset_alignment(1U), m_head(0U), m_used_size(0U)
+{
+}
+
+void staging_upload_ring::init(brx_device *device, uint32_t size)
+{
+    assert(NULL == this->m_staging_upload_buffer);
+    assert(size > 0U);
+
+    this->m_staging_upload_buffer = device->create_staging_upload_buffer(size);
+    this->m_host_memory_range_base = this->m_staging_upload_buffer->get_host_memory_range_base();
+    this->m_size = size;
+    this->m_offset_alignment = device->get_staging_upload_buffer_offset_alignment();
+    this->m_head = 0U;
+    this->m_used_size = 0U;
+}
+
+bool staging_upload_ring::allocate(uint32_t size, uint32_t *out_offset, void **out_host_memory, uint32_t *out_region_size)
+{
+    assert(NULL != this->m_staging_upload_buffer);
+    assert(size > 0U);
+
+    if (size > this->m_size)
+    {
+        return false;
+    }
+
+    // the used space is contiguous (modulo the size) and ends at the head, and the free space starts at the head
+    uint32_t offset = tbb_align_up(this->m_head, this->m_offset_alignment);
+    if ((offset > this->m_size) || (size > (this->m_size - offset)))
+    {
+        // wrap around, and the space between the head and the end is skipped
+        offset = 0U;
+    }
+
+    uint32_t const region_size = ((offset >= this->m_head) ? (offset - this->m_head) : (this->m_size - this->m_head + offset)) + size;
+
+    if (region_size > (this->m_size - this->m_used_size))
+    {
+        return false;
+    }
+
+    this->m_head = offset + size;
+    this->m_used_size += region_size;
+
+    (*out_offset) = offset;
+    (*out_host_memory) = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(this->m_host_memory_range_base) + offset);
+    (*out_region_size) = region_size;
+    return true;
+}
+
+void staging_upload_ring::free(uint32_t region_size)
+{
+    assert(region_size <= this->m_used_size);
+    this->m_used_size -= region_size;
+}
+
+brx_staging_upload_buffer *staging_upload_ring::get_staging_upload_buffer() const
+{
+    return this->m_staging_upload_buffer;
+}
+
+uint32_t staging_upload_ring::get_size() const
+{
+    return this->m_size;
+}
+
+void staging_upload_ring::destroy(brx_device *device)
+{
+    assert(0U == this->m_used_size);
+
+    if (NULL != this->m_staging_upload_buffer)
+    {
+        device->destroy_staging_upload_buffer(this->m_staging_upload_buffer);
+        this->m_staging_upload_buffer = NULL;
+    }
+
+    this->m_host_memory_range_base = NULL;
+    this->m_size = 0U;
+    this->m_head = 0U;
+}
+
+static inline uint32_t tbb_align_up(uint32_t value, uint32_t alignment)
+{
+    //
+    //  Copyright (c) 2005-2019 Intel Corporation
+    //
+    //  Licensed under the Apache License, Version 2.0 (the "License");
+    //  you may not use this file except in compliance with the License.
+    //  You may obtain a copy of the License at
+    //
+    //      http://www.apache.org/licenses/LICENSE-2.0
+    //
+    //  Unless required by applicable law or agreed to in writing, software
+    //  distributed under the License is distributed on an "AS IS" BASIS,
+    //  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    //  See the License for the specific language governing permissions and
+    //  limitations under the License.
+    //
+
+    // [alignUp](https://github.com/oneapi-src/oneTBB/blob/tbb_2019/src/tbbmalloc/shared_utils.h#L42)
+
+    assert(alignment != static_cast<uint32_t>(0));
+
+    // power-of-2 alignment
+    assert((alignment & (alignment - static_cast<uint32_t>(1))) == static_cast<uint32_t>(0));
+
+    return (((value - static_cast<uint32_t>(1)) | (alignment - static_cast<uint32_t>(1))) + static_cast<uint32_t>(1));
+}
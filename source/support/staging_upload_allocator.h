@@ -0,0 +1,84 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _STAGING_UPLOAD_ALLOCATOR_H_
+#define _STAGING_UPLOAD_ALLOCATOR_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../../thirdparty/Brioche/include/brx_device.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_vector.h"
+
+// Suballocates the staging memory of one submission from a few large staging upload buffers.
+// The allocations larger than the chunk size get a dedicated chunk.
+// All chunks are destroyed together by "destroy", which should be called after the fence of the submission has been waited.
+class staging_upload_arena
+{
+	struct chunk
+	{
+		brx_staging_upload_buffer *m_staging_upload_buffer;
+		void *m_host_memory_range_base;
+		uint32_t m_size;
+		uint32_t m_allocated_size;
+	};
+
+	uint32_t m_chunk_size;
+	uint32_t m_offset_alignment;
+	mcrt_vector<chunk> m_chunks;
+
+public:
+	staging_upload_arena();
+
+	void init(brx_device *device, uint32_t chunk_size);
+
+	// the offset is aligned to the staging upload buffer offset alignment
+	void allocate(brx_device *device, uint32_t size, brx_staging_upload_buffer **out_staging_upload_buffer, uint32_t *out_offset, void **out_host_memory);
+
+	void destroy(brx_device *device);
+};
+
+// Suballocates the staging memory of the uploads in flight from one staging upload buffer of fixed size.
+// The regions are freed in the same order as they are allocated (after the fence of the upload has been waited).
+class staging_upload_ring
+{
+	brx_staging_upload_buffer *m_staging_upload_buffer;
+	void *m_host_memory_range_base;
+	uint32_t m_size;
+	uint32_t m_offset_alignment;
+	uint32_t m_head;
+	uint32_t m_used_size;
+
+public:
+	staging_upload_ring();
+
+	void init(brx_device *device, uint32_t size);
+
+	// "false" when there is not enough free space, and the caller should retry after the oldest region has been freed
+	// the region size (which includes the padding skipped by the alignment and the wrap-around) should be passed to "free"
+	bool allocate(uint32_t size, uint32_t *out_offset, void **out_host_memory, uint32_t *out_region_size);
+
+	// frees the oldest region
+	void free(uint32_t region_size);
+
+	brx_staging_upload_buffer *get_staging_upload_buffer() const;
+
+	uint32_t get_size() const;
+
+	void destroy(brx_device *device);
+};
+
+#endif
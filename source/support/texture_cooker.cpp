@@ -0,0 +1,1722 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "texture_cooker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <assert.h>
+#include <stdio.h>
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_vector.h"
+
+static constexpr uint32_t const dds_magic = 0X20534444U; // "DDS "
+
+static constexpr uint32_t const dds_four_cc_dx10 = 0X30315844U; // "DX10"
+
+// DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE
+static constexpr uint32_t const dds_flags = 0X1U | 0X2U | 0X4U | 0X1000U | 0X20000U | 0X80000U;
+
+// DDPF_FOURCC
+static constexpr uint32_t const dds_pixel_format_flags = 0X4U;
+
+// DDSCAPS_COMPLEX | DDSCAPS_TEXTURE | DDSCAPS_MIPMAP
+static constexpr uint32_t const dds_caps = 0X8U | 0X1000U | 0X400000U;
+
+static constexpr uint32_t const dxgi_format_bc5_unorm = 83U;
+static constexpr uint32_t const dxgi_format_bc7_unorm = 98U;
+static constexpr uint32_t const dxgi_format_bc7_unorm_srgb = 99U;
+
+// D3D10_RESOURCE_DIMENSION_TEXTURE2D
+static constexpr uint32_t const dds_resource_dimension_texture_2d = 3U;
+
+static constexpr uint32_t const pvr_version = 0X03525650U;
+
+static constexpr uint32_t const pvr_pixel_format_astc_4x4 = 27U;
+
+static constexpr uint32_t const pvr_color_space_linear = 0U;
+static constexpr uint32_t const pvr_color_space_srgb = 1U;
+
+// unsigned byte normalized
+static constexpr uint32_t const pvr_channel_type = 0U;
+
+// BC5, BC7 and ASTC 4x4 are all 16 bytes per 4x4 block
+static constexpr uint32_t const texture_cook_block_size = 16U;
+
+// the interpolation weights of the 4-bit indices of the BC7 (mode 6)
+static constexpr uint32_t const bc7_weights[16] = {0U, 4U, 9U, 13U, 17U, 21U, 26U, 30U, 34U, 38U, 43U, 47U, 51U, 55U, 60U, 64U};
+
+// the unquantized weights of the ASTC 2-bit weights (QUANT_4)
+static constexpr uint32_t const astc_weights[4] = {0U, 21U, 43U, 64U};
+
+// 4x4 weight grid, QUANT_4 weights, single plane
+// the color endpoints are stored as 8-bit values which are NOT quantized, since there are enough bits left for the CEM 12
+static constexpr uint32_t const astc_block_mode = 0X042U;
+
+// LDR RGBA direct
+static constexpr uint32_t const astc_color_endpoint_mode = 12U;
+
+struct texture_cook_dds_header
+{
+    uint32_t m_magic;
+    uint32_t m_size;
+    uint32_t m_flags;
+    uint32_t m_height;
+    uint32_t m_width;
+    uint32_t m_pitch_or_linear_size;
+    uint32_t m_depth;
+    uint32_t m_mip_map_count;
+    uint32_t m_reserved_1[11];
+    uint32_t m_pixel_format_size;
+    uint32_t m_pixel_format_flags;
+    uint32_t m_pixel_format_four_cc;
+    uint32_t m_pixel_format_rgb_bit_count;
+    uint32_t m_pixel_format_bit_masks[4];
+    uint32_t m_caps;
+    uint32_t m_caps_2;
+    uint32_t m_caps_3;
+    uint32_t m_caps_4;
+    uint32_t m_reserved_2;
+    // DDS_HEADER_DXT10
+    uint32_t m_dxgi_format;
+    uint32_t m_resource_dimension;
+    uint32_t m_misc_flag;
+    uint32_t m_array_size;
+    uint32_t m_misc_flags_2;
+};
+
+static_assert(148U == sizeof(texture_cook_dds_header), "");
+
+struct texture_cook_pvr_header
+{
+    uint32_t m_version;
+    uint32_t m_flags;
+    uint32_t m_pixel_format_low;
+    uint32_t m_pixel_format_high;
+    uint32_t m_color_space;
+    uint32_t m_channel_type;
+    uint32_t m_height;
+    uint32_t m_width;
+    uint32_t m_depth;
+    uint32_t m_surface_count;
+    uint32_t m_face_count;
+    uint32_t m_mip_map_count;
+    uint32_t m_meta_data_size;
+};
+
+static_assert(52U == sizeof(texture_cook_pvr_header), "");
+
+struct texture_cook_inflate_state
+{
+    uint8_t const *m_input;
+    size_t m_input_size;
+    size_t m_input_position;
+    uint32_t m_bit_buffer;
+    uint32_t m_bit_count;
+    mcrt_vector<uint8_t> *m_output;
+};
+
+// canonical Huffman code (the symbols are sorted by the code length)
+struct texture_cook_huffman_table
+{
+    uint16_t m_counts[16];
+    uint16_t m_symbols[288];
+};
+
+struct texture_cook_encode_task_data
+{
+    TEXTURE_COOK_USAGE m_usage;
+    bool m_astc;
+    uint8_t const *m_pixels;
+    uint32_t m_width;
+    uint32_t m_height;
+    uint8_t *m_blocks;
+};
+
+static inline uint32_t texture_cook_calculate_mip_levels(uint32_t width, uint32_t height);
+
+static bool texture_cook_decode_png(void const *data, size_t size, uint32_t *out_width, uint32_t *out_height, mcrt_vector<uint8_t> &out_pixels);
+
+static bool texture_cook_inflate(uint8_t const *input, size_t input_size, mcrt_vector<uint8_t> &output);
+
+static inline bool texture_cook_inflate_bits(texture_cook_inflate_state *state, uint32_t bit_count, uint32_t *out_value);
+
+static inline bool texture_cook_huffman_table_build(texture_cook_huffman_table *table, uint8_t const *lengths, uint32_t symbol_count);
+
+static inline bool texture_cook_huffman_decode(texture_cook_inflate_state *state, texture_cook_huffman_table const *table, uint32_t *out_symbol);
+
+static bool texture_cook_inflate_codes(texture_cook_inflate_state *state, texture_cook_huffman_table const *length_table, texture_cook_huffman_table const *distance_table);
+
+static void texture_cook_generate_mips(uint32_t width, uint32_t height, TEXTURE_COOK_USAGE usage, mcrt_vector<mcrt_vector<uint8_t>> &inout_mips);
+
+static void texture_cook_encode_block_row_task_main(uint32_t task_index, void *user_data);
+
+static inline void texture_cook_encode_bc7_block(uint8_t const (*texels)[4], uint8_t *out_block);
+
+static inline void texture_cook_encode_bc4_block(uint8_t const (*texels)[4], uint32_t channel_index, uint8_t *out_block);
+
+static inline void texture_cook_encode_astc_4x4_block(uint8_t const (*texels)[4], uint8_t *out_block);
+
+static inline void texture_cook_fit_endpoints(uint8_t const (*texels)[4], float *out_endpoint_0, float *out_endpoint_1);
+
+static inline bool texture_cook_refine_endpoints(uint8_t const (*texels)[4], uint32_t const *indices, uint32_t const *weights, float *out_endpoint_0, float *out_endpoint_1);
+
+static inline uint32_t texture_cook_select_indices(uint8_t const (*texels)[4], uint32_t const *endpoint_0, uint32_t const *endpoint_1, uint32_t const *weights, uint32_t weight_count, uint32_t *out_indices);
+
+static inline void texture_cook_quantize_bc7_endpoint(float const *endpoint, uint32_t *out_quantized_endpoint, uint32_t *out_p_bit);
+
+static inline void texture_cook_write_block_bits(uint8_t *block, uint32_t *inout_bit_position, uint32_t value, uint32_t bit_count);
+
+static inline bool texture_cook_write_file(char const *path, mcrt_vector<uint8_t> const &data);
+
+static inline bool texture_transcode_png_image_asset_header_from_input_stream(import_asset_input_stream *input_stream, bool srgb, IMPORT_ASSET_IMAGE_HEADER *out_image_asset_header, size_t *out_image_asset_data_offset);
+
+extern TEXTURE_COOK_USAGE texture_cook_get_usage(uint32_t mesh_subset_texture_index)
+{
+    assert(mesh_subset_texture_index < 4U);
+
+    constexpr TEXTURE_COOK_USAGE const usages[4] = {TEXTURE_COOK_USAGE_NORMAL, TEXTURE_COOK_USAGE_COLOR, TEXTURE_COOK_USAGE_COLOR, TEXTURE_COOK_USAGE_LINEAR};
+
+    return usages[mesh_subset_texture_index];
+}
+
+extern void texture_cook_get_image_asset_file_names(mcrt_string const &scene_asset_file_name, mcrt_string const &image_uri, mcrt_string *out_image_asset_file_name_source, mcrt_string *out_image_asset_file_name_dds, mcrt_string *out_image_asset_file_name_pvr)
+{
+    mcrt_string image_asset_directory_name;
+
+    size_t dir_name_pos = scene_asset_file_name.find_last_of("/\\");
+    if (mcrt_string::npos != dir_name_pos)
+    {
+        image_asset_directory_name = scene_asset_file_name.substr(0U, dir_name_pos + 1U);
+    }
+    else
+    {
+        image_asset_directory_name += "./";
+    }
+
+    mcrt_string image_asset_file_name = image_asset_directory_name;
+
+    size_t ext_name_pos = image_uri.find_last_of(".");
+    if (mcrt_string::npos != ext_name_pos)
+    {
+        image_asset_file_name += image_uri.substr(0U, ext_name_pos + 1U);
+    }
+    else
+    {
+        image_asset_file_name += image_uri;
+    }
+
+    (*out_image_asset_file_name_source) = (image_asset_directory_name + image_uri);
+    (*out_image_asset_file_name_dds) = (image_asset_file_name + "dds");
+    (*out_image_asset_file_name_pvr) = (image_asset_file_name + "pvr");
+}
+
+extern mcrt_string texture_cook_get_cooked_image_asset_file_name(mcrt_string const &image_asset_file_name)
+{
+    // the "./" is added by "texture_cook_get_image_asset_file_names" when the scene is directly under the content root
+    mcrt_string cooked_image_asset_file_name((0 == image_asset_file_name.compare(0U, 2U, "./")) ? image_asset_file_name.substr(2U) : image_asset_file_name);
+
+    for (size_t character_index = 0U; character_index < cooked_image_asset_file_name.size(); ++character_index)
+    {
+        if (('/' == cooked_image_asset_file_name[character_index]) || ('\\' == cooked_image_asset_file_name[character_index]))
+        {
+            cooked_image_asset_file_name[character_index] = '_';
+        }
+    }
+
+    return cooked_image_asset_file_name;
+}
+
+extern bool texture_cook_is_source_image_supported(mcrt_string const &image_asset_file_name_source)
+{
+    size_t const ext_name_pos = image_asset_file_name_source.find_last_of(".");
+    if ((mcrt_string::npos == ext_name_pos) || ((ext_name_pos + 4U) != image_asset_file_name_source.size()))
+    {
+        return false;
+    }
+
+    char const *const ext_name = image_asset_file_name_source.c_str() + ext_name_pos + 1U;
+    return (('p' == ext_name[0]) || ('P' == ext_name[0])) && (('n' == ext_name[1]) || ('N' == ext_name[1])) && (('g' == ext_name[2]) || ('G' == ext_name[2]));
+}
+
+extern bool texture_cook_image(worker_pool *encode_worker_pool, void const *source_data, size_t source_size, TEXTURE_COOK_USAGE usage, char const *dds_path, char const *pvr_path)
+{
+    uint32_t width;
+    uint32_t height;
+    mcrt_vector<mcrt_vector<uint8_t>> mips(1U);
+    if (!texture_cook_decode_png(source_data, source_size, &width, &height, mips[0]))
+    {
+        return false;
+    }
+
+    texture_cook_generate_mips(width, height, usage, mips);
+
+    uint32_t const mip_levels = static_cast<uint32_t>(mips.size());
+
+    mcrt_vector<uint8_t> dds_data(sizeof(texture_cook_dds_header));
+    {
+        texture_cook_dds_header dds_header;
+        std::memset(&dds_header, 0, sizeof(texture_cook_dds_header));
+        dds_header.m_magic = dds_magic;
+        dds_header.m_size = 124U;
+        dds_header.m_flags = dds_flags;
+        dds_header.m_height = height;
+        dds_header.m_width = width;
+        dds_header.m_pitch_or_linear_size = ((width + 3U) / 4U) * ((height + 3U) / 4U) * texture_cook_block_size;
+        dds_header.m_mip_map_count = mip_levels;
+        dds_header.m_pixel_format_size = 32U;
+        dds_header.m_pixel_format_flags = dds_pixel_format_flags;
+        dds_header.m_pixel_format_four_cc = dds_four_cc_dx10;
+        dds_header.m_caps = dds_caps;
+        dds_header.m_dxgi_format = (TEXTURE_COOK_USAGE_NORMAL == usage) ? dxgi_format_bc5_unorm : ((TEXTURE_COOK_USAGE_COLOR == usage) ? dxgi_format_bc7_unorm_srgb : dxgi_format_bc7_unorm);
+        dds_header.m_resource_dimension = dds_resource_dimension_texture_2d;
+        dds_header.m_array_size = 1U;
+        std::memcpy(dds_data.data(), &dds_header, sizeof(texture_cook_dds_header));
+    }
+
+    mcrt_vector<uint8_t> pvr_data(sizeof(texture_cook_pvr_header));
+    {
+        texture_cook_pvr_header pvr_header;
+        pvr_header.m_version = pvr_version;
+        pvr_header.m_flags = 0U;
+        pvr_header.m_pixel_format_low = pvr_pixel_format_astc_4x4;
+        pvr_header.m_pixel_format_high = 0U;
+        pvr_header.m_color_space = (TEXTURE_COOK_USAGE_COLOR == usage) ? pvr_color_space_srgb : pvr_color_space_linear;
+        pvr_header.m_channel_type = pvr_channel_type;
+        pvr_header.m_height = height;
+        pvr_header.m_width = width;
+        pvr_header.m_depth = 1U;
+        pvr_header.m_surface_count = 1U;
+        pvr_header.m_face_count = 1U;
+        pvr_header.m_mip_map_count = mip_levels;
+        pvr_header.m_meta_data_size = 0U;
+        std::memcpy(pvr_data.data(), &pvr_header, sizeof(texture_cook_pvr_header));
+    }
+
+    // the blocks of each mip are encoded on the worker threads (one block row of the BC or the ASTC per task)
+    // both the BC and the ASTC are encoded by the same "parallel_for", and the worker threads are NOT created per mip
+    for (uint32_t mip_level = 0U; mip_level < mip_levels; ++mip_level)
+    {
+        uint32_t const mip_width = std::max(1U, width >> mip_level);
+        uint32_t const mip_height = std::max(1U, height >> mip_level);
+        uint32_t const block_row_count = (mip_height + 3U) / 4U;
+        size_t const mip_size = static_cast<size_t>((mip_width + 3U) / 4U) * block_row_count * texture_cook_block_size;
+
+        size_t const dds_mip_offset = dds_data.size();
+        dds_data.resize(dds_mip_offset + mip_size);
+
+        size_t const pvr_mip_offset = pvr_data.size();
+        pvr_data.resize(pvr_mip_offset + mip_size);
+
+        texture_cook_encode_task_data encode_task_datas[2] = {
+            {usage, false, mips[mip_level].data(), mip_width, mip_height, dds_data.data() + dds_mip_offset},
+            {usage, true, mips[mip_level].data(), mip_width, mip_height, pvr_data.data() + pvr_mip_offset}};
+        encode_worker_pool->parallel_for(2U * block_row_count, texture_cook_encode_block_row_task_main, encode_task_datas);
+    }
+
+    return texture_cook_write_file(dds_path, dds_data) && texture_cook_write_file(pvr_path, pvr_data);
+}
+
+extern bool texture_transcode_png_color_image_asset_header_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *out_image_asset_header, size_t *out_image_asset_data_offset)
+{
+    return texture_transcode_png_image_asset_header_from_input_stream(input_stream, true, out_image_asset_header, out_image_asset_data_offset);
+}
+
+extern bool texture_transcode_png_linear_image_asset_header_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *out_image_asset_header, size_t *out_image_asset_data_offset)
+{
+    return texture_transcode_png_image_asset_header_from_input_stream(input_stream, false, out_image_asset_header, out_image_asset_data_offset);
+}
+
+extern bool texture_transcode_png_image_asset_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests)
+{
+    assert(IMPORT_ASSET_IMAGE_TYPE_2D == image_asset_header->type);
+    assert(1U == image_asset_header->depth);
+    assert(1U == image_asset_header->array_layers);
+    assert(!image_asset_header->is_cube_map);
+
+    int64_t input_stream_size = -1;
+    if ((0 != input_stream->stat_size(&input_stream_size)) || (input_stream_size <= static_cast<int64_t>(image_asset_data_offset)))
+    {
+        return false;
+    }
+
+    if (static_cast<int64_t>(image_asset_data_offset) != input_stream->seek(static_cast<int64_t>(image_asset_data_offset), SEEK_SET))
+    {
+        return false;
+    }
+
+    mcrt_vector<uint8_t> source_data(static_cast<size_t>(input_stream_size - static_cast<int64_t>(image_asset_data_offset)));
+    for (size_t read_size = 0U; read_size < source_data.size();)
+    {
+        intptr_t const result_read = input_stream->read(source_data.data() + read_size, source_data.size() - read_size);
+        if (result_read <= 0)
+        {
+            return false;
+        }
+        read_size += static_cast<size_t>(result_read);
+    }
+
+    uint32_t width;
+    uint32_t height;
+    mcrt_vector<mcrt_vector<uint8_t>> mips(1U);
+    if (!texture_cook_decode_png(source_data.data(), source_data.size(), &width, &height, mips[0]))
+    {
+        return false;
+    }
+
+    // the most detailed mips may have been dropped from the header (by the memory budget), and the mip "i" of the header is the mip "i + skipped mip level count" of the PNG
+    uint32_t const mip_levels = texture_cook_calculate_mip_levels(width, height);
+    if (image_asset_header->mip_levels > mip_levels)
+    {
+        return false;
+    }
+
+    uint32_t const skipped_mip_level_count = mip_levels - image_asset_header->mip_levels;
+    if ((std::max(1U, width >> skipped_mip_level_count) != image_asset_header->width) || (std::max(1U, height >> skipped_mip_level_count) != image_asset_header->height))
+    {
+        return false;
+    }
+
+    // the normal map is filtered as the linear data (without renormalization)
+    texture_cook_generate_mips(width, height, (BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SRGB == image_asset_header->format) ? TEXTURE_COOK_USAGE_COLOR : TEXTURE_COOK_USAGE_LINEAR, mips);
+
+    assert(mip_levels == mips.size());
+    assert(subresource_count <= image_asset_header->mip_levels);
+
+    // the subresource index is the mip level, since there is only one array layer
+    for (uint32_t mip_level = 0U; mip_level < subresource_count; ++mip_level)
+    {
+        BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const &subresource_memcpy_dest = subresource_memcpy_dests[mip_level];
+
+        uint32_t const source_mip_level = skipped_mip_level_count + mip_level;
+
+        uint32_t const mip_width = std::max(1U, width >> source_mip_level);
+        assert((sizeof(uint8_t) * 4U * mip_width) == subresource_memcpy_dest.output_row_size);
+        assert(std::max(1U, height >> source_mip_level) == subresource_memcpy_dest.output_row_count);
+        assert(1U == subresource_memcpy_dest.output_slice_count);
+
+        for (uint32_t output_row_index = 0U; output_row_index < subresource_memcpy_dest.output_row_count; ++output_row_index)
+        {
+            void *const destination = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + (subresource_memcpy_dest.staging_upload_buffer_offset + subresource_memcpy_dest.output_row_pitch * output_row_index));
+
+            std::memcpy(destination, mips[source_mip_level].data() + static_cast<size_t>(4U) * mip_width * output_row_index, subresource_memcpy_dest.output_row_size);
+        }
+    }
+
+    return true;
+}
+
+static inline bool texture_transcode_png_image_asset_header_from_input_stream(import_asset_input_stream *input_stream, bool srgb, IMPORT_ASSET_IMAGE_HEADER *out_image_asset_header, size_t *out_image_asset_data_offset)
+{
+    // the signature and the IHDR chunk (which should be the first chunk)
+    uint8_t png_header[33];
+
+    if (0 != input_stream->seek(0, SEEK_SET))
+    {
+        return false;
+    }
+
+    for (size_t read_size = 0U; read_size < sizeof(png_header);)
+    {
+        intptr_t const result_read = input_stream->read(png_header + read_size, sizeof(png_header) - read_size);
+        if (result_read <= 0)
+        {
+            return false;
+        }
+        read_size += static_cast<size_t>(result_read);
+    }
+
+    constexpr uint8_t const png_signature[8] = {0X89U, 0X50U, 0X4EU, 0X47U, 0X0DU, 0X0AU, 0X1AU, 0X0AU};
+    if ((0 != std::memcmp(png_header, png_signature, sizeof(png_signature))) || (0 != std::memcmp(png_header + 12U, "IHDR", 4U)))
+    {
+        return false;
+    }
+
+    uint32_t const width = (static_cast<uint32_t>(png_header[16]) << 24U) | (static_cast<uint32_t>(png_header[17]) << 16U) | (static_cast<uint32_t>(png_header[18]) << 8U) | static_cast<uint32_t>(png_header[19]);
+    uint32_t const height = (static_cast<uint32_t>(png_header[20]) << 24U) | (static_cast<uint32_t>(png_header[21]) << 16U) | (static_cast<uint32_t>(png_header[22]) << 8U) | static_cast<uint32_t>(png_header[23]);
+    if ((0U == width) || (0U == height) || (width > TEXTURE_COOK_MAX_IMAGE_DIMENSION) || (height > TEXTURE_COOK_MAX_IMAGE_DIMENSION))
+    {
+        return false;
+    }
+
+    std::memset(out_image_asset_header, 0, sizeof(IMPORT_ASSET_IMAGE_HEADER));
+    out_image_asset_header->is_cube_map = false;
+    out_image_asset_header->type = IMPORT_ASSET_IMAGE_TYPE_2D;
+    out_image_asset_header->format = srgb ? BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SRGB : BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_UNORM;
+    out_image_asset_header->width = width;
+    out_image_asset_header->height = height;
+    out_image_asset_header->depth = 1U;
+    out_image_asset_header->mip_levels = texture_cook_calculate_mip_levels(width, height);
+    out_image_asset_header->array_layers = 1U;
+
+    // the whole file is decoded by the data function
+    (*out_image_asset_data_offset) = 0U;
+
+    return true;
+}
+
+static inline uint32_t texture_cook_calculate_mip_levels(uint32_t width, uint32_t height)
+{
+    uint32_t mip_levels = 1U;
+    for (uint32_t size = std::max(width, height); size > 1U; size >>= 1U)
+    {
+        ++mip_levels;
+    }
+    return mip_levels;
+}
+
+static bool texture_cook_decode_png(void const *data, size_t size, uint32_t *out_width, uint32_t *out_height, mcrt_vector<uint8_t> &out_pixels)
+{
+    uint8_t const *const bytes = static_cast<uint8_t const *>(data);
+
+    constexpr uint8_t const png_signature[8] = {0X89U, 0X50U, 0X4EU, 0X47U, 0X0DU, 0X0AU, 0X1AU, 0X0AU};
+    if ((size < sizeof(png_signature)) || (0 != std::memcmp(bytes, png_signature, sizeof(png_signature))))
+    {
+        return false;
+    }
+
+    uint32_t width = 0U;
+    uint32_t height = 0U;
+    uint32_t bit_depth = 0U;
+    uint32_t color_type = 0U;
+    uint32_t interlace_method = 0U;
+    bool header_found = false;
+    bool end_found = false;
+
+    uint8_t palette[256][4];
+    uint32_t palette_size = 0U;
+    for (uint32_t palette_index = 0U; palette_index < 256U; ++palette_index)
+    {
+        palette[palette_index][0] = 0U;
+        palette[palette_index][1] = 0U;
+        palette[palette_index][2] = 0U;
+        palette[palette_index][3] = 255U;
+    }
+
+    // the data of all IDAT chunks is a single zlib stream
+    mcrt_vector<uint8_t> compressed_data;
+
+    for (size_t position = sizeof(png_signature); (!end_found) && ((position + 12U) <= size);)
+    {
+        uint32_t const chunk_length = (static_cast<uint32_t>(bytes[position]) << 24U) | (static_cast<uint32_t>(bytes[position + 1U]) << 16U) | (static_cast<uint32_t>(bytes[position + 2U]) << 8U) | static_cast<uint32_t>(bytes[position + 3U]);
+        uint8_t const *const chunk_type = bytes + position + 4U;
+        uint8_t const *const chunk_data = bytes + position + 8U;
+
+        if (chunk_length > (size - position - 12U))
+        {
+            return false;
+        }
+
+        if (0 == std::memcmp(chunk_type, "IHDR", 4U))
+        {
+            if (chunk_length < 13U)
+            {
+                return false;
+            }
+
+            width = (static_cast<uint32_t>(chunk_data[0]) << 24U) | (static_cast<uint32_t>(chunk_data[1]) << 16U) | (static_cast<uint32_t>(chunk_data[2]) << 8U) | static_cast<uint32_t>(chunk_data[3]);
+            height = (static_cast<uint32_t>(chunk_data[4]) << 24U) | (static_cast<uint32_t>(chunk_data[5]) << 16U) | (static_cast<uint32_t>(chunk_data[6]) << 8U) | static_cast<uint32_t>(chunk_data[7]);
+            bit_depth = chunk_data[8];
+            color_type = chunk_data[9];
+            interlace_method = chunk_data[12];
+
+            // only the deflate compression and the adaptive filtering are defined
+            if ((0U != chunk_data[10]) || (0U != chunk_data[11]))
+            {
+                return false;
+            }
+
+            // the sizes of the rows are calculated from the width and the height, which can overflow the 32-bit "size_t" (e.g. armv7) when they are NOT limited
+            if ((width > TEXTURE_COOK_MAX_IMAGE_DIMENSION) || (height > TEXTURE_COOK_MAX_IMAGE_DIMENSION))
+            {
+                return false;
+            }
+
+            header_found = true;
+        }
+        else if (0 == std::memcmp(chunk_type, "PLTE", 4U))
+        {
+            palette_size = std::min(256U, chunk_length / 3U);
+            for (uint32_t palette_index = 0U; palette_index < palette_size; ++palette_index)
+            {
+                palette[palette_index][0] = chunk_data[3U * palette_index];
+                palette[palette_index][1] = chunk_data[3U * palette_index + 1U];
+                palette[palette_index][2] = chunk_data[3U * palette_index + 2U];
+            }
+        }
+        else if (0 == std::memcmp(chunk_type, "tRNS", 4U))
+        {
+            // the transparent color key of the grayscale and the truecolor images is ignored
+            if (3U == color_type)
+            {
+                for (uint32_t palette_index = 0U; palette_index < std::min(256U, chunk_length); ++palette_index)
+                {
+                    palette[palette_index][3] = chunk_data[palette_index];
+                }
+            }
+        }
+        else if (0 == std::memcmp(chunk_type, "IDAT", 4U))
+        {
+            compressed_data.insert(compressed_data.end(), chunk_data, chunk_data + chunk_length);
+        }
+        else if (0 == std::memcmp(chunk_type, "IEND", 4U))
+        {
+            end_found = true;
+        }
+
+        position += (12U + static_cast<size_t>(chunk_length));
+    }
+
+    // the Adam7 interlacing is NOT supported
+    if ((!header_found) || (0U == width) || (0U == height) || (0U != interlace_method))
+    {
+        return false;
+    }
+
+    uint32_t channel_count;
+    bool bit_depth_supported;
+    switch (color_type)
+    {
+    case 0U:
+        channel_count = 1U;
+        bit_depth_supported = (1U == bit_depth) || (2U == bit_depth) || (4U == bit_depth) || (8U == bit_depth) || (16U == bit_depth);
+        break;
+    case 2U:
+        channel_count = 3U;
+        bit_depth_supported = (8U == bit_depth) || (16U == bit_depth);
+        break;
+    case 3U:
+        channel_count = 1U;
+        bit_depth_supported = (1U == bit_depth) || (2U == bit_depth) || (4U == bit_depth) || (8U == bit_depth);
+        break;
+    case 4U:
+        channel_count = 2U;
+        bit_depth_supported = (8U == bit_depth) || (16U == bit_depth);
+        break;
+    case 6U:
+        channel_count = 4U;
+        bit_depth_supported = (8U == bit_depth) || (16U == bit_depth);
+        break;
+    default:
+        channel_count = 0U;
+        bit_depth_supported = false;
+    }
+
+    if (!bit_depth_supported)
+    {
+        return false;
+    }
+
+    // zlib header: deflate, no preset dictionary
+    if ((compressed_data.size() < 2U) || (8U != (compressed_data[0] & 0XFU)) || (0U != (((static_cast<uint32_t>(compressed_data[0]) << 8U) | static_cast<uint32_t>(compressed_data[1])) % 31U)) || (0U != (compressed_data[1] & 0X20U)))
+    {
+        return false;
+    }
+
+    // at most 16384 * 4 * 16 / 8 = 128 KB per row, and (128 KB + 1) * 16384 is less than 4 GB
+    static_assert((((static_cast<uint64_t>(TEXTURE_COOK_MAX_IMAGE_DIMENSION) * 4U * 16U + 7U) / 8U + 1U) * TEXTURE_COOK_MAX_IMAGE_DIMENSION) < static_cast<uint64_t>(UINT32_MAX), "");
+    assert((width <= TEXTURE_COOK_MAX_IMAGE_DIMENSION) && (height <= TEXTURE_COOK_MAX_IMAGE_DIMENSION));
+    size_t const row_size = (static_cast<size_t>(width) * channel_count * bit_depth + 7U) / 8U;
+
+    mcrt_vector<uint8_t> filtered_rows;
+    filtered_rows.reserve((row_size + 1U) * height);
+    if ((!texture_cook_inflate(compressed_data.data() + 2U, compressed_data.size() - 2U, filtered_rows)) || (filtered_rows.size() < ((row_size + 1U) * height)))
+    {
+        return false;
+    }
+
+    // the filters operate on the bytes, and the bytes of the previous pixel are used (or the previous byte when the pixel is smaller than one byte)
+    size_t const filter_stride = std::max(static_cast<size_t>(1U), static_cast<size_t>(channel_count * bit_depth / 8U));
+
+    mcrt_vector<uint8_t> rows(row_size * height);
+    for (uint32_t y = 0U; y < height; ++y)
+    {
+        uint32_t const filter_type = filtered_rows[(row_size + 1U) * y];
+        uint8_t const *const source_row = filtered_rows.data() + (row_size + 1U) * y + 1U;
+        uint8_t *const row = rows.data() + row_size * y;
+        uint8_t const *const previous_row = (y > 0U) ? (rows.data() + row_size * (y - 1U)) : NULL;
+
+        for (size_t i = 0U; i < row_size; ++i)
+        {
+            int32_t const a = (i >= filter_stride) ? row[i - filter_stride] : 0;
+            int32_t const b = (NULL != previous_row) ? previous_row[i] : 0;
+            int32_t const c = ((NULL != previous_row) && (i >= filter_stride)) ? previous_row[i - filter_stride] : 0;
+
+            int32_t predictor;
+            switch (filter_type)
+            {
+            case 0U:
+                predictor = 0;
+                break;
+            case 1U:
+                predictor = a;
+                break;
+            case 2U:
+                predictor = b;
+                break;
+            case 3U:
+                predictor = (a + b) >> 1;
+                break;
+            case 4U:
+            {
+                // Paeth
+                int32_t const p = a + b - c;
+                int32_t const p_a = std::abs(p - a);
+                int32_t const p_b = std::abs(p - b);
+                int32_t const p_c = std::abs(p - c);
+                predictor = ((p_a <= p_b) && (p_a <= p_c)) ? a : ((p_b <= p_c) ? b : c);
+            }
+            break;
+            default:
+                return false;
+            }
+
+            row[i] = static_cast<uint8_t>(static_cast<int32_t>(source_row[i]) + predictor);
+        }
+    }
+
+    out_pixels.resize(static_cast<size_t>(4U) * width * height);
+
+    for (uint32_t y = 0U; y < height; ++y)
+    {
+        uint8_t const *const row = rows.data() + row_size * y;
+
+        for (uint32_t x = 0U; x < width; ++x)
+        {
+            // the most significant byte is used when the bit depth is 16
+            uint32_t samples[4];
+            if (bit_depth < 8U)
+            {
+                uint32_t const bit_position = x * bit_depth;
+                samples[0] = (row[bit_position / 8U] >> (8U - bit_depth - (bit_position % 8U))) & ((1U << bit_depth) - 1U);
+            }
+            else
+            {
+                uint32_t const bytes_per_sample = bit_depth / 8U;
+                for (uint32_t channel_index = 0U; channel_index < channel_count; ++channel_index)
+                {
+                    samples[channel_index] = row[(static_cast<size_t>(x) * channel_count + channel_index) * bytes_per_sample];
+                }
+            }
+
+            uint8_t *const pixel = out_pixels.data() + (static_cast<size_t>(width) * y + x) * 4U;
+            switch (color_type)
+            {
+            case 0U:
+            {
+                uint8_t const gray = static_cast<uint8_t>((bit_depth < 8U) ? ((samples[0] * 255U) / ((1U << bit_depth) - 1U)) : samples[0]);
+                pixel[0] = gray;
+                pixel[1] = gray;
+                pixel[2] = gray;
+                pixel[3] = 255U;
+            }
+            break;
+            case 2U:
+            {
+                pixel[0] = static_cast<uint8_t>(samples[0]);
+                pixel[1] = static_cast<uint8_t>(samples[1]);
+                pixel[2] = static_cast<uint8_t>(samples[2]);
+                pixel[3] = 255U;
+            }
+            break;
+            case 3U:
+            {
+                if (samples[0] >= palette_size)
+                {
+                    return false;
+                }
+                pixel[0] = palette[samples[0]][0];
+                pixel[1] = palette[samples[0]][1];
+                pixel[2] = palette[samples[0]][2];
+                pixel[3] = palette[samples[0]][3];
+            }
+            break;
+            case 4U:
+            {
+                pixel[0] = static_cast<uint8_t>(samples[0]);
+                pixel[1] = static_cast<uint8_t>(samples[0]);
+                pixel[2] = static_cast<uint8_t>(samples[0]);
+                pixel[3] = static_cast<uint8_t>(samples[1]);
+            }
+            break;
+            default:
+            {
+                assert(6U == color_type);
+                pixel[0] = static_cast<uint8_t>(samples[0]);
+                pixel[1] = static_cast<uint8_t>(samples[1]);
+                pixel[2] = static_cast<uint8_t>(samples[2]);
+                pixel[3] = static_cast<uint8_t>(samples[3]);
+            }
+            }
+        }
+    }
+
+    (*out_width) = width;
+    (*out_height) = height;
+    return true;
+}
+
+static bool texture_cook_inflate(uint8_t const *input, size_t input_size, mcrt_vector<uint8_t> &output)
+{
+    texture_cook_inflate_state state;
+    state.m_input = input;
+    state.m_input_size = input_size;
+    state.m_input_position = 0U;
+    state.m_bit_buffer = 0U;
+    state.m_bit_count = 0U;
+    state.m_output = &output;
+
+    uint32_t final_block;
+    do
+    {
+        uint32_t block_type;
+        if ((!texture_cook_inflate_bits(&state, 1U, &final_block)) || (!texture_cook_inflate_bits(&state, 2U, &block_type)))
+        {
+            return false;
+        }
+
+        if (0U == block_type)
+        {
+            // stored: the remaining bits of the current byte are discarded
+            state.m_bit_buffer = 0U;
+            state.m_bit_count = 0U;
+
+            if ((state.m_input_position + 4U) > state.m_input_size)
+            {
+                return false;
+            }
+
+            uint32_t const length = static_cast<uint32_t>(input[state.m_input_position]) | (static_cast<uint32_t>(input[state.m_input_position + 1U]) << 8U);
+            uint32_t const length_complement = static_cast<uint32_t>(input[state.m_input_position + 2U]) | (static_cast<uint32_t>(input[state.m_input_position + 3U]) << 8U);
+            state.m_input_position += 4U;
+
+            if ((length != ((~length_complement) & 0XFFFFU)) || ((state.m_input_position + length) > state.m_input_size))
+            {
+                return false;
+            }
+
+            output.insert(output.end(), input + state.m_input_position, input + state.m_input_position + length);
+            state.m_input_position += length;
+        }
+        else if (1U == block_type)
+        {
+            // fixed Huffman codes
+            uint8_t lengths[288 + 30];
+            for (uint32_t symbol = 0U; symbol < 144U; ++symbol)
+            {
+                lengths[symbol] = 8U;
+            }
+            for (uint32_t symbol = 144U; symbol < 256U; ++symbol)
+            {
+                lengths[symbol] = 9U;
+            }
+            for (uint32_t symbol = 256U; symbol < 280U; ++symbol)
+            {
+                lengths[symbol] = 7U;
+            }
+            for (uint32_t symbol = 280U; symbol < 288U; ++symbol)
+            {
+                lengths[symbol] = 8U;
+            }
+            for (uint32_t symbol = 0U; symbol < 30U; ++symbol)
+            {
+                lengths[288U + symbol] = 5U;
+            }
+
+            texture_cook_huffman_table length_table;
+            texture_cook_huffman_table distance_table;
+            bool const res_length_table = texture_cook_huffman_table_build(&length_table, lengths, 288U);
+            assert(res_length_table);
+            bool const res_distance_table = texture_cook_huffman_table_build(&distance_table, lengths + 288U, 30U);
+            assert(res_distance_table);
+
+            if (!texture_cook_inflate_codes(&state, &length_table, &distance_table))
+            {
+                return false;
+            }
+        }
+        else if (2U == block_type)
+        {
+            // dynamic Huffman codes
+            uint32_t length_count;
+            uint32_t distance_count;
+            uint32_t code_length_count;
+            if ((!texture_cook_inflate_bits(&state, 5U, &length_count)) || (!texture_cook_inflate_bits(&state, 5U, &distance_count)) || (!texture_cook_inflate_bits(&state, 4U, &code_length_count)))
+            {
+                return false;
+            }
+            length_count += 257U;
+            distance_count += 1U;
+            code_length_count += 4U;
+
+            if ((length_count > 286U) || (distance_count > 30U))
+            {
+                return false;
+            }
+
+            constexpr uint8_t const code_length_order[19] = {16U, 17U, 18U, 0U, 8U, 7U, 9U, 6U, 10U, 5U, 11U, 4U, 12U, 3U, 13U, 2U, 14U, 1U, 15U};
+
+            uint8_t code_length_lengths[19] = {};
+            for (uint32_t code_length_index = 0U; code_length_index < code_length_count; ++code_length_index)
+            {
+                uint32_t code_length_length;
+                if (!texture_cook_inflate_bits(&state, 3U, &code_length_length))
+                {
+                    return false;
+                }
+                code_length_lengths[code_length_order[code_length_index]] = static_cast<uint8_t>(code_length_length);
+            }
+
+            texture_cook_huffman_table code_length_table;
+            if (!texture_cook_huffman_table_build(&code_length_table, code_length_lengths, 19U))
+            {
+                return false;
+            }
+
+            uint8_t lengths[286 + 30];
+            for (uint32_t length_index = 0U; length_index < (length_count + distance_count);)
+            {
+                uint32_t symbol;
+                if (!texture_cook_huffman_decode(&state, &code_length_table, &symbol))
+                {
+                    return false;
+                }
+
+                if (symbol < 16U)
+                {
+                    lengths[length_index] = static_cast<uint8_t>(symbol);
+                    ++length_index;
+                }
+                else
+                {
+                    uint8_t repeated_length;
+                    uint32_t repeat_count;
+                    if (16U == symbol)
+                    {
+                        if ((0U == length_index) || (!texture_cook_inflate_bits(&state, 2U, &repeat_count)))
+                        {
+                            return false;
+                        }
+                        repeated_length = lengths[length_index - 1U];
+                        repeat_count += 3U;
+                    }
+                    else if (17U == symbol)
+                    {
+                        if (!texture_cook_inflate_bits(&state, 3U, &repeat_count))
+                        {
+                            return false;
+                        }
+                        repeated_length = 0U;
+                        repeat_count += 3U;
+                    }
+                    else
+                    {
+                        if (!texture_cook_inflate_bits(&state, 7U, &repeat_count))
+                        {
+                            return false;
+                        }
+                        repeated_length = 0U;
+                        repeat_count += 11U;
+                    }
+
+                    if ((length_index + repeat_count) > (length_count + distance_count))
+                    {
+                        return false;
+                    }
+
+                    for (uint32_t repeat_index = 0U; repeat_index < repeat_count; ++repeat_index)
+                    {
+                        lengths[length_index] = repeated_length;
+                        ++length_index;
+                    }
+                }
+            }
+
+            // the end of block code is required
+            if (0U == lengths[256])
+            {
+                return false;
+            }
+
+            texture_cook_huffman_table length_table;
+            texture_cook_huffman_table distance_table;
+            if ((!texture_cook_huffman_table_build(&length_table, lengths, length_count)) || (!texture_cook_huffman_table_build(&distance_table, lengths + length_count, distance_count)))
+            {
+                return false;
+            }
+
+            if (!texture_cook_inflate_codes(&state, &length_table, &distance_table))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    } while (0U == final_block);
+
+    return true;
+}
+
+static inline bool texture_cook_inflate_bits(texture_cook_inflate_state *state, uint32_t bit_count, uint32_t *out_value)
+{
+    assert(bit_count <= 16U);
+
+    while (state->m_bit_count < bit_count)
+    {
+        if (state->m_input_position >= state->m_input_size)
+        {
+            return false;
+        }
+
+        state->m_bit_buffer |= (static_cast<uint32_t>(state->m_input[state->m_input_position]) << state->m_bit_count);
+        ++state->m_input_position;
+        state->m_bit_count += 8U;
+    }
+
+    (*out_value) = state->m_bit_buffer & ((1U << bit_count) - 1U);
+    state->m_bit_buffer >>= bit_count;
+    state->m_bit_count -= bit_count;
+    return true;
+}
+
+static inline bool texture_cook_huffman_table_build(texture_cook_huffman_table *table, uint8_t const *lengths, uint32_t symbol_count)
+{
+    assert(symbol_count <= 288U);
+
+    for (uint32_t length = 0U; length < 16U; ++length)
+    {
+        table->m_counts[length] = 0U;
+    }
+
+    for (uint32_t symbol = 0U; symbol < symbol_count; ++symbol)
+    {
+        assert(lengths[symbol] < 16U);
+        ++table->m_counts[lengths[symbol]];
+    }
+
+    // the over-subscribed code is invalid (the incomplete code is allowed)
+    int32_t left = 1;
+    for (uint32_t length = 1U; length < 16U; ++length)
+    {
+        left <<= 1;
+        left -= table->m_counts[length];
+        if (left < 0)
+        {
+            return false;
+        }
+    }
+
+    uint16_t offsets[16];
+    offsets[1] = 0U;
+    for (uint32_t length = 1U; length < 15U; ++length)
+    {
+        offsets[length + 1U] = offsets[length] + table->m_counts[length];
+    }
+
+    for (uint32_t symbol = 0U; symbol < symbol_count; ++symbol)
+    {
+        if (0U != lengths[symbol])
+        {
+            table->m_symbols[offsets[lengths[symbol]]] = static_cast<uint16_t>(symbol);
+            ++offsets[lengths[symbol]];
+        }
+    }
+
+    return true;
+}
+
+static inline bool texture_cook_huffman_decode(texture_cook_inflate_state *state, texture_cook_huffman_table const *table, uint32_t *out_symbol)
+{
+    // the codes of the same length are consecutive, and "first" is the first code of the current length
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    for (uint32_t length = 1U; length < 16U; ++length)
+    {
+        uint32_t bit;
+        if (!texture_cook_inflate_bits(state, 1U, &bit))
+        {
+            return false;
+        }
+        code |= static_cast<int32_t>(bit);
+
+        int32_t const count = table->m_counts[length];
+        if ((code - count) < first)
+        {
+            (*out_symbol) = table->m_symbols[index + (code - first)];
+            return true;
+        }
+
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    return false;
+}
+
+static bool texture_cook_inflate_codes(texture_cook_inflate_state *state, texture_cook_huffman_table const *length_table, texture_cook_huffman_table const *distance_table)
+{
+    constexpr uint16_t const length_bases[29] = {3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U, 13U, 15U, 17U, 19U, 23U, 27U, 31U, 35U, 43U, 51U, 59U, 67U, 83U, 99U, 115U, 131U, 163U, 195U, 227U, 258U};
+    constexpr uint8_t const length_extra_bits[29] = {0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U, 1U, 1U, 1U, 2U, 2U, 2U, 2U, 3U, 3U, 3U, 3U, 4U, 4U, 4U, 4U, 5U, 5U, 5U, 5U, 0U};
+    constexpr uint16_t const distance_bases[30] = {1U, 2U, 3U, 4U, 5U, 7U, 9U, 13U, 17U, 25U, 33U, 49U, 65U, 97U, 129U, 193U, 257U, 385U, 513U, 769U, 1025U, 1537U, 2049U, 3073U, 4097U, 6145U, 8193U, 12289U, 16385U, 24577U};
+    constexpr uint8_t const distance_extra_bits[30] = {0U, 0U, 0U, 0U, 1U, 1U, 2U, 2U, 3U, 3U, 4U, 4U, 5U, 5U, 6U, 6U, 7U, 7U, 8U, 8U, 9U, 9U, 10U, 10U, 11U, 11U, 12U, 12U, 13U, 13U};
+
+    mcrt_vector<uint8_t> &output = (*state->m_output);
+
+    for (;;)
+    {
+        uint32_t symbol;
+        if (!texture_cook_huffman_decode(state, length_table, &symbol))
+        {
+            return false;
+        }
+
+        if (symbol < 256U)
+        {
+            output.push_back(static_cast<uint8_t>(symbol));
+        }
+        else if (256U == symbol)
+        {
+            return true;
+        }
+        else
+        {
+            symbol -= 257U;
+            if (symbol >= 29U)
+            {
+                return false;
+            }
+
+            uint32_t length_extra;
+            if (!texture_cook_inflate_bits(state, length_extra_bits[symbol], &length_extra))
+            {
+                return false;
+            }
+            uint32_t const length = length_bases[symbol] + length_extra;
+
+            uint32_t distance_symbol;
+            if ((!texture_cook_huffman_decode(state, distance_table, &distance_symbol)) || (distance_symbol >= 30U))
+            {
+                return false;
+            }
+
+            uint32_t distance_extra;
+            if (!texture_cook_inflate_bits(state, distance_extra_bits[distance_symbol], &distance_extra))
+            {
+                return false;
+            }
+            uint32_t const distance = distance_bases[distance_symbol] + distance_extra;
+
+            if (distance > output.size())
+            {
+                return false;
+            }
+
+            // the source may overlap the destination
+            size_t const copy_position = output.size() - distance;
+            for (uint32_t copy_index = 0U; copy_index < length; ++copy_index)
+            {
+                uint8_t const value = output[copy_position + copy_index];
+                output.push_back(value);
+            }
+        }
+    }
+}
+
+static void texture_cook_generate_mips(uint32_t width, uint32_t height, TEXTURE_COOK_USAGE usage, mcrt_vector<mcrt_vector<uint8_t>> &inout_mips)
+{
+    assert(1U == inout_mips.size());
+
+    uint32_t const mip_levels = texture_cook_calculate_mip_levels(width, height);
+    inout_mips.resize(mip_levels);
+
+    // the 2x2 box filter (the last row or column is duplicated when the size is odd)
+    // the color is filtered in the linear space, and the normal is renormalized
+    for (uint32_t mip_level = 1U; mip_level < mip_levels; ++mip_level)
+    {
+        uint32_t const source_width = std::max(1U, width >> (mip_level - 1U));
+        uint32_t const source_height = std::max(1U, height >> (mip_level - 1U));
+        uint32_t const destination_width = std::max(1U, width >> mip_level);
+        uint32_t const destination_height = std::max(1U, height >> mip_level);
+
+        uint8_t const *const source_pixels = inout_mips[mip_level - 1U].data();
+
+        mcrt_vector<uint8_t> &destination_pixels = inout_mips[mip_level];
+        destination_pixels.resize(static_cast<size_t>(4U) * destination_width * destination_height);
+
+        for (uint32_t destination_y = 0U; destination_y < destination_height; ++destination_y)
+        {
+            for (uint32_t destination_x = 0U; destination_x < destination_width; ++destination_x)
+            {
+                float sum[4] = {0.0F, 0.0F, 0.0F, 0.0F};
+
+                for (uint32_t sample_index = 0U; sample_index < 4U; ++sample_index)
+                {
+                    uint32_t const source_x = std::min(destination_x * 2U + (sample_index & 1U), source_width - 1U);
+                    uint32_t const source_y = std::min(destination_y * 2U + (sample_index >> 1U), source_height - 1U);
+                    uint8_t const *const source_pixel = source_pixels + (static_cast<size_t>(source_width) * source_y + source_x) * 4U;
+
+                    for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+                    {
+                        float value = static_cast<float>(source_pixel[channel_index]) / 255.0F;
+
+                        if ((TEXTURE_COOK_USAGE_COLOR == usage) && (channel_index < 3U))
+                        {
+                            value = (value <= 0.04045F) ? (value / 12.92F) : std::pow((value + 0.055F) / 1.055F, 2.4F);
+                        }
+                        else if ((TEXTURE_COOK_USAGE_NORMAL == usage) && (channel_index < 3U))
+                        {
+                            value = value * 2.0F - 1.0F;
+                        }
+
+                        sum[channel_index] += value;
+                    }
+                }
+
+                float average[4] = {sum[0] * 0.25F, sum[1] * 0.25F, sum[2] * 0.25F, sum[3] * 0.25F};
+
+                if (TEXTURE_COOK_USAGE_COLOR == usage)
+                {
+                    for (uint32_t channel_index = 0U; channel_index < 3U; ++channel_index)
+                    {
+                        average[channel_index] = (average[channel_index] <= 0.0031308F) ? (average[channel_index] * 12.92F) : (1.055F * std::pow(average[channel_index], 1.0F / 2.4F) - 0.055F);
+                    }
+                }
+                else if (TEXTURE_COOK_USAGE_NORMAL == usage)
+                {
+                    float const length = std::sqrt(average[0] * average[0] + average[1] * average[1] + average[2] * average[2]);
+                    for (uint32_t channel_index = 0U; channel_index < 3U; ++channel_index)
+                    {
+                        average[channel_index] = ((length > 1E-6F) ? (average[channel_index] / length) : ((2U == channel_index) ? 1.0F : 0.0F)) * 0.5F + 0.5F;
+                    }
+                }
+
+                uint8_t *const destination_pixel = destination_pixels.data() + (static_cast<size_t>(destination_width) * destination_y + destination_x) * 4U;
+                for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+                {
+                    destination_pixel[channel_index] = static_cast<uint8_t>(std::min(std::max(std::lround(average[channel_index] * 255.0F), 0L), 255L));
+                }
+            }
+        }
+    }
+}
+
+static void texture_cook_encode_block_row_task_main(uint32_t task_index, void *user_data)
+{
+    // the block rows of the BC are followed by the block rows of the ASTC
+    texture_cook_encode_task_data const *const encode_task_datas = static_cast<texture_cook_encode_task_data const *>(user_data);
+    uint32_t const block_row_count = (encode_task_datas[0].m_height + 3U) / 4U;
+    texture_cook_encode_task_data const *const task_data = encode_task_datas + (task_index / block_row_count);
+    uint32_t const block_row_index = task_index % block_row_count;
+
+    uint32_t const block_column_count = (task_data->m_width + 3U) / 4U;
+
+    for (uint32_t block_column_index = 0U; block_column_index < block_column_count; ++block_column_index)
+    {
+        // the edge texels are duplicated when the size is NOT a multiple of 4
+        uint8_t texels[16][4];
+        for (uint32_t texel_y = 0U; texel_y < 4U; ++texel_y)
+        {
+            for (uint32_t texel_x = 0U; texel_x < 4U; ++texel_x)
+            {
+                uint32_t const x = std::min(block_column_index * 4U + texel_x, task_data->m_width - 1U);
+                uint32_t const y = std::min(block_row_index * 4U + texel_y, task_data->m_height - 1U);
+                std::memcpy(texels[4U * texel_y + texel_x], task_data->m_pixels + (static_cast<size_t>(task_data->m_width) * y + x) * 4U, 4U);
+            }
+        }
+
+        uint8_t *const block = task_data->m_blocks + (static_cast<size_t>(block_column_count) * block_row_index + block_column_index) * texture_cook_block_size;
+
+        if (task_data->m_astc)
+        {
+            texture_cook_encode_astc_4x4_block(texels, block);
+        }
+        else if (TEXTURE_COOK_USAGE_NORMAL == task_data->m_usage)
+        {
+            // BC5: the X and Y are stored as two BC4 blocks
+            texture_cook_encode_bc4_block(texels, 0U, block);
+            texture_cook_encode_bc4_block(texels, 1U, block + 8U);
+        }
+        else
+        {
+            texture_cook_encode_bc7_block(texels, block);
+        }
+    }
+}
+
+static inline void texture_cook_encode_bc7_block(uint8_t const (*texels)[4], uint8_t *out_block)
+{
+    // mode 6: single subset, RGBA 7777 endpoints with the unique P-bits, 4-bit indices
+    float endpoint_0[4];
+    float endpoint_1[4];
+    texture_cook_fit_endpoints(texels, endpoint_0, endpoint_1);
+
+    uint32_t quantized_endpoint_0[4];
+    uint32_t quantized_endpoint_1[4];
+    uint32_t p_bit_0 = 0U;
+    uint32_t p_bit_1 = 0U;
+    texture_cook_quantize_bc7_endpoint(endpoint_0, quantized_endpoint_0, &p_bit_0);
+    texture_cook_quantize_bc7_endpoint(endpoint_1, quantized_endpoint_1, &p_bit_1);
+
+    uint32_t indices[16];
+    uint32_t error;
+    {
+        uint32_t const unquantized_endpoint_0[4] = {(quantized_endpoint_0[0] << 1U) | p_bit_0, (quantized_endpoint_0[1] << 1U) | p_bit_0, (quantized_endpoint_0[2] << 1U) | p_bit_0, (quantized_endpoint_0[3] << 1U) | p_bit_0};
+        uint32_t const unquantized_endpoint_1[4] = {(quantized_endpoint_1[0] << 1U) | p_bit_1, (quantized_endpoint_1[1] << 1U) | p_bit_1, (quantized_endpoint_1[2] << 1U) | p_bit_1, (quantized_endpoint_1[3] << 1U) | p_bit_1};
+        error = texture_cook_select_indices(texels, unquantized_endpoint_0, unquantized_endpoint_1, bc7_weights, 16U, indices);
+    }
+
+    // the endpoints are refined by the least squares once
+    if (error > 0U)
+    {
+        float refined_endpoint_0[4];
+        float refined_endpoint_1[4];
+        if (texture_cook_refine_endpoints(texels, indices, bc7_weights, refined_endpoint_0, refined_endpoint_1))
+        {
+            uint32_t refined_quantized_endpoint_0[4];
+            uint32_t refined_quantized_endpoint_1[4];
+            uint32_t refined_p_bit_0 = 0U;
+            uint32_t refined_p_bit_1 = 0U;
+            texture_cook_quantize_bc7_endpoint(refined_endpoint_0, refined_quantized_endpoint_0, &refined_p_bit_0);
+            texture_cook_quantize_bc7_endpoint(refined_endpoint_1, refined_quantized_endpoint_1, &refined_p_bit_1);
+
+            uint32_t const unquantized_endpoint_0[4] = {(refined_quantized_endpoint_0[0] << 1U) | refined_p_bit_0, (refined_quantized_endpoint_0[1] << 1U) | refined_p_bit_0, (refined_quantized_endpoint_0[2] << 1U) | refined_p_bit_0, (refined_quantized_endpoint_0[3] << 1U) | refined_p_bit_0};
+            uint32_t const unquantized_endpoint_1[4] = {(refined_quantized_endpoint_1[0] << 1U) | refined_p_bit_1, (refined_quantized_endpoint_1[1] << 1U) | refined_p_bit_1, (refined_quantized_endpoint_1[2] << 1U) | refined_p_bit_1, (refined_quantized_endpoint_1[3] << 1U) | refined_p_bit_1};
+
+            uint32_t refined_indices[16];
+            uint32_t const refined_error = texture_cook_select_indices(texels, unquantized_endpoint_0, unquantized_endpoint_1, bc7_weights, 16U, refined_indices);
+            if (refined_error < error)
+            {
+                std::memcpy(quantized_endpoint_0, refined_quantized_endpoint_0, sizeof(quantized_endpoint_0));
+                std::memcpy(quantized_endpoint_1, refined_quantized_endpoint_1, sizeof(quantized_endpoint_1));
+                p_bit_0 = refined_p_bit_0;
+                p_bit_1 = refined_p_bit_1;
+                std::memcpy(indices, refined_indices, sizeof(indices));
+            }
+        }
+    }
+
+    // the most significant bit of the anchor index (the first texel) is implicitly zero
+    if (0U != (indices[0] & 8U))
+    {
+        for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+        {
+            std::swap(quantized_endpoint_0[channel_index], quantized_endpoint_1[channel_index]);
+        }
+        std::swap(p_bit_0, p_bit_1);
+
+        for (uint32_t texel_index = 0U; texel_index < 16U; ++texel_index)
+        {
+            indices[texel_index] = 15U - indices[texel_index];
+        }
+    }
+
+    std::memset(out_block, 0, texture_cook_block_size);
+    uint32_t bit_position = 0U;
+    texture_cook_write_block_bits(out_block, &bit_position, 1U << 6U, 7U);
+    for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+    {
+        texture_cook_write_block_bits(out_block, &bit_position, quantized_endpoint_0[channel_index], 7U);
+        texture_cook_write_block_bits(out_block, &bit_position, quantized_endpoint_1[channel_index], 7U);
+    }
+    texture_cook_write_block_bits(out_block, &bit_position, p_bit_0, 1U);
+    texture_cook_write_block_bits(out_block, &bit_position, p_bit_1, 1U);
+    texture_cook_write_block_bits(out_block, &bit_position, indices[0], 3U);
+    for (uint32_t texel_index = 1U; texel_index < 16U; ++texel_index)
+    {
+        texture_cook_write_block_bits(out_block, &bit_position, indices[texel_index], 4U);
+    }
+    assert(128U == bit_position);
+}
+
+static inline void texture_cook_encode_bc4_block(uint8_t const (*texels)[4], uint32_t channel_index, uint8_t *out_block)
+{
+    uint32_t value_max = texels[0][channel_index];
+    uint32_t value_min = texels[0][channel_index];
+    for (uint32_t texel_index = 1U; texel_index < 16U; ++texel_index)
+    {
+        value_max = std::max(value_max, static_cast<uint32_t>(texels[texel_index][channel_index]));
+        value_min = std::min(value_min, static_cast<uint32_t>(texels[texel_index][channel_index]));
+    }
+
+    // the 8-value mode is used when "red_0 > red_1" (all indices are zero when the block is uniform)
+    uint32_t palette[8];
+    palette[0] = value_max;
+    palette[1] = value_min;
+    for (uint32_t palette_index = 2U; palette_index < 8U; ++palette_index)
+    {
+        palette[palette_index] = ((8U - palette_index) * value_max + (palette_index - 1U) * value_min + 3U) / 7U;
+    }
+
+    uint64_t packed_indices = 0U;
+    if (value_max > value_min)
+    {
+        for (uint32_t texel_index = 0U; texel_index < 16U; ++texel_index)
+        {
+            int32_t const value = texels[texel_index][channel_index];
+
+            uint32_t best_index = 0U;
+            int32_t best_error = 256;
+            for (uint32_t palette_index = 0U; palette_index < 8U; ++palette_index)
+            {
+                int32_t const error = std::abs(value - static_cast<int32_t>(palette[palette_index]));
+                if (error < best_error)
+                {
+                    best_error = error;
+                    best_index = palette_index;
+                }
+            }
+
+            packed_indices |= (static_cast<uint64_t>(best_index) << (3U * texel_index));
+        }
+    }
+
+    out_block[0] = static_cast<uint8_t>(value_max);
+    out_block[1] = static_cast<uint8_t>(value_min);
+    for (uint32_t byte_index = 0U; byte_index < 6U; ++byte_index)
+    {
+        out_block[2U + byte_index] = static_cast<uint8_t>((packed_indices >> (8U * byte_index)) & 0XFFU);
+    }
+}
+
+static inline void texture_cook_encode_astc_4x4_block(uint8_t const (*texels)[4], uint8_t *out_block)
+{
+    float endpoint_0[4];
+    float endpoint_1[4];
+    texture_cook_fit_endpoints(texels, endpoint_0, endpoint_1);
+
+    uint32_t quantized_endpoint_0[4];
+    uint32_t quantized_endpoint_1[4];
+    for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+    {
+        quantized_endpoint_0[channel_index] = static_cast<uint32_t>(std::min(std::max(std::lround(endpoint_0[channel_index]), 0L), 255L));
+        quantized_endpoint_1[channel_index] = static_cast<uint32_t>(std::min(std::max(std::lround(endpoint_1[channel_index]), 0L), 255L));
+    }
+
+    uint32_t indices[16];
+    uint32_t const error = texture_cook_select_indices(texels, quantized_endpoint_0, quantized_endpoint_1, astc_weights, 4U, indices);
+
+    // the endpoints are refined by the least squares once
+    if (error > 0U)
+    {
+        float refined_endpoint_0[4];
+        float refined_endpoint_1[4];
+        if (texture_cook_refine_endpoints(texels, indices, astc_weights, refined_endpoint_0, refined_endpoint_1))
+        {
+            uint32_t refined_quantized_endpoint_0[4];
+            uint32_t refined_quantized_endpoint_1[4];
+            for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+            {
+                refined_quantized_endpoint_0[channel_index] = static_cast<uint32_t>(std::min(std::max(std::lround(refined_endpoint_0[channel_index]), 0L), 255L));
+                refined_quantized_endpoint_1[channel_index] = static_cast<uint32_t>(std::min(std::max(std::lround(refined_endpoint_1[channel_index]), 0L), 255L));
+            }
+
+            uint32_t refined_indices[16];
+            uint32_t const refined_error = texture_cook_select_indices(texels, refined_quantized_endpoint_0, refined_quantized_endpoint_1, astc_weights, 4U, refined_indices);
+            if (refined_error < error)
+            {
+                std::memcpy(quantized_endpoint_0, refined_quantized_endpoint_0, sizeof(quantized_endpoint_0));
+                std::memcpy(quantized_endpoint_1, refined_quantized_endpoint_1, sizeof(quantized_endpoint_1));
+                std::memcpy(indices, refined_indices, sizeof(indices));
+            }
+        }
+    }
+
+    // the blue contraction is applied by the decoder when the RGB sum of the endpoint 1 is less than that of the endpoint 0
+    if ((quantized_endpoint_1[0] + quantized_endpoint_1[1] + quantized_endpoint_1[2]) < (quantized_endpoint_0[0] + quantized_endpoint_0[1] + quantized_endpoint_0[2]))
+    {
+        for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+        {
+            std::swap(quantized_endpoint_0[channel_index], quantized_endpoint_1[channel_index]);
+        }
+
+        for (uint32_t texel_index = 0U; texel_index < 16U; ++texel_index)
+        {
+            indices[texel_index] = 3U - indices[texel_index];
+        }
+    }
+
+    std::memset(out_block, 0, texture_cook_block_size);
+    uint32_t bit_position = 0U;
+    texture_cook_write_block_bits(out_block, &bit_position, astc_block_mode, 11U);
+    // partition count - 1
+    texture_cook_write_block_bits(out_block, &bit_position, 0U, 2U);
+    texture_cook_write_block_bits(out_block, &bit_position, astc_color_endpoint_mode, 4U);
+    // (R0 R1 G0 G1 B0 B1 A0 A1)
+    for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+    {
+        texture_cook_write_block_bits(out_block, &bit_position, quantized_endpoint_0[channel_index], 8U);
+        texture_cook_write_block_bits(out_block, &bit_position, quantized_endpoint_1[channel_index], 8U);
+    }
+    assert(81U == bit_position);
+
+    // the weights are stored from the top of the block in the reverse bit order
+    for (uint32_t texel_index = 0U; texel_index < 16U; ++texel_index)
+    {
+        for (uint32_t bit_index = 0U; bit_index < 2U; ++bit_index)
+        {
+            if (0U != ((indices[texel_index] >> bit_index) & 1U))
+            {
+                uint32_t const block_bit_position = 127U - (2U * texel_index + bit_index);
+                out_block[block_bit_position / 8U] |= static_cast<uint8_t>(1U << (block_bit_position % 8U));
+            }
+        }
+    }
+}
+
+static inline void texture_cook_fit_endpoints(uint8_t const (*texels)[4], float *out_endpoint_0, float *out_endpoint_1)
+{
+    float mean[4] = {0.0F, 0.0F, 0.0F, 0.0F};
+    for (uint32_t texel_index = 0U; texel_index < 16U; ++texel_index)
+    {
+        for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+        {
+            mean[channel_index] += static_cast<float>(texels[texel_index][channel_index]);
+        }
+    }
+    for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+    {
+        mean[channel_index] *= (1.0F / 16.0F);
+    }
+
+    float covariance[4][4] = {};
+    for (uint32_t texel_index = 0U; texel_index < 16U; ++texel_index)
+    {
+        float const difference[4] = {static_cast<float>(texels[texel_index][0]) - mean[0], static_cast<float>(texels[texel_index][1]) - mean[1], static_cast<float>(texels[texel_index][2]) - mean[2], static_cast<float>(texels[texel_index][3]) - mean[3]};
+        for (uint32_t row_index = 0U; row_index < 4U; ++row_index)
+        {
+            for (uint32_t column_index = 0U; column_index < 4U; ++column_index)
+            {
+                covariance[row_index][column_index] += difference[row_index] * difference[column_index];
+            }
+        }
+    }
+
+    // the principal axis by the power iteration (started from the channel of the largest variance)
+    uint32_t largest_variance_channel_index = 0U;
+    for (uint32_t channel_index = 1U; channel_index < 4U; ++channel_index)
+    {
+        if (covariance[channel_index][channel_index] > covariance[largest_variance_channel_index][largest_variance_channel_index])
+        {
+            largest_variance_channel_index = channel_index;
+        }
+    }
+
+    if (covariance[largest_variance_channel_index][largest_variance_channel_index] <= 0.0F)
+    {
+        // uniform block
+        for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+        {
+            out_endpoint_0[channel_index] = mean[channel_index];
+            out_endpoint_1[channel_index] = mean[channel_index];
+        }
+        return;
+    }
+
+    float axis[4] = {covariance[largest_variance_channel_index][0], covariance[largest_variance_channel_index][1], covariance[largest_variance_channel_index][2], covariance[largest_variance_channel_index][3]};
+    for (uint32_t iteration_index = 0U; iteration_index < 8U; ++iteration_index)
+    {
+        float next_axis[4];
+        float max_component = 0.0F;
+        for (uint32_t row_index = 0U; row_index < 4U; ++row_index)
+        {
+            next_axis[row_index] = covariance[row_index][0] * axis[0] + covariance[row_index][1] * axis[1] + covariance[row_index][2] * axis[2] + covariance[row_index][3] * axis[3];
+            max_component = std::max(max_component, std::abs(next_axis[row_index]));
+        }
+
+        if (max_component <= 0.0F)
+        {
+            break;
+        }
+
+        for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+        {
+            axis[channel_index] = next_axis[channel_index] / max_component;
+        }
+    }
+
+    float const axis_length_square = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] + axis[3] * axis[3];
+    assert(axis_length_square > 0.0F);
+
+    float projection_min = 0.0F;
+    float projection_max = 0.0F;
+    for (uint32_t texel_index = 0U; texel_index < 16U; ++texel_index)
+    {
+        float const projection = ((static_cast<float>(texels[texel_index][0]) - mean[0]) * axis[0] + (static_cast<float>(texels[texel_index][1]) - mean[1]) * axis[1] + (static_cast<float>(texels[texel_index][2]) - mean[2]) * axis[2] + (static_cast<float>(texels[texel_index][3]) - mean[3]) * axis[3]) / axis_length_square;
+        projection_min = std::min(projection_min, projection);
+        projection_max = std::max(projection_max, projection);
+    }
+
+    for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+    {
+        out_endpoint_0[channel_index] = std::min(std::max(mean[channel_index] + projection_min * axis[channel_index], 0.0F), 255.0F);
+        out_endpoint_1[channel_index] = std::min(std::max(mean[channel_index] + projection_max * axis[channel_index], 0.0F), 255.0F);
+    }
+}
+
+static inline bool texture_cook_refine_endpoints(uint8_t const (*texels)[4], uint32_t const *indices, uint32_t const *weights, float *out_endpoint_0, float *out_endpoint_1)
+{
+    // minimize the sum of "|(1 - w) * e0 + w * e1 - x|^2"
+    float a_00 = 0.0F;
+    float a_01 = 0.0F;
+    float a_11 = 0.0F;
+    float b_0[4] = {0.0F, 0.0F, 0.0F, 0.0F};
+    float b_1[4] = {0.0F, 0.0F, 0.0F, 0.0F};
+    for (uint32_t texel_index = 0U; texel_index < 16U; ++texel_index)
+    {
+        float const w = static_cast<float>(weights[indices[texel_index]]) * (1.0F / 64.0F);
+        a_00 += (1.0F - w) * (1.0F - w);
+        a_01 += (1.0F - w) * w;
+        a_11 += w * w;
+        for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+        {
+            b_0[channel_index] += (1.0F - w) * static_cast<float>(texels[texel_index][channel_index]);
+            b_1[channel_index] += w * static_cast<float>(texels[texel_index][channel_index]);
+        }
+    }
+
+    float const determinant = a_00 * a_11 - a_01 * a_01;
+    if (std::abs(determinant) < 1E-6F)
+    {
+        return false;
+    }
+
+    for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+    {
+        out_endpoint_0[channel_index] = std::min(std::max((a_11 * b_0[channel_index] - a_01 * b_1[channel_index]) / determinant, 0.0F), 255.0F);
+        out_endpoint_1[channel_index] = std::min(std::max((a_00 * b_1[channel_index] - a_01 * b_0[channel_index]) / determinant, 0.0F), 255.0F);
+    }
+
+    return true;
+}
+
+static inline uint32_t texture_cook_select_indices(uint8_t const (*texels)[4], uint32_t const *endpoint_0, uint32_t const *endpoint_1, uint32_t const *weights, uint32_t weight_count, uint32_t *out_indices)
+{
+    assert(weight_count <= 16U);
+
+    int32_t palette[16][4];
+    for (uint32_t weight_index = 0U; weight_index < weight_count; ++weight_index)
+    {
+        for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+        {
+            palette[weight_index][channel_index] = static_cast<int32_t>(((64U - weights[weight_index]) * endpoint_0[channel_index] + weights[weight_index] * endpoint_1[channel_index] + 32U) >> 6U);
+        }
+    }
+
+    uint32_t total_error = 0U;
+    for (uint32_t texel_index = 0U; texel_index < 16U; ++texel_index)
+    {
+        uint32_t best_index = 0U;
+        uint32_t best_error = UINT32_MAX;
+        for (uint32_t weight_index = 0U; weight_index < weight_count; ++weight_index)
+        {
+            uint32_t error = 0U;
+            for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+            {
+                int32_t const difference = static_cast<int32_t>(texels[texel_index][channel_index]) - palette[weight_index][channel_index];
+                error += static_cast<uint32_t>(difference * difference);
+            }
+
+            if (error < best_error)
+            {
+                best_error = error;
+                best_index = weight_index;
+            }
+        }
+
+        out_indices[texel_index] = best_index;
+        total_error += best_error;
+    }
+
+    return total_error;
+}
+
+static inline void texture_cook_quantize_bc7_endpoint(float const *endpoint, uint32_t *out_quantized_endpoint, uint32_t *out_p_bit)
+{
+    // the unquantized value is "(quantized << 1) | p_bit"
+    (*out_p_bit) = 0U;
+    float best_error = -1.0F;
+    for (uint32_t p_bit = 0U; p_bit < 2U; ++p_bit)
+    {
+        uint32_t quantized_endpoint[4];
+        float error = 0.0F;
+        for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+        {
+            quantized_endpoint[channel_index] = static_cast<uint32_t>(std::min(std::max(std::lround((endpoint[channel_index] - static_cast<float>(p_bit)) * 0.5F), 0L), 127L));
+            float const difference = static_cast<float>((quantized_endpoint[channel_index] << 1U) | p_bit) - endpoint[channel_index];
+            error += difference * difference;
+        }
+
+        if ((best_error < 0.0F) || (error < best_error))
+        {
+            best_error = error;
+            std::memcpy(out_quantized_endpoint, quantized_endpoint, sizeof(quantized_endpoint));
+            (*out_p_bit) = p_bit;
+        }
+    }
+}
+
+static inline void texture_cook_write_block_bits(uint8_t *block, uint32_t *inout_bit_position, uint32_t value, uint32_t bit_count)
+{
+    for (uint32_t bit_index = 0U; bit_index < bit_count; ++bit_index)
+    {
+        uint32_t const bit_position = (*inout_bit_position) + bit_index;
+        assert(bit_position < 128U);
+        if (0U != ((value >> bit_index) & 1U))
+        {
+            block[bit_position / 8U] |= static_cast<uint8_t>(1U << (bit_position % 8U));
+        }
+    }
+
+    (*inout_bit_position) += bit_count;
+}
+
+static inline bool texture_cook_write_file(char const *path, mcrt_vector<uint8_t> const &data)
+{
+    // written to the temporary file at first to make sure that the partially written file is never read
+    mcrt_string const temporary_path = mcrt_string(path) + ".tmp";
+
+    FILE *const file = fopen(temporary_path.c_str(), "wb");
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    size_t const written_size = fwrite(data.data(), 1U, data.size(), file);
+
+    int const result_fclose = fclose(file);
+
+    if ((data.size() != written_size) || (0 != result_fclose))
+    {
+        remove(temporary_path.c_str());
+        return false;
+    }
+
+    // "rename" fails on Windows if the destination exists
+    remove(path);
+
+    if (0 != rename(temporary_path.c_str(), path))
+    {
+        remove(temporary_path.c_str());
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,69 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _TEXTURE_COOKER_H_
+#define _TEXTURE_COOKER_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include "worker_pool.h"
+#include "../../thirdparty/Import-Asset/include/import_image_asset.h"
+#include "../../thirdparty/Import-Asset/include/import_asset_input_stream.h"
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_string.h"
+
+enum TEXTURE_COOK_USAGE
+{
+	// BC5 (the Z is reconstructed by the shader)
+	TEXTURE_COOK_USAGE_NORMAL = 0,
+	// BC7 sRGB (the base color and the emissive)
+	TEXTURE_COOK_USAGE_COLOR = 1,
+	// BC7 (the metallic roughness)
+	TEXTURE_COOK_USAGE_LINEAR = 2
+};
+
+// D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION (which is also the "maxImageDimension2D" of the most Vulkan devices)
+// the device does NOT expose the limit, and the PNG larger than it can NOT be sampled anyway
+static constexpr uint32_t const TEXTURE_COOK_MAX_IMAGE_DIMENSION = 16384U;
+
+// normal, emissive, base color, metallic roughness (the same order as "scene_cache_mesh_subset::m_texture_image_uris")
+extern TEXTURE_COOK_USAGE texture_cook_get_usage(uint32_t mesh_subset_texture_index);
+
+// The source image is referenced by the glTF, and the DDS and the PVR next to the source image are the cooked images shipped with the assets.
+extern void texture_cook_get_image_asset_file_names(mcrt_string const &scene_asset_file_name, mcrt_string const &image_uri, mcrt_string *out_image_asset_file_name_source, mcrt_string *out_image_asset_file_name_dds, mcrt_string *out_image_asset_file_name_pvr);
+
+// The images cooked by the cooker are written into the cooked texture directory rather than next to the source image (which may be tracked by the asset repository).
+// The directories are flattened in the same way as the scene cache, and the file name is relative to the cooked texture directory.
+extern mcrt_string texture_cook_get_cooked_image_asset_file_name(mcrt_string const &image_asset_file_name);
+
+// Only the PNG is supported as the source image.
+extern bool texture_cook_is_source_image_supported(mcrt_string const &image_asset_file_name_source);
+
+// The source image is decoded into RGBA8 and the whole mip chain is generated, and then the mips are encoded on the worker threads into both BC7 (or BC5) and ASTC 4x4, which are written into the DDS and the PVR.
+// The worker pool is owned by the caller and shared by all images.
+// The source image is rejected when the width or the height is larger than "TEXTURE_COOK_MAX_IMAGE_DIMENSION".
+extern bool texture_cook_image(worker_pool *encode_worker_pool, void const *source_data, size_t source_size, TEXTURE_COOK_USAGE usage, char const *dds_path, char const *pvr_path);
+
+// The fallback when neither BC nor ASTC is supported by the device (or the cooked images are missing).
+// The source image is decoded and the mips are generated by the data function, which is called on the worker threads, and the image is uploaded as RGBA8.
+extern bool texture_transcode_png_color_image_asset_header_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *out_image_asset_header, size_t *out_image_asset_data_offset);
+
+extern bool texture_transcode_png_linear_image_asset_header_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *out_image_asset_header, size_t *out_image_asset_data_offset);
+
+// the header may describe the less detailed mips only (the most detailed mips are dropped by the memory budget), and the more detailed mips of the PNG are NOT written
+extern bool texture_transcode_png_image_asset_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests);
+
+#endif
@@ -0,0 +1,167 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "vertex_packing.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_XM_SSE_INTRINSICS_)
+#define VERTEX_PACKING_SSE2 1
+#elif defined(_XM_ARM_NEON_INTRINSICS_) && (defined(__aarch64__) || defined(_M_ARM64))
+// the "vcvtnq_s32_f32" and the "vdivq_f32" are NOT available on the ARMv7
+#define VERTEX_PACKING_NEON 1
+#endif
+
+extern void vertex_packing_narrow_indices(uint32_t index_count, uint32_t const *indices, uint16_t *out_uint16_indices)
+{
+    uint32_t index_index = 0U;
+
+#if defined(VERTEX_PACKING_SSE2)
+    // there is no unsigned saturation of the 32-bit integers in the SSE2, and the value is sign extended from the low 16 bits to make the signed saturation keep the low 16 bits
+    for (; (index_index + 8U) <= index_count; index_index += 8U)
+    {
+        __m128i const indices_low = _mm_loadu_si128(reinterpret_cast<__m128i const *>(indices + index_index));
+        __m128i const indices_high = _mm_loadu_si128(reinterpret_cast<__m128i const *>(indices + index_index + 4U));
+        __m128i const sign_extended_indices_low = _mm_srai_epi32(_mm_slli_epi32(indices_low, 16), 16);
+        __m128i const sign_extended_indices_high = _mm_srai_epi32(_mm_slli_epi32(indices_high, 16), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out_uint16_indices + index_index), _mm_packs_epi32(sign_extended_indices_low, sign_extended_indices_high));
+    }
+#elif defined(VERTEX_PACKING_NEON)
+    for (; (index_index + 8U) <= index_count; index_index += 8U)
+    {
+        uint32x4_t const indices_low = vld1q_u32(indices + index_index);
+        uint32x4_t const indices_high = vld1q_u32(indices + index_index + 4U);
+        vst1q_u16(out_uint16_indices + index_index, vcombine_u16(vmovn_u32(indices_low), vmovn_u32(indices_high)));
+    }
+#endif
+
+    vertex_packing_narrow_indices_reference(index_count - index_index, indices + index_index, out_uint16_indices + index_index);
+}
+
+extern void vertex_packing_quantize_positions(uint32_t vertex_count, scene_mesh_vertex_position_binding const *vertex_positions, uint32_t const *vertex_remap, DirectX::XMFLOAT3 const &center, DirectX::XMFLOAT3 const &extent, DirectX::XMFLOAT3 const &inverse_extent, mesh_subset_vertex_quantized_position_binding_T *out_quantized_vertex_positions, scene_mesh_vertex_position_binding *out_dequantized_vertex_positions)
+{
+#if defined(VERTEX_PACKING_SSE2)
+    // the W is zero, and thus the padding is quantized to zero
+    __m128 const center_vector = _mm_setr_ps(center.x, center.y, center.z, 0.0F);
+    __m128 const extent_vector = _mm_setr_ps(extent.x, extent.y, extent.z, 0.0F);
+    __m128 const inverse_extent_vector = _mm_setr_ps(inverse_extent.x, inverse_extent.y, inverse_extent.z, 0.0F);
+    __m128 const snorm16_max = _mm_set1_ps(32767.0F);
+    __m128 const snorm16_min = _mm_set1_ps(-32767.0F);
+
+    for (uint32_t vertex_index = 0U; vertex_index < vertex_count; ++vertex_index)
+    {
+        uint32_t const source_vertex_index = (NULL != vertex_remap) ? vertex_remap[vertex_index] : vertex_index;
+
+        DirectX::XMFLOAT3 const &position = vertex_positions[source_vertex_index].m_position;
+        __m128 const position_vector = _mm_setr_ps(position.x, position.y, position.z, 0.0F);
+
+        // clamped before the conversion, which is the same as clamped after the rounding since the bounds are integers
+        __m128 const scaled_position = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_mul_ps(_mm_sub_ps(position_vector, center_vector), inverse_extent_vector), snorm16_max), snorm16_min), snorm16_max);
+
+        // rounded to the nearest even by the default MXCSR
+        __m128i const quantized_position = _mm_cvtps_epi32(scaled_position);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out_quantized_vertex_positions + vertex_index), _mm_packs_epi32(quantized_position, quantized_position));
+
+        __m128 const dequantized_position = _mm_add_ps(center_vector, _mm_mul_ps(extent_vector, _mm_div_ps(_mm_cvtepi32_ps(quantized_position), snorm16_max)));
+        DirectX::XMFLOAT3 &out_position = out_dequantized_vertex_positions[vertex_index].m_position;
+        _mm_store_ss(&out_position.x, dequantized_position);
+        _mm_store_ss(&out_position.y, _mm_shuffle_ps(dequantized_position, dequantized_position, _MM_SHUFFLE(1, 1, 1, 1)));
+        _mm_store_ss(&out_position.z, _mm_shuffle_ps(dequantized_position, dequantized_position, _MM_SHUFFLE(2, 2, 2, 2)));
+    }
+#elif defined(VERTEX_PACKING_NEON)
+    float const center_values[4] = {center.x, center.y, center.z, 0.0F};
+    float const extent_values[4] = {extent.x, extent.y, extent.z, 0.0F};
+    float const inverse_extent_values[4] = {inverse_extent.x, inverse_extent.y, inverse_extent.z, 0.0F};
+    float32x4_t const center_vector = vld1q_f32(center_values);
+    float32x4_t const extent_vector = vld1q_f32(extent_values);
+    float32x4_t const inverse_extent_vector = vld1q_f32(inverse_extent_values);
+    float32x4_t const snorm16_max = vdupq_n_f32(32767.0F);
+    float32x4_t const snorm16_min = vdupq_n_f32(-32767.0F);
+
+    for (uint32_t vertex_index = 0U; vertex_index < vertex_count; ++vertex_index)
+    {
+        uint32_t const source_vertex_index = (NULL != vertex_remap) ? vertex_remap[vertex_index] : vertex_index;
+
+        DirectX::XMFLOAT3 const &position = vertex_positions[source_vertex_index].m_position;
+        float const position_values[4] = {position.x, position.y, position.z, 0.0F};
+        float32x4_t const position_vector = vld1q_f32(position_values);
+
+        // the multiplication and the addition are NOT fused to be the same as the scalar reference
+        float32x4_t const scaled_position = vminq_f32(vmaxq_f32(vmulq_f32(vmulq_f32(vsubq_f32(position_vector, center_vector), inverse_extent_vector), snorm16_max), snorm16_min), snorm16_max);
+
+        int32x4_t const quantized_position = vcvtnq_s32_f32(scaled_position);
+        vst1_s16(reinterpret_cast<int16_t *>(out_quantized_vertex_positions + vertex_index), vqmovn_s32(quantized_position));
+
+        float32x4_t const dequantized_position = vaddq_f32(center_vector, vmulq_f32(extent_vector, vdivq_f32(vcvtq_f32_s32(quantized_position), snorm16_max)));
+        DirectX::XMFLOAT3 &out_position = out_dequantized_vertex_positions[vertex_index].m_position;
+        out_position.x = vgetq_lane_f32(dequantized_position, 0);
+        out_position.y = vgetq_lane_f32(dequantized_position, 1);
+        out_position.z = vgetq_lane_f32(dequantized_position, 2);
+    }
+#else
+    vertex_packing_quantize_positions_reference(vertex_count, vertex_positions, vertex_remap, center, extent, inverse_extent, out_quantized_vertex_positions, out_dequantized_vertex_positions);
+#endif
+}
+
+extern void vertex_packing_narrow_indices_reference(uint32_t index_count, uint32_t const *indices, uint16_t *out_uint16_indices)
+{
+    for (uint32_t index_index = 0U; index_index < index_count; ++index_index)
+    {
+        out_uint16_indices[index_index] = static_cast<uint16_t>(indices[index_index]);
+    }
+}
+
+extern void vertex_packing_quantize_positions_reference(uint32_t vertex_count, scene_mesh_vertex_position_binding const *vertex_positions, uint32_t const *vertex_remap, DirectX::XMFLOAT3 const &center, DirectX::XMFLOAT3 const &extent, DirectX::XMFLOAT3 const &inverse_extent, mesh_subset_vertex_quantized_position_binding_T *out_quantized_vertex_positions, scene_mesh_vertex_position_binding *out_dequantized_vertex_positions)
+{
+    float const center_values[3] = {center.x, center.y, center.z};
+    float const extent_values[3] = {extent.x, extent.y, extent.z};
+    float const inverse_extent_values[3] = {inverse_extent.x, inverse_extent.y, inverse_extent.z};
+
+    for (uint32_t vertex_index = 0U; vertex_index < vertex_count; ++vertex_index)
+    {
+        uint32_t const source_vertex_index = (NULL != vertex_remap) ? vertex_remap[vertex_index] : vertex_index;
+
+        DirectX::XMFLOAT3 const &position = vertex_positions[source_vertex_index].m_position;
+        float const position_values[3] = {position.x, position.y, position.z};
+
+        int16_t quantized_positions[3];
+        float dequantized_positions[3];
+        for (uint32_t component_index = 0U; component_index < 3U; ++component_index)
+        {
+            // the volatile prevents the multiplications from being contracted (into the FMA) differently from the SIMD code
+            volatile float const normalized_position = (position_values[component_index] - center_values[component_index]) * inverse_extent_values[component_index];
+            volatile float const scaled_position = normalized_position * 32767.0F;
+
+            // rounded to the nearest even (the default rounding mode)
+            long const quantized_position = std::lrint(std::min(std::max(static_cast<float>(scaled_position), -32767.0F), 32767.0F));
+            quantized_positions[component_index] = static_cast<int16_t>(quantized_position);
+
+            volatile float const snorm_position = static_cast<float>(quantized_positions[component_index]) / 32767.0F;
+            volatile float const extent_position = extent_values[component_index] * static_cast<float>(snorm_position);
+            dequantized_positions[component_index] = center_values[component_index] + static_cast<float>(extent_position);
+        }
+
+        out_quantized_vertex_positions[vertex_index].m_position_x = quantized_positions[0];
+        out_quantized_vertex_positions[vertex_index].m_position_y = quantized_positions[1];
+        out_quantized_vertex_positions[vertex_index].m_position_z = quantized_positions[2];
+        out_quantized_vertex_positions[vertex_index]._unused_padding_1 = 0;
+
+        out_dequantized_vertex_positions[vertex_index].m_position.x = dequantized_positions[0];
+        out_dequantized_vertex_positions[vertex_index].m_position.y = dequantized_positions[1];
+        out_dequantized_vertex_positions[vertex_index].m_position.z = dequantized_positions[2];
+    }
+}
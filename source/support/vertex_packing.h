@@ -0,0 +1,51 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _VERTEX_PACKING_H_
+#define _VERTEX_PACKING_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+#include <DirectXMath.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#include "../../thirdparty/Import-Asset/include/import_scene_asset.h"
+#include "../../shaders/common_asset_constant.sli"
+
+// The batch kernels of the cooking, which use the SSE2 or the NEON (the same instruction sets as the DirectXMath) and fall back to the scalar code otherwise.
+// The result is exactly the same as the scalar reference, which is compared by the "Path-Tracing-Test" (source/test).
+
+// all indices should NOT be larger than UINT16_MAX (the larger indices keep the low 16 bits)
+extern void vertex_packing_narrow_indices(uint32_t index_count, uint32_t const *indices, uint16_t *out_uint16_indices);
+
+// the vertex "i" of the output is the vertex "vertex_remap[i]" of the input (the identity when "vertex_remap" is NULL)
+// the position is quantized to SNORM16 relative to the AABB (the inverse extent of the degenerated axis should be zero), and rounded to the nearest even
+// the dequantized positions are exactly the same as "R16G16_SNORM_to_FLOAT2" in the shader
+extern void vertex_packing_quantize_positions(uint32_t vertex_count, scene_mesh_vertex_position_binding const *vertex_positions, uint32_t const *vertex_remap, DirectX::XMFLOAT3 const &center, DirectX::XMFLOAT3 const &extent, DirectX::XMFLOAT3 const &inverse_extent, mesh_subset_vertex_quantized_position_binding_T *out_quantized_vertex_positions, scene_mesh_vertex_position_binding *out_dequantized_vertex_positions);
+
+// the scalar reference
+extern void vertex_packing_narrow_indices_reference(uint32_t index_count, uint32_t const *indices, uint16_t *out_uint16_indices);
+
+// the scalar reference
+extern void vertex_packing_quantize_positions_reference(uint32_t vertex_count, scene_mesh_vertex_position_binding const *vertex_positions, uint32_t const *vertex_remap, DirectX::XMFLOAT3 const &center, DirectX::XMFLOAT3 const &extent, DirectX::XMFLOAT3 const &inverse_extent, mesh_subset_vertex_quantized_position_binding_T *out_quantized_vertex_positions, scene_mesh_vertex_position_binding *out_dequantized_vertex_positions);
+
+#endif
@@ -0,0 +1,189 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "worker_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <assert.h>
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_vector.h"
+
+static void worker_pool_thread_main(std::atomic_uint32_t *next_task_index, uint32_t task_count, void (*pfn_task)(uint32_t task_index, void *user_data), void *user_data);
+
+extern void worker_pool_parallel_for(uint32_t task_count, void (*pfn_task)(uint32_t task_index, void *user_data), void *user_data)
+{
+    assert(NULL != pfn_task);
+
+    if (0U == task_count)
+    {
+        return;
+    }
+
+    // "hardware_concurrency" may return zero when it is not computable
+    uint32_t const hardware_concurrency = std::max(1U, static_cast<uint32_t>(std::thread::hardware_concurrency()));
+
+    // the calling thread is also used as a worker thread
+    uint32_t const worker_thread_count = std::min(hardware_concurrency, task_count) - 1U;
+
+    std::atomic_uint32_t next_task_index(0U);
+
+    mcrt_vector<std::thread> worker_threads;
+    worker_threads.reserve(worker_thread_count);
+    for (uint32_t worker_thread_index = 0U; worker_thread_index < worker_thread_count; ++worker_thread_index)
+    {
+        worker_threads.emplace_back(worker_pool_thread_main, &next_task_index, task_count, pfn_task, user_data);
+    }
+
+    worker_pool_thread_main(&next_task_index, task_count, pfn_task, user_data);
+
+    for (uint32_t worker_thread_index = 0U; worker_thread_index < worker_thread_count; ++worker_thread_index)
+    {
+        worker_threads[worker_thread_index].join();
+    }
+}
+
+static void worker_pool_thread_main(std::atomic_uint32_t *next_task_index, uint32_t task_count, void (*pfn_task)(uint32_t task_index, void *user_data), void *user_data)
+{
+    // the tasks are fetched one by one, since the cost of the tasks (e.g. the size of the assets) varies a lot
+    for (uint32_t task_index = next_task_index->fetch_add(1U, std::memory_order_relaxed); task_index < task_count; task_index = next_task_index->fetch_add(1U, std::memory_order_relaxed))
+    {
+        pfn_task(task_index, user_data);
+    }
+}
+
+worker_pool::worker_pool() : m_job_generation(0U), m_job_task_count(0U), m_job_pfn_task(NULL), m_job_user_data(NULL), m_job_busy_worker_thread_count(0U), m_stop(false), m_job_next_task_index(0U)
+{
+}
+
+void worker_pool::init(uint32_t worker_thread_count)
+{
+    assert(this->m_worker_threads.empty());
+
+    this->m_job_generation = 0U;
+    this->m_job_busy_worker_thread_count = 0U;
+    this->m_stop = false;
+
+    this->m_worker_threads.reserve(worker_thread_count);
+    for (uint32_t worker_thread_index = 0U; worker_thread_index < worker_thread_count; ++worker_thread_index)
+    {
+        this->m_worker_threads.emplace_back(worker_thread_main, this);
+    }
+}
+
+void worker_pool::destroy()
+{
+    {
+        std::unique_lock<std::mutex> lock(this->m_mutex);
+        assert(0U == this->m_job_busy_worker_thread_count);
+        this->m_stop = true;
+    }
+    this->m_job_condition_variable.notify_all();
+
+    for (size_t worker_thread_index = 0U; worker_thread_index < this->m_worker_threads.size(); ++worker_thread_index)
+    {
+        this->m_worker_threads[worker_thread_index].join();
+    }
+
+    mcrt_vector<std::thread>().swap(this->m_worker_threads);
+}
+
+void worker_pool::parallel_for(uint32_t task_count, void (*pfn_task)(uint32_t task_index, void *user_data), void *user_data)
+{
+    assert(NULL != pfn_task);
+
+    if (0U == task_count)
+    {
+        return;
+    }
+
+    // there is no need to wake the worker threads for a single task
+    if (this->m_worker_threads.empty() || (1U == task_count))
+    {
+        for (uint32_t task_index = 0U; task_index < task_count; ++task_index)
+        {
+            pfn_task(task_index, user_data);
+        }
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(this->m_mutex);
+        assert(0U == this->m_job_busy_worker_thread_count);
+        this->m_job_task_count = task_count;
+        this->m_job_pfn_task = pfn_task;
+        this->m_job_user_data = user_data;
+        this->m_job_busy_worker_thread_count = static_cast<uint32_t>(this->m_worker_threads.size());
+        this->m_job_next_task_index.store(0U, std::memory_order_relaxed);
+        ++this->m_job_generation;
+    }
+    this->m_job_condition_variable.notify_all();
+
+    worker_pool_thread_main(&this->m_job_next_task_index, task_count, pfn_task, user_data);
+
+    // all worker threads should have finished the current job before the next job is published
+    {
+        std::unique_lock<std::mutex> lock(this->m_mutex);
+        while (0U != this->m_job_busy_worker_thread_count)
+        {
+            this->m_finish_condition_variable.wait(lock);
+        }
+    }
+}
+
+void worker_pool::worker_thread_main(worker_pool *pool)
+{
+    uint32_t finished_job_generation = 0U;
+
+    while (true)
+    {
+        uint32_t task_count;
+        void (*pfn_task)(uint32_t task_index, void *user_data);
+        void *user_data;
+        {
+            std::unique_lock<std::mutex> lock(pool->m_mutex);
+            while ((!pool->m_stop) && (finished_job_generation == pool->m_job_generation))
+            {
+                pool->m_job_condition_variable.wait(lock);
+            }
+
+            if (pool->m_stop)
+            {
+                break;
+            }
+
+            finished_job_generation = pool->m_job_generation;
+            task_count = pool->m_job_task_count;
+            pfn_task = pool->m_job_pfn_task;
+            user_data = pool->m_job_user_data;
+        }
+
+        worker_pool_thread_main(&pool->m_job_next_task_index, task_count, pfn_task, user_data);
+
+        bool finished;
+        {
+            std::unique_lock<std::mutex> lock(pool->m_mutex);
+            assert(pool->m_job_busy_worker_thread_count > 0U);
+            --pool->m_job_busy_worker_thread_count;
+            finished = (0U == pool->m_job_busy_worker_thread_count);
+        }
+
+        if (finished)
+        {
+            pool->m_finish_condition_variable.notify_one();
+        }
+    }
+}
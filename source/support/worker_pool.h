@@ -0,0 +1,66 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _WORKER_POOL_H_
+#define _WORKER_POOL_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "../../thirdparty/Import-Asset/thirdparty/McRT-Malloc/include/mcrt_vector.h"
+
+// Runs "pfn_task(task_index, user_data)" for each task index in [0, task_count) on the worker threads (and the calling thread), and returns after all tasks have finished.
+// The tasks should NOT touch the device or the command buffers, which are only used on the calling thread.
+extern void worker_pool_parallel_for(uint32_t task_count, void (*pfn_task)(uint32_t task_index, void *user_data), void *user_data);
+
+// The worker threads are kept alive between the "parallel_for" calls, which avoids creating the threads every frame.
+// The "parallel_for" should only be called from one thread at a time.
+class worker_pool
+{
+	mcrt_vector<std::thread> m_worker_threads;
+
+	std::mutex m_mutex;
+	std::condition_variable m_job_condition_variable;
+	std::condition_variable m_finish_condition_variable;
+	// the job is published by increasing the generation (with the mutex locked)
+	uint32_t m_job_generation;
+	uint32_t m_job_task_count;
+	void (*m_job_pfn_task)(uint32_t task_index, void *user_data);
+	void *m_job_user_data;
+	// the number of the worker threads which have NOT finished the current job
+	uint32_t m_job_busy_worker_thread_count;
+	bool m_stop;
+
+	std::atomic_uint32_t m_job_next_task_index;
+
+	static void worker_thread_main(worker_pool *pool);
+
+public:
+	worker_pool();
+
+	void init(uint32_t worker_thread_count);
+
+	void destroy();
+
+	// the calling thread is also used as a worker thread
+	void parallel_for(uint32_t task_count, void (*pfn_task)(uint32_t task_index, void *user_data), void *user_data);
+};
+
+#endif
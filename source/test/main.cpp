@@ -0,0 +1,148 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "../support/vertex_packing.h"
+
+static bool test_narrow_indices();
+
+static bool test_quantize_positions(DirectX::XMFLOAT3 const &center, DirectX::XMFLOAT3 const &extent);
+
+// Usage: Path-Tracing-Test
+// The batch kernels of the cooking are compared with the scalar reference, and the edge values are fed through both of them.
+// The exit code is NOT zero when any result is different.
+int main(int argc, char **argv)
+{
+    bool passed = test_narrow_indices();
+
+    // the extent of each axis is positive, zero (the degenerated axis), or tiny
+    passed = test_quantize_positions(DirectX::XMFLOAT3(0.0F, 0.0F, 0.0F), DirectX::XMFLOAT3(1.0F, 1.0F, 1.0F)) && passed;
+    passed = test_quantize_positions(DirectX::XMFLOAT3(1.5F, -2.0F, 100.0F), DirectX::XMFLOAT3(4.0F, 0.0F, 0.001F)) && passed;
+    passed = test_quantize_positions(DirectX::XMFLOAT3(-1000.0F, 12345.0F, 0.25F), DirectX::XMFLOAT3(0.0F, 0.0F, 0.0F)) && passed;
+    passed = test_quantize_positions(DirectX::XMFLOAT3(3.0F, 0.0F, -7.0F), DirectX::XMFLOAT3(1000000.0F, 0.5F, 1.0e-6F)) && passed;
+
+    printf("Vertex Packing Test: %s\n", passed ? "passed" : "FAILED");
+
+    return passed ? 0 : 1;
+}
+
+static bool test_narrow_indices()
+{
+    // the indices larger than UINT16_MAX are NOT valid, but the batch kernel still keeps the low 16 bits, the same as the scalar reference
+    static constexpr uint32_t const edge_indices[] = {0U, 1U, 32767U, 32768U, 65534U, 65535U, 65536U, 65537U, 131071U, 0X7FFFFFFFU, 0X80000000U, 0XFFFF0000U, 0XFFFFFFFEU, 0XFFFFFFFFU};
+    static constexpr uint32_t const edge_index_count = sizeof(edge_indices) / sizeof(edge_indices[0]);
+
+    // each count covers a different split between the batch loop (8 indices) and the scalar tail
+    static constexpr uint32_t const max_index_count = 35U;
+
+    bool passed = true;
+
+    for (uint32_t index_count = 0U; index_count <= max_index_count; ++index_count)
+    {
+        uint32_t indices[max_index_count];
+        for (uint32_t index_index = 0U; index_index < index_count; ++index_index)
+        {
+            indices[index_index] = edge_indices[(index_index + index_count) % edge_index_count];
+        }
+
+        uint16_t uint16_indices[max_index_count];
+        vertex_packing_narrow_indices(index_count, indices, uint16_indices);
+
+        uint16_t reference_uint16_indices[max_index_count];
+        vertex_packing_narrow_indices_reference(index_count, indices, reference_uint16_indices);
+
+        for (uint32_t index_index = 0U; index_index < index_count; ++index_index)
+        {
+            if ((reference_uint16_indices[index_index] != uint16_indices[index_index]) || (static_cast<uint16_t>(indices[index_index] & 0XFFFFU) != uint16_indices[index_index]))
+            {
+                printf("Narrow Indices: the index %u (count %u) is %u but the scalar reference is %u\n", static_cast<unsigned>(indices[index_index]), static_cast<unsigned>(index_count), static_cast<unsigned>(uint16_indices[index_index]), static_cast<unsigned>(reference_uint16_indices[index_index]));
+                passed = false;
+            }
+        }
+    }
+
+    return passed;
+}
+
+static bool test_quantize_positions(DirectX::XMFLOAT3 const &center, DirectX::XMFLOAT3 const &extent)
+{
+    // the same as the "quantize_vertex_positions" of the scene cooker
+    DirectX::XMFLOAT3 const inverse_extent((extent.x > 0.0F) ? (1.0F / extent.x) : 0.0F, (extent.y > 0.0F) ? (1.0F / extent.y) : 0.0F, (extent.z > 0.0F) ? (1.0F / extent.z) : 0.0F);
+
+    // the positions on the AABB (-extent, +extent), the center, the midpoints, and the positions slightly outside the AABB (which should be clamped)
+    static constexpr float const edge_scales[] = {-1.0F, 1.0F, 0.0F, -0.5F, 0.5F, 0.25F, -1.0e-5F, 1.0e-5F, 0.999999F, -0.999999F, 1.000001F, -1.000001F, 2.0F, -2.0F};
+    static constexpr uint32_t const edge_scale_count = sizeof(edge_scales) / sizeof(edge_scales[0]);
+
+    static constexpr uint32_t const vertex_count = edge_scale_count * edge_scale_count;
+
+    scene_mesh_vertex_position_binding vertex_positions[vertex_count];
+    for (uint32_t vertex_index = 0U; vertex_index < vertex_count; ++vertex_index)
+    {
+        float const scale_x = edge_scales[vertex_index % edge_scale_count];
+        float const scale_y = edge_scales[vertex_index / edge_scale_count];
+        float const scale_z = edge_scales[(vertex_index + vertex_index / edge_scale_count) % edge_scale_count];
+        vertex_positions[vertex_index].m_position = DirectX::XMFLOAT3(center.x + extent.x * scale_x, center.y + extent.y * scale_y, center.z + extent.z * scale_z);
+    }
+
+    // the reversed order is used as the vertex remap
+    uint32_t vertex_remap[vertex_count];
+    for (uint32_t vertex_index = 0U; vertex_index < vertex_count; ++vertex_index)
+    {
+        vertex_remap[vertex_index] = vertex_count - 1U - vertex_index;
+    }
+
+    bool passed = true;
+
+    for (uint32_t remap_index = 0U; remap_index < 2U; ++remap_index)
+    {
+        uint32_t const *const remap = (0U == remap_index) ? NULL : vertex_remap;
+
+        mesh_subset_vertex_quantized_position_binding_T quantized_vertex_positions[vertex_count];
+        scene_mesh_vertex_position_binding dequantized_vertex_positions[vertex_count];
+        vertex_packing_quantize_positions(vertex_count, vertex_positions, remap, center, extent, inverse_extent, quantized_vertex_positions, dequantized_vertex_positions);
+
+        mesh_subset_vertex_quantized_position_binding_T reference_quantized_vertex_positions[vertex_count];
+        scene_mesh_vertex_position_binding reference_dequantized_vertex_positions[vertex_count];
+        vertex_packing_quantize_positions_reference(vertex_count, vertex_positions, remap, center, extent, inverse_extent, reference_quantized_vertex_positions, reference_dequantized_vertex_positions);
+
+        for (uint32_t vertex_index = 0U; vertex_index < vertex_count; ++vertex_index)
+        {
+            mesh_subset_vertex_quantized_position_binding_T const &quantized = quantized_vertex_positions[vertex_index];
+            mesh_subset_vertex_quantized_position_binding_T const &reference_quantized = reference_quantized_vertex_positions[vertex_index];
+            DirectX::XMFLOAT3 const &dequantized = dequantized_vertex_positions[vertex_index].m_position;
+            DirectX::XMFLOAT3 const &reference_dequantized = reference_dequantized_vertex_positions[vertex_index].m_position;
+
+            bool const quantized_equal = (reference_quantized.m_position_x == quantized.m_position_x) && (reference_quantized.m_position_y == quantized.m_position_y) && (reference_quantized.m_position_z == quantized.m_position_z) && (0 == quantized._unused_padding_1) && (0 == reference_quantized._unused_padding_1);
+            bool const dequantized_equal = (reference_dequantized.x == dequantized.x) && (reference_dequantized.y == dequantized.y) && (reference_dequantized.z == dequantized.z);
+
+            // the degenerated axis is always quantized to zero, and dequantized to the center
+            bool const degenerated_axis_valid = ((extent.x > 0.0F) || ((0 == quantized.m_position_x) && (center.x == dequantized.x))) && ((extent.y > 0.0F) || ((0 == quantized.m_position_y) && (center.y == dequantized.y))) && ((extent.z > 0.0F) || ((0 == quantized.m_position_z) && (center.z == dequantized.z)));
+
+            if ((!quantized_equal) || (!dequantized_equal) || (!degenerated_axis_valid))
+            {
+                uint32_t const source_vertex_index = (NULL != remap) ? remap[vertex_index] : vertex_index;
+                DirectX::XMFLOAT3 const &position = vertex_positions[source_vertex_index].m_position;
+                printf("Quantize Positions: the position (%.9g, %.9g, %.9g) of the center (%.9g, %.9g, %.9g) and the extent (%.9g, %.9g, %.9g) is quantized to (%d, %d, %d) and dequantized to (%.9g, %.9g, %.9g), but the scalar reference is (%d, %d, %d) and (%.9g, %.9g, %.9g)\n", position.x, position.y, position.z, center.x, center.y, center.z, extent.x, extent.y, extent.z, static_cast<int>(quantized.m_position_x), static_cast<int>(quantized.m_position_y), static_cast<int>(quantized.m_position_z), dequantized.x, dequantized.y, dequantized.z, static_cast<int>(reference_quantized.m_position_x), static_cast<int>(reference_quantized.m_position_y), static_cast<int>(reference_quantized.m_position_z), reference_dequantized.x, reference_dequantized.y, reference_dequantized.z);
+                passed = false;
+            }
+        }
+    }
+
+    return passed;
+}